@@ -0,0 +1,43 @@
+#pragma once
+#include "Actuators/OutputSpec.h"
+#include "Actuators/Profiles/PlaneProfile.h"
+#include "Actuators/Profiles/CarProfile.h"
+
+// ============================================================================
+// ВЫБОР АППАРАТА
+// ============================================================================
+//
+// Профиль - структура с constexpr-таблицами: каналы, пины, диапазоны, правила
+// микшера, тип ESC, кривая газа. ServoManager наследует выбранный профиль:
+// массивы выходов и циклы имеют размер OUTPUT_COUNT профиля, отсутствующих
+// поверхностей в прошивке нет вовсе. Пины проверяются static_assert ниже
+// для всех профилей, а не только для выбранного.
+
+#define AIRFRAME_PLANE  0
+#define AIRFRAME_CAR    1
+#define AIRFRAME_PROFILE AIRFRAME_PLANE
+
+// Свойства профиля, которые нужны препроцессору (#if в ServoManager, Stabilizer)
+#if AIRFRAME_PROFILE == AIRFRAME_CAR
+typedef CarProfile AirframeProfile;
+#define AIRFRAME_ESC_REVERSIBLE  true     // Нейтраль - стоп, без церемонии BLHeli
+#define AIRFRAME_STABILIZED      false    // Наземный аппарат: стабилизатор не компилируется
+#else
+typedef PlaneProfile AirframeProfile;
+#define AIRFRAME_ESC_REVERSIBLE  false
+#define AIRFRAME_STABILIZED      true
+#endif
+
+static_assert(AIRFRAME_ESC_REVERSIBLE ==
+              (AirframeProfile::OUTPUTS[AirframeProfile::CH_MOTOR].kind == OUTPUT_ESC_REVERSIBLE),
+              "AIRFRAME_ESC_REVERSIBLE must match the profile ESC output");
+
+#define AIRFRAME_CHECK(Profile) \
+    static_assert(Profile::OUTPUT_COUNT <= MIXER_MAX_OUTPUTS, #Profile ": too many outputs for the mixer"); \
+    static_assert(outputPinsCapable(Profile::OUTPUTS), #Profile ": pin cannot drive an output (GPIO 6-11, 34-39)"); \
+    static_assert(outputPinsUnique(Profile::OUTPUTS), #Profile ": pin used twice or taken by LED/IMU"); \
+    static_assert(outputOrderValid(Profile::OUTPUTS), #Profile ": servos first, one ESC last (CH_MOTOR)"); \
+    static_assert(outputRangesValid(Profile::OUTPUTS), #Profile ": output range outside 500-2500 us or min > neutral > max")
+
+AIRFRAME_CHECK(PlaneProfile);
+AIRFRAME_CHECK(CarProfile);
@@ -0,0 +1,80 @@
+#include "MotionEngine.h"
+#include <cmath>
+
+void MotionEngine::configure(uint8_t channel, int startPulse, float maxVelocity, float maxAcceleration) {
+    if (channel >= MOTION_MAX_CHANNELS) {
+        return;
+    }
+    positions[channel] = startPulse;
+    velocities[channel] = 0.0f;
+    targets[channel] = startPulse;
+    maxVelocities[channel] = maxVelocity;
+    maxAccelerations[channel] = maxAcceleration;
+    outputs[channel] = startPulse;
+    if (channel >= channelCount) {
+        channelCount = channel + 1;
+    }
+}
+
+void MotionEngine::setTarget(uint8_t channel, int pulseUs) {
+    targets[channel] = pulseUs;
+}
+
+void MotionEngine::setPosition(uint8_t channel, int pulseUs) {
+    positions[channel] = pulseUs;
+    targets[channel] = pulseUs;
+    velocities[channel] = 0.0f;
+    outputs[channel] = pulseUs;
+}
+
+void MotionEngine::step(uint32_t dtUs) {
+    const float dt = dtUs * 1e-6f;
+
+    for (uint8_t i = 0; i < channelCount; i++) {
+        float error = targets[i] - positions[i];
+        float velocity = velocities[i];
+        const float accelStep = maxAccelerations[i] * dt;
+
+        // Направление на цель и расстояние до нее
+        float direction = error >= 0.0f ? 1.0f : -1.0f;
+        float distance = error * direction;
+        float speedToward = velocity * direction;
+
+        // Тормозим, если тормозной путь v²/2a уже не меньше оставшегося расстояния
+        if (speedToward > 0.0f && speedToward * speedToward >= 2.0f * maxAccelerations[i] * distance) {
+            speedToward -= accelStep;
+        } else {
+            speedToward += accelStep;
+        }
+
+        if (speedToward > maxVelocities[i]) {
+            speedToward = maxVelocities[i];
+        }
+
+        float move = speedToward * dt;
+
+        // Достигли цели (или проскочили бы ее) - фиксируемся
+        if (distance <= 0.5f || move >= distance) {
+            positions[i] = targets[i];
+            velocities[i] = 0.0f;
+        } else {
+            positions[i] += move * direction;
+            velocities[i] = speedToward * direction;
+        }
+
+        outputs[i] = (int)lroundf(positions[i]);
+    }
+}
+
+bool MotionEngine::isSettled(uint8_t channel) const {
+    return positions[channel] == targets[channel] && velocities[channel] == 0.0f;
+}
+
+bool MotionEngine::isSettled() const {
+    for (uint8_t i = 0; i < channelCount; i++) {
+        if (!isSettled(i)) {
+            return false;
+        }
+    }
+    return true;
+}
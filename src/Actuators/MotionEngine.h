@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+
+// Максимальное количество каналов движка плавного движения
+#define MOTION_MAX_CHANNELS 10
+
+// Неблокирующий движок плавного движения сервоприводов.
+// Позиция - импульс в микросекундах (как у PwmBank), скорость - мкс/с.
+// Для каждого канала хранит цель, текущую позицию, скорость и ограничения
+// скорости/ускорения. Все каналы продвигаются одновременно за один вызов step()
+// из тика управления - никаких delay().
+//
+// Данные хранятся как structure-of-arrays, чтобы цикл по каналам был плотным.
+class MotionEngine {
+public:
+    // Настройка канала: начальный импульс (мкс), ограничение скорости (мкс/с) и ускорения (мкс/с²)
+    void configure(uint8_t channel, int startPulse, float maxVelocity, float maxAcceleration);
+
+    void setTarget(uint8_t channel, int pulseUs);
+
+    // Мгновенная установка импульса (без плавности), скорость сбрасывается
+    void setPosition(uint8_t channel, int pulseUs);
+
+    // Продвинуть все каналы на dtUs микросекунд
+    void step(uint32_t dtUs);
+
+    int getOutput(uint8_t channel) const { return outputs[channel]; }
+    int getTarget(uint8_t channel) const { return (int)targets[channel]; }
+    bool isSettled(uint8_t channel) const;
+    bool isSettled() const;
+    uint8_t getChannelCount() const { return channelCount; }
+
+private:
+    float positions[MOTION_MAX_CHANNELS] = {};
+    float velocities[MOTION_MAX_CHANNELS] = {};
+    float targets[MOTION_MAX_CHANNELS] = {};
+    float maxVelocities[MOTION_MAX_CHANNELS] = {};
+    float maxAccelerations[MOTION_MAX_CHANNELS] = {};
+    int outputs[MOTION_MAX_CHANNELS] = {};
+    uint8_t channelCount = 0;
+};
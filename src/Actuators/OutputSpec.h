@@ -0,0 +1,123 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include "Core/Types.h"
+
+// ============================================================================
+// ОПИСАНИЕ ВЫХОДОВ АППАРАТА (профили - Actuators/AirframeProfile.h)
+// ============================================================================
+//
+// Выход - одна строка constexpr-таблицы: пин, тип, диапазон в микросекундах,
+// реверс и класс скорости. Проверки таблицы (пины, порядок каналов) - тоже
+// constexpr: ошибка профиля останавливает компиляцию через static_assert.
+
+// Диапазон импульсов сервопривода (угол 0-180°)
+#define SERVO_MIN_PULSE  500
+#define SERVO_MAX_PULSE  2400
+
+// Угол сервопривода -> импульс
+constexpr int16_t servoAngleToPulse(int angle) {
+    return (int16_t)(SERVO_MIN_PULSE + (SERVO_MAX_PULSE - SERVO_MIN_PULSE) * angle / 180);
+}
+
+enum OutputKind : uint8_t {
+    OUTPUT_SERVO = 0,       // Сервопривод: нейтраль - середина хода
+    OUTPUT_ESC,             // Нереверсивный ESC (самолет): min - стоп, neutral - холостой ход
+    OUTPUT_ESC_REVERSIBLE   // ESC газ/тормоз (машина): neutral - стоп, ниже - тормоз и реверс
+};
+
+// Класс скорости для плавного движения (SERVO_SPEED_* в ServoManager.h)
+enum MotionClass : uint8_t {
+    MOTION_NONE = 0,        // ESC: плавное движение не применяется
+    MOTION_FAST,
+    MOTION_MEDIUM,
+    MOTION_SLOW
+};
+
+struct OutputSpec {
+    const char* name;
+    uint8_t pin;
+    uint8_t kind;           // OutputKind
+    uint8_t motion;         // MotionClass
+    int16_t minUs;          // Диапазон выхода микшера (значения по умолчанию в FlightConfig)
+    int16_t neutralUs;
+    int16_t maxUs;
+    bool reversed;
+};
+
+// Импульс, с которым выход включается и который означает "стоп"
+constexpr int16_t outputRestPulse(const OutputSpec& output) {
+    return output.kind == OUTPUT_ESC ? output.minUs : output.neutralUs;
+}
+
+// Диапазон, в котором PWM-канал принимает углы 0-180° (ServoGroup::write)
+constexpr int16_t outputPwmMin(const OutputSpec& output) {
+    return output.kind == OUTPUT_SERVO ? (int16_t)SERVO_MIN_PULSE : output.minUs;
+}
+
+constexpr int16_t outputPwmMax(const OutputSpec& output) {
+    return output.kind == OUTPUT_SERVO ? (int16_t)SERVO_MAX_PULSE : output.maxUs;
+}
+
+// ============================================================================
+// ПРОВЕРКИ ПРОФИЛЯ ПРИ КОМПИЛЯЦИИ
+// ============================================================================
+
+// ESP32: GPIO 6-11 заняты flash, 34-39 только на вход
+constexpr bool isOutputCapablePin(uint8_t pin) {
+    return pin <= 33 && (pin < 6 || pin > 11);
+}
+
+// Пины платы, которые выходам не достаются
+constexpr bool isBoardPin(uint8_t pin) {
+    return pin == HardwareConfig::LED_PIN || pin == HardwareConfig::IMU_SDA_PIN ||
+           pin == HardwareConfig::IMU_SCL_PIN;
+}
+
+template <size_t N>
+constexpr bool outputPinsCapable(const OutputSpec (&outputs)[N]) {
+    for (size_t i = 0; i < N; i++) {
+        if (!isOutputCapablePin(outputs[i].pin)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <size_t N>
+constexpr bool outputPinsUnique(const OutputSpec (&outputs)[N]) {
+    for (size_t i = 0; i < N; i++) {
+        if (isBoardPin(outputs[i].pin)) {
+            return false;
+        }
+        for (size_t j = i + 1; j < N; j++) {
+            if (outputs[i].pin == outputs[j].pin) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Сначала сервоприводы (каналы плавного движения), последним - один ESC
+template <size_t N>
+constexpr bool outputOrderValid(const OutputSpec (&outputs)[N]) {
+    for (size_t i = 0; i + 1 < N; i++) {
+        if (outputs[i].kind != OUTPUT_SERVO) {
+            return false;
+        }
+    }
+    return N > 0 && outputs[N - 1].kind != OUTPUT_SERVO && outputs[N - 1].motion == MOTION_NONE;
+}
+
+template <size_t N>
+constexpr bool outputRangesValid(const OutputSpec (&outputs)[N]) {
+    for (size_t i = 0; i < N; i++) {
+        const OutputSpec& output = outputs[i];
+        if (output.minUs > output.neutralUs || output.neutralUs > output.maxUs ||
+            output.minUs < 500 || output.maxUs > 2500) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "Actuators/OutputSpec.h"
+#include "Actuators/Sequence.h"
+#include "Control/Mixer.h"
+#include "Control/Failsafe.h"
+
+// ============================================================================
+// ПРОФИЛЬ: МАШИНА С ПОВОРОТНЫМИ КОЛЕСАМИ (Аккерман, ESC газ/тормоз)
+// ============================================================================
+
+// Рулевая трапеция: ограничение хода сервопривода, чтобы не упираться в тяги
+#define CAR_STEERING_MIN_ANGLE   50
+#define CAR_STEERING_MAX_ANGLE   130
+
+// Газ: экспонента мягче у нуля - колеса не срываются в пробуксовку
+#define CAR_THROTTLE_EXPO        40
+
+// Время нарастания газа 0 -> 100% и тормоза/реверса 0 -> 100%.
+// Сброс газа и тормоза - мгновенно
+#define CAR_THROTTLE_RAMP_MS     400
+#define CAR_BRAKE_RAMP_MS        250
+
+struct CarProfile {
+    static constexpr const char* NAME = "CAR";
+
+    enum SurfaceChannel {
+        CH_STEERING = 0,
+        SURFACE_COUNT,
+        CH_MOTOR = SURFACE_COUNT,   // ESC газ/тормоз - последний выход микшера
+        OUTPUT_COUNT
+    };
+
+    static constexpr OutputSpec OUTPUTS[OUTPUT_COUNT] = {
+        {"STEERING", 13, OUTPUT_SERVO, MOTION_FAST, servoAngleToPulse(CAR_STEERING_MIN_ANGLE),
+         servoAngleToPulse(90), servoAngleToPulse(CAR_STEERING_MAX_ANGLE), false},
+        // Нейтраль - стоп, выше - вперед, ниже - тормоз, затем реверс
+        {"ESC", 17, OUTPUT_ESC_REVERSIBLE, MOTION_NONE, 1000, 1500, 2000, false},
+    };
+
+    // Руль - ось рыскания (первый джойстик), газ и тормоз - ось газа
+    static constexpr MixRule MIX_RULES[] = {
+        {CH_STEERING, MIX_IN_YAW, 100},
+        {CH_MOTOR, MIX_IN_THROTTLE, 100},
+    };
+
+    // Позы тестовых последовательностей: -1 минимум, 0 нейтраль, 1 максимум
+    static constexpr int8_t POSES[POSE_COUNT][SURFACE_COUNT] = {
+        {0},    // POSE_NEUTRAL
+        {-1},   // POSE_MIN
+        {1},    // POSE_MAX
+        {0},    // POSE_AILERONS_SPLIT
+        {1},    // POSE_RUDDER_FLAPS: руль как руль направления
+    };
+
+    // Газ: двухполярная ось (вниз - тормоз и реверс), ограничение скорости нарастания
+    static constexpr uint8_t THROTTLE_EXPO = CAR_THROTTLE_EXPO;
+    static constexpr uint16_t THROTTLE_RAMP_UP_MS = CAR_THROTTLE_RAMP_MS;
+    static constexpr uint16_t THROTTLE_RAMP_BRAKE_MS = CAR_BRAKE_RAMP_MS;
+
+    // Потеря связи: сразу колеса прямо, газ в нейтраль - без удержания
+    static constexpr FailsafeMode FAILSAFE_MODE = FAILSAFE_MODE_STOP;
+};
@@ -0,0 +1,120 @@
+#pragma once
+#include "Actuators/OutputSpec.h"
+#include "Actuators/Sequence.h"
+#include "Control/Mixer.h"
+#include "Control/Failsafe.h"
+
+// ============================================================================
+// ПРОФИЛЬ: САМОЛЕТ (раздельные поверхности, BLHeli ESC)
+// ============================================================================
+
+// Схема микширования поверхностей (таблицы правил ниже)
+#define MIXER_PRESET_CONVENTIONAL  0    // Раздельные элероны, РВ, РН, закрылки
+#define MIXER_PRESET_FLAPERONS     1    // Закрылки дополнительно работают как элероны
+#define MIXER_PRESET_VTAIL         2    // Рули высоты работают как V-хвост (РВ + РН)
+#define MIXER_PRESET_ELEVONS       3    // Элероны работают как элевоны (крен + тангаж)
+#define MIXER_PRESET MIXER_PRESET_CONVENTIONAL
+
+struct PlaneProfile {
+    static constexpr const char* NAME = "PLANE";
+
+    // Выходы микшера (поверхности - они же каналы движка плавного движения)
+    enum SurfaceChannel {
+        CH_L_ELEVATOR = 0,
+        CH_R_ELEVATOR,
+        CH_L_RUDDER,
+        CH_R_RUDDER,
+        CH_L_AILERON,
+        CH_R_AILERON,
+        CH_L_FLAPS,
+        CH_R_FLAPS,
+        SURFACE_COUNT,
+        CH_MOTOR = SURFACE_COUNT,   // Мотор - последний выход микшера
+        OUTPUT_COUNT
+    };
+
+    // Правый РВ и левый элерон реверсированы
+    static constexpr OutputSpec OUTPUTS[OUTPUT_COUNT] = {
+        {"L_ELEVATOR", 13, OUTPUT_SERVO, MOTION_MEDIUM, servoAngleToPulse(0), servoAngleToPulse(90), servoAngleToPulse(180), false},
+        {"R_ELEVATOR", 32, OUTPUT_SERVO, MOTION_MEDIUM, servoAngleToPulse(0), servoAngleToPulse(90), servoAngleToPulse(180), true},
+        {"L_RUDDER", 14, OUTPUT_SERVO, MOTION_MEDIUM, servoAngleToPulse(0), servoAngleToPulse(90), servoAngleToPulse(180), false},
+        {"R_RUDDER", 16, OUTPUT_SERVO, MOTION_MEDIUM, servoAngleToPulse(0), servoAngleToPulse(90), servoAngleToPulse(180), false},
+        {"L_LEFT_AILERON", 27, OUTPUT_SERVO, MOTION_FAST, servoAngleToPulse(0), servoAngleToPulse(90), servoAngleToPulse(180), true},
+        {"R_RIGHT_AILERON", 26, OUTPUT_SERVO, MOTION_FAST, servoAngleToPulse(0), servoAngleToPulse(90), servoAngleToPulse(180), false},
+        {"L_FLAPS", 33, OUTPUT_SERVO, MOTION_SLOW, servoAngleToPulse(0), servoAngleToPulse(90), servoAngleToPulse(180), false},
+        {"R_FLAPS", 25, OUTPUT_SERVO, MOTION_SLOW, servoAngleToPulse(0), servoAngleToPulse(90), servoAngleToPulse(180), false},
+        // Ниже мертвой зоны газа - стоп, выше - от холостого хода
+        {"MOTOR", 17, OUTPUT_ESC, MOTION_NONE, 1000, 1100, 2000, false},
+    };
+
+    #if MIXER_PRESET == MIXER_PRESET_FLAPERONS
+    // Флапероны: закрылки дополнительно отклоняются как элероны
+    static constexpr MixRule MIX_RULES[] = {
+        {CH_L_ELEVATOR, MIX_IN_PITCH, 100},
+        {CH_R_ELEVATOR, MIX_IN_PITCH, 100},
+        {CH_L_RUDDER, MIX_IN_YAW, 100},
+        {CH_R_RUDDER, MIX_IN_YAW, 100},
+        {CH_L_AILERON, MIX_IN_ROLL, 100},
+        {CH_R_AILERON, MIX_IN_ROLL, 100},
+        {CH_L_FLAPS, MIX_IN_FLAPS, 70},
+        {CH_L_FLAPS, MIX_IN_ROLL, -50},
+        {CH_R_FLAPS, MIX_IN_FLAPS, 70},
+        {CH_R_FLAPS, MIX_IN_ROLL, 50},
+        {CH_MOTOR, MIX_IN_THROTTLE, 100},
+    };
+    #elif MIXER_PRESET == MIXER_PRESET_VTAIL
+    // V-хвост: рули высоты отрабатывают и тангаж, и рыскание
+    static constexpr MixRule MIX_RULES[] = {
+        {CH_L_ELEVATOR, MIX_IN_PITCH, 70},
+        {CH_L_ELEVATOR, MIX_IN_YAW, 50},
+        {CH_R_ELEVATOR, MIX_IN_PITCH, 70},
+        {CH_R_ELEVATOR, MIX_IN_YAW, -50},
+        {CH_L_AILERON, MIX_IN_ROLL, 100},
+        {CH_R_AILERON, MIX_IN_ROLL, 100},
+        {CH_L_FLAPS, MIX_IN_FLAPS, 100},
+        {CH_R_FLAPS, MIX_IN_FLAPS, 100},
+        {CH_MOTOR, MIX_IN_THROTTLE, 100},
+    };
+    #elif MIXER_PRESET == MIXER_PRESET_ELEVONS
+    // Элевоны (летающее крыло): элероны отрабатывают и крен, и тангаж
+    static constexpr MixRule MIX_RULES[] = {
+        {CH_L_AILERON, MIX_IN_ROLL, 70},
+        {CH_L_AILERON, MIX_IN_PITCH, -70},
+        {CH_R_AILERON, MIX_IN_ROLL, 70},
+        {CH_R_AILERON, MIX_IN_PITCH, 70},
+        {CH_L_RUDDER, MIX_IN_YAW, 100},
+        {CH_R_RUDDER, MIX_IN_YAW, 100},
+        {CH_MOTOR, MIX_IN_THROTTLE, 100},
+    };
+    #else
+    // Классическая схема: каждая поверхность от своей оси
+    static constexpr MixRule MIX_RULES[] = {
+        {CH_L_ELEVATOR, MIX_IN_PITCH, 100},
+        {CH_R_ELEVATOR, MIX_IN_PITCH, 100},
+        {CH_L_RUDDER, MIX_IN_YAW, 100},
+        {CH_R_RUDDER, MIX_IN_YAW, 100},
+        {CH_L_AILERON, MIX_IN_ROLL, 100},
+        {CH_R_AILERON, MIX_IN_ROLL, 100},
+        {CH_L_FLAPS, MIX_IN_FLAPS, 100},
+        {CH_R_FLAPS, MIX_IN_FLAPS, 100},
+        {CH_MOTOR, MIX_IN_THROTTLE, 100},
+    };
+    #endif
+
+    // Позы тестовых последовательностей: -1 минимум, 0 нейтраль, 1 максимум
+    static constexpr int8_t POSES[POSE_COUNT][SURFACE_COUNT] = {
+        {0, 0, 0, 0, 0, 0, 0, 0},           // POSE_NEUTRAL
+        {-1, -1, -1, -1, -1, -1, -1, -1},   // POSE_MIN
+        {1, 1, 1, 1, 1, 1, 1, 1},           // POSE_MAX
+        {0, 0, 0, 0, 1, -1, 0, 0},          // POSE_AILERONS_SPLIT
+        {0, 0, 1, 1, 0, 0, 1, 1},           // POSE_RUDDER_FLAPS
+    };
+
+    // Газ: однополярная ось, без ограничения скорости нарастания
+    static constexpr uint8_t THROTTLE_EXPO = 0;
+    static constexpr uint16_t THROTTLE_RAMP_UP_MS = 0;
+    static constexpr uint16_t THROTTLE_RAMP_BRAKE_MS = 0;
+
+    // Потеря связи: удержание, затем пологий круг со снижением (FAILSAFE_CIRCLE_*)
+    static constexpr FailsafeMode FAILSAFE_MODE = FAILSAFE_MODE_GLIDE;
+};
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+
+// ============================================================================
+// ПОШАГОВЫЕ ПОСЛЕДОВАТЕЛЬНОСТИ (калибровка ESC, вооружение, тесты)
+// ============================================================================
+//
+// Последовательность - таблица шагов, которую ServoManager продвигает из тика
+// управления. Ни один шаг не блокирует: пауза - это время удержания шага,
+// ожидание клавиши - шаг с таймаутом. Поэтому во время калибровки и тестов
+// продолжают работать прием пакетов, детектор потери связи и failsafe.
+
+// Действие шага
+enum SequenceAction : uint8_t {
+    SEQ_PRINT = 0,      // Только сообщение
+    SEQ_CONFIRM,        // Ждать 'y' (другая клавиша - отмена). value - таймаут, мс
+    SEQ_WAIT_KEY,       // Ждать любую клавишу. value - таймаут, мс
+    SEQ_SKIP_IF_ARMED,  // Мотор уже вооружен - пропустить value следующих шагов
+    SEQ_MOTOR,          // Мотор = value мкс
+    SEQ_MOTOR_RAMP,     // Мотор value -> target мкс с шагом increment, holdMs на каждый шаг
+    SEQ_MOTOR_PENDING,  // Мотор = значение, заданное при запуске (directMotorTest)
+    SEQ_POSE,           // Поверхности в позу value, мотор target мкс
+    SEQ_POSE_RAMP,      // Поверхности нейтраль -> поза value шагами increment %, мотор до target мкс
+    SEQ_SURFACE,        // Одна поверхность value в положение target (SequencePose)
+    SEQ_ARM,            // Мотор вооружен, первое обновление - STOP
+    SEQ_ESC_COMMAND,    // DShot: команда ESC value (DSHOT_CMD_*), target кадров подряд
+    SEQ_END
+};
+
+// Позы поверхностей
+enum SequencePose : uint8_t {
+    POSE_NEUTRAL = 0,
+    POSE_MIN,
+    POSE_MAX,
+    POSE_AILERONS_SPLIT,    // Элероны в противофазе, остальное в нейтрали
+    POSE_RUDDER_FLAPS,      // Рули направления и закрылки в максимум
+    POSE_COUNT
+};
+
+struct SequenceStep {
+    uint8_t action;
+    int16_t value;
+    int16_t target;
+    int16_t increment;
+    uint16_t holdMs;        // Пауза после шага (для рамп - между шагами)
+    const char* message;    // nullptr - без сообщения
+};
+
+struct Sequence {
+    const char* name;
+    const SequenceStep* steps;
+    bool ownsSurfaces;      // Пульт не управляет поверхностями, пока идет последовательность
+    const Sequence* next;   // Запустить после успешного завершения
+    bool keepOnFailsafe;    // Потеря связи не прерывает (калибровка диапазона ESC с консоли)
+};
@@ -1,82 +1,45 @@
 #include "ServoGroup.h"
-#include <Arduino.h>
+#include "HAL/Hal.h"
 
-// Конструктор БЕЗ значений по умолчанию - импульсы обязательны
-ServoGroup::ServoGroup(uint8_t pin, int minAngle, int maxAngle, int neutralAngle, const char* name,
-                       int minPulse, int maxPulse)
-    : pin(pin), minAngle(minAngle), maxAngle(maxAngle), neutralAngle(neutralAngle), 
-      name(name), minPulse(minPulse), maxPulse(maxPulse) {
+// Углы 0-180° покрывают диапазон PWM-канала
+ServoGroup::ServoGroup(const OutputSpec& spec)
+    : pin(spec.pin), minAngle(0), maxAngle(180), name(spec.name),
+      minPulse(outputPwmMin(spec)), maxPulse(outputPwmMax(spec)), restPulse(outputRestPulse(spec)) {
 }
 
 void ServoGroup::begin() {
-    Serial.print("🚀 INIT ");
-    Serial.print(name);
-    Serial.print(" Servo [Pulse: ");
-    Serial.print(minPulse);
-    Serial.print("-");
-    Serial.print(maxPulse);
-    Serial.println("μs]");
-    
-    servo.attach(pin, minPulse, maxPulse);
-    servo.write(neutralAngle);
-    currentAngle = neutralAngle;
-    delay(500);
-}
-
-void ServoGroup::write(int angle) {
-    angle = constrain(angle, minAngle, maxAngle);
-    servo.write(angle);
-    currentAngle = angle;
-}
-
-void ServoGroup::writeSmooth(int targetAngle, int movementTime) {
-    targetAngle = constrain(targetAngle, minAngle, maxAngle);
-    
-    if (targetAngle == currentAngle) {
-        return;
+    console.print("🚀 INIT ");
+    console.print(name);
+    console.print(" Servo [Pulse: ");
+    console.print(minPulse);
+    console.print("-");
+    console.print(maxPulse);
+    console.print("μs]");
+    if (dshotSpeed != 0) {
+        console.printf(" -> DShot%u", (unsigned)dshotSpeed);
     }
+    console.println();
     
-    int angleDifference = abs(targetAngle - currentAngle);
-    int steps = angleDifference;
-    int stepDelay = movementTime / steps;
-    
-    stepDelay = constrain(stepDelay, 1, 100);
-    
-    int step = (targetAngle > currentAngle) ? 1 : -1;
-    
-    for (int i = 0; i < steps; i++) {
-        currentAngle += step;
-        servo.write(currentAngle);
-        delay(stepDelay);
-    }
-}
-
-void ServoGroup::testToNeutral() {
-    writeSmooth(neutralAngle, 1000);
+    attach();
 }
 
-void ServoGroup::testToMin() {
-    writeSmooth(minAngle, 1000);
+void ServoGroup::attach() {
+    // Без задержки: все выходы начинают импульсы в одном периоде PWM
+    if (dshotSpeed != 0) {
+        servo.attachDshot(pin, minPulse, restPulse, maxPulse, dshotSpeed);
+    } else {
+        servo.attach(pin, minPulse, maxPulse);
+    }
+    servo.stageMicroseconds(restPulse);
 }
 
-void ServoGroup::testToMax() {
-    writeSmooth(maxAngle, 1000);
+void ServoGroup::write(int angle) {
+    angle = constrain(angle, minAngle, maxAngle);
+    servo.write(angle);
 }
 
-void ServoGroup::testSequence() {
-    isTesting = true;
-    
-    testToNeutral();
-    delay(1000);
-    
-    testToMin();
-    delay(500);
-    
-    testToMax();
-    delay(500);
-    
-    testToNeutral();
-    delay(500);
-    
-    isTesting = false;
+int ServoGroup::getCurrentAngle() const {
+    // Текущий угол восстанавливается из импульса: пакетная запись идет в микросекундах
+    const int range = maxPulse - minPulse;
+    return ((getCurrentPulse() - minPulse) * 180 + range / 2) / range;
 }
\ No newline at end of file
@@ -1,31 +1,31 @@
 #pragma once
-#include <ESP32Servo.h>
+#include "HAL/PwmOutput.h"
 #include "Core/Types.h"
+#include "Actuators/OutputSpec.h"
 
 class ServoGroup {
 public:
-    ServoGroup(uint8_t pin, int minAngle, int maxAngle, int neutralAngle, const char* name, 
-               int minPulse, int maxPulse);
-    void begin();
+    // Выход из таблицы профиля (Actuators/AirframeProfile.h)
+    explicit ServoGroup(const OutputSpec& spec);
+    void useDshot(uint16_t speedKbps) { dshotSpeed = speedKbps; }  // До attach(): ESC по DShot
+    void begin();           // attach() с сообщением в консоль
+    void attach();          // Занять канал и подготовить нейтраль (вывод - общим PwmBank::commit())
     void write(int angle);
-    void writeSmooth(int angle, int movementTime = 200);
     void writeMicroseconds(int us);
-    void testSequence();
-    void testToNeutral();
-    void testToMin();
-    void testToMax();
+    void stageMicroseconds(int us) { servo.stageMicroseconds(us); }  // До PwmBank::commit()
+    bool sendEscCommand(uint8_t command, uint8_t repeat) { return servo.sendCommand(command, repeat); }
     const char* getName() const { return name; }
-    int getCurrentAngle() const { return currentAngle; }
+    int getCurrentAngle() const;
+    int getCurrentPulse() const { return servo.readMicroseconds(); }
     
 private:
-    Servo servo;
+    PwmOutput servo;
     uint8_t pin;
     int minAngle;
     int maxAngle;
-    int neutralAngle;
     const char* name;
-    bool isTesting = false;
-    int currentAngle = 0;
     int minPulse;
     int maxPulse;
+    int restPulse;          // Импульс при подключении: нейтраль сервопривода, стоп ESC
+    uint16_t dshotSpeed = 0;    // 0 - импульс PWM
 };
\ No newline at end of file
@@ -1,794 +1,980 @@
 #include "ServoManager.h"
-#include <Arduino.h>
+#include "Diagnostics/LatencyMonitor.h"
+#include "Diagnostics/EventLog.h"
+#include "Core/ConfigStore.h"
+#include "HAL/Hal.h"
+
+static_assert(FLIGHT_CONFIG_OUTPUTS == MIXER_MAX_OUTPUTS, "FlightConfig outputs must match the mixer");
+static_assert(FLIGHT_CONFIG_AXES == MIX_IN_FLAPS, "FlightConfig axes must match MixerInput order");
+static_assert(MOTOR_PROTOCOL == MOTOR_PROTOCOL_PWM || MOTOR_PROTOCOL == DSHOT150 ||
+              MOTOR_PROTOCOL == DSHOT300 || MOTOR_PROTOCOL == DSHOT600, "MOTOR_PROTOCOL: PWM or DSHOT150/300/600");
+
+// Кривые стиков по умолчанию строятся компилятором и лежат во flash.
+// Если настройки в NVS с ними совпадают (обычный случай), таблицы в RAM не строятся
+static constexpr CurveParams CURVE_DEFAULTS[ServoManager::CURVE_SLOT_COUNT] = {
+    {DEADZONE_YAXIS1, EXPO_ELEVATOR, RATE_HIGH, false},
+    {DEADZONE_YAXIS1, EXPO_ELEVATOR, RATE_LOW, false},
+    {DEADZONE_XAXIS1, EXPO_RUDDER, RATE_HIGH, false},
+    {DEADZONE_XAXIS1, EXPO_RUDDER, RATE_LOW, false},
+    {DEADZONE_XAXIS2, EXPO_AILERON, RATE_HIGH, false},
+    {DEADZONE_XAXIS2, EXPO_AILERON, RATE_LOW, false},
+    {DEADZONE_THROTTLE, AirframeProfile::THROTTLE_EXPO, 100, !AIRFRAME_ESC_REVERSIBLE},
+};
+
+static constexpr CurveTable CURVE_TABLES[ServoManager::CURVE_SLOT_COUNT] = {
+    buildCurveTable(CURVE_DEFAULTS[0]),
+    buildCurveTable(CURVE_DEFAULTS[1]),
+    buildCurveTable(CURVE_DEFAULTS[2]),
+    buildCurveTable(CURVE_DEFAULTS[3]),
+    buildCurveTable(CURVE_DEFAULTS[4]),
+    buildCurveTable(CURVE_DEFAULTS[5]),
+    buildCurveTable(CURVE_DEFAULTS[6]),
+};
+
+// Импульсы ESC в церемонии и последовательностях - от стопа профиля: для ESC
+// газ/тормоз стоп - нейтраль, поэтому тест "мотора" никогда не включает реверс
+#define MOTOR_STOP_US              ServoManager::MOTOR_STOP_PULSE
+#define MOTOR_FULL_US              ServoManager::MOTOR_FULL_PULSE
+#define MOTOR_REVERSE_US           ServoManager::OUTPUTS[ServoManager::CH_MOTOR].minUs
+#define MOTOR_PERCENT_US(percent)  (MOTOR_STOP_US + (MOTOR_FULL_US - MOTOR_STOP_US) * (percent) / 100)
+
+// Угол мотора из старых тестов (0-180) в микросекунды
+#define MOTOR_ANGLE_US(angle)      (MOTOR_STOP_US + (angle) * (MOTOR_FULL_US - MOTOR_STOP_US) / 180)
+#define MOTOR_ANGLE_STEP_US        (MOTOR_ANGLE_US(5) - MOTOR_STOP_US)
 
 ServoManager::ServoManager()
-    : L_elevatorServo(HardwareConfig::L_ELEVATOR_PIN, L_ELEVATOR_MIN, L_ELEVATOR_MAX, L_ELEVATOR_NEUTRAL, "L_ELEVATOR", SERVO_MIN_PULSE, SERVO_MAX_PULSE),
-      R_elevatorServo(HardwareConfig::R_ELEVATOR_PIN, R_ELEVATOR_MIN, R_ELEVATOR_MAX, R_ELEVATOR_NEUTRAL, "R_ELEVATOR", SERVO_MIN_PULSE, SERVO_MAX_PULSE),
-      L_rudderServo(HardwareConfig::L_RUDDER_PIN, L_RUDDER_MIN, L_RUDDER_MAX, L_RUDDER_NEUTRAL, "L_RUDDER", SERVO_MIN_PULSE, SERVO_MAX_PULSE),
-      R_rudderServo(HardwareConfig::R_RUDDER_PIN, R_RUDDER_MIN, R_RUDDER_MAX, R_RUDDER_NEUTRAL, "R_RUDDER", SERVO_MIN_PULSE, SERVO_MAX_PULSE),
-      L_aileronServo(HardwareConfig::L_AILERON_PIN, L_AILERON_MIN, L_AILERON_MAX, L_AILERON_NEUTRAL, "L_LEFT_AILERON", SERVO_MIN_PULSE, SERVO_MAX_PULSE),
-      R_aileronServo(HardwareConfig::R_AILERON_PIN, R_AILERON_MIN, R_AILERON_MAX, R_AILERON_NEUTRAL, "R_RIGHT_AILERON", SERVO_MIN_PULSE, SERVO_MAX_PULSE),
-      L_flapServo(HardwareConfig::L_FLAPS_PIN, L_FLAPS_MIN, L_FLAPS_MAX, L_FLAPS_NEUTRAL, "L_FLAPS", SERVO_MIN_PULSE, SERVO_MAX_PULSE),
-      R_flapServo(HardwareConfig::R_FLAPS_PIN, R_FLAPS_MIN, R_FLAPS_MAX, R_FLAPS_NEUTRAL, "R_FLAPS", SERVO_MIN_PULSE, SERVO_MAX_PULSE),
-      motorServo(HardwareConfig::MOTOR_PIN, MOTOR_MIN, MOTOR_MAX, MOTOR_NEUTRAL, "MOTOR", MOTOR_MIN_PULSE, MOTOR_MAX_PULSE)
+    : ServoManager(std::make_index_sequence<OUTPUT_COUNT>()) {
+}
+
+template <size_t... Index>
+ServoManager::ServoManager(std::index_sequence<Index...>)
+    : channels{ServoGroup(OUTPUTS[Index])...}
 {
+#if MOTOR_DSHOT
+    channels[CH_MOTOR].useDshot(MOTOR_PROTOCOL);
+#endif
+    
+    // До загрузки настроек из NVS - значения по умолчанию
+    FlightConfig defaults;
+    makeDefaultConfig(defaults);
+    applyConfig(defaults);
+    configureMixer();
+    
     motorArmed = false;
     firstMotorUpdate = true;
     testsEnabled = false;
 }
 
-void ServoManager::begin() {
-    Serial.println("🚀 ServoManager - FLIGHT MODE");
-    Serial.println("📌 Configuration:");
-    Serial.print("   - Smooth Movement: ");
-    Serial.println(SMOOTH_SERVO_MOVEMENT ? "ENABLED" : "DISABLED");
-    
-    delay(100);
-    
-    // Инициализация сервоприводов управления
-    Serial.println("🎯 Initializing servos...");
-    L_elevatorServo.begin();
-    R_elevatorServo.begin();
-    L_rudderServo.begin();
-    R_rudderServo.begin();
-    L_aileronServo.begin();
-    R_aileronServo.begin();
-    L_flapServo.begin();
-    R_flapServo.begin();
-    
-    // 🔥 КРИТИЧЕСКОЕ ИСПРАВЛЕНИЕ: ПРАВИЛЬНАЯ ИНИЦИАЛИЗАЦИЯ ESC ДЛЯ BLHeli
-    Serial.println("\n🔧 ESC Initialization (BLHeli)");
-    Serial.println("⚠️  IMPORTANT: Follow steps carefully!");
-    Serial.println("1. PROPELLER REMOVED?");
-    Serial.println("2. Battery DISCONNECTED from ESC");
-    Serial.println("3. Wait for signal...");
-    
-    // 1. Инициализируем ESC
-    motorServo.begin();  // Вызовет attach с импульсами 1000-2000μs
-    
-    // 2. Отправляем STOP сигнал (БАТАРЕЯ ОТКЛЮЧЕНА)
-    Serial.println("\n🎯 STEP 1: Sending STOP signal (1000μs) - NO BATTERY");
-    motorServo.writeMicroseconds(1000);
-    delay(1000);
-    
-    // 3. Говорим подключить батарею
-    Serial.println("\n⚠️  ⚠️  ⚠️  NOW: CONNECT BATTERY to ESC! ⚠️  ⚠️  ⚠️");
-    Serial.println("   Wait for 3 beeps (cell count)...");
-    delay(3000);  // Даем время подключить батарею
-    
-    // 4. Ждем завершения инициализации ESC
-    Serial.println("\n🎯 STEP 2: Waiting for ESC initialization...");
-    Serial.println("   You should hear 1 more beep (signal received)");
-    delay(2000);
-    
-    // 5. BLHeli АКТИВАЦИЯ: максимум на 1 секунду
-    Serial.println("\n🎯 STEP 3: BLHeli activation sequence");
-    Serial.println("   Sending 2000μs (max) for 1 second...");
-    motorServo.writeMicroseconds(2000);
-    delay(1000);
-    
-    // 6. Возвращаем STOP
-    Serial.println("   Sending 1000μs (stop)...");
-    motorServo.writeMicroseconds(1000);
-    delay(1000);
-    
-    // 7. Проверка работы
-    Serial.println("\n🎯 STEP 4: Testing ESC (1200μs = 10% power)...");
-    motorServo.writeMicroseconds(1200);
-    delay(500);
-    
-    Serial.println("   Returning to STOP (1000μs)...");
-    motorServo.writeMicroseconds(1000);
-    delay(500);
-    
-    motorArmed = true;
-    firstMotorUpdate = true;
-    
-    Serial.println("\n✅ ESC ARMED and READY for BLHeli");
-    Serial.println("✅ All servos READY for flight");
-    Serial.println("\n📝 Send 'h' for available commands");
+#define MIX_RULE_COUNT(rules) (uint8_t)(sizeof(rules) / sizeof(rules[0]))
+
+// ============================================================================
+// НАСТРОЙКИ (ConfigStore)
+// ============================================================================
+
+void ServoManager::makeDefaultConfig(FlightConfig& config) {
+    config = {};
+    
+    // Диапазоны выходов сразу в микросекундах: на горячем пути нет пересчета угла в импульс.
+    // Свободные выходы получают диапазон ESC
+    for (uint8_t i = 0; i < FLIGHT_CONFIG_OUTPUTS; i++) {
+        const OutputSpec& spec = OUTPUTS[i < OUTPUT_COUNT ? i : (uint8_t)CH_MOTOR];
+        OutputConfig& output = config.outputs[i];
+        output.minUs = spec.minUs;
+        output.neutralUs = spec.neutralUs;
+        output.maxUs = spec.maxUs;
+        output.reversed = i < OUTPUT_COUNT && spec.reversed;
+    }
     
-    // Сбрасываем флаг BLHeli активации (уже сделали в begin)
-    blheliFirstRun = false;
-    blheliActivationStart = 0;
-    blheliActivationStep = 0;
+    config.axes[MIX_IN_ROLL] = {DEADZONE_XAXIS2, EXPO_AILERON, 0};
+    config.axes[MIX_IN_PITCH] = {DEADZONE_YAXIS1, EXPO_ELEVATOR, 0};
+    config.axes[MIX_IN_YAW] = {DEADZONE_XAXIS1, EXPO_RUDDER, 0};
+    config.axes[MIX_IN_THROTTLE] = {DEADZONE_THROTTLE, THROTTLE_EXPO, 0};
+    config.rateHighPercent = RATE_HIGH;
+    config.rateLowPercent = RATE_LOW;
+    config.airframe = AIRFRAME_PROFILE;
+    
+    Failsafe::makeDefaultConfig(config.failsafe);
+    config.failsafe.mode = FAILSAFE_MODE;
+    
+    static const uint16_t PID_DEFAULTS[FLIGHT_CONFIG_PID_AXES][5] = {
+        {PID_ROLL_KP, PID_ROLL_KI, PID_ROLL_KD, PID_ROLL_KFF, STAB_MAX_RATE_ROLL},
+        {PID_PITCH_KP, PID_PITCH_KI, PID_PITCH_KD, PID_PITCH_KFF, STAB_MAX_RATE_PITCH},
+        {PID_YAW_KP, PID_YAW_KI, PID_YAW_KD, PID_YAW_KFF, STAB_MAX_RATE_YAW},
+    };
+    for (uint8_t i = 0; i < FLIGHT_CONFIG_PID_AXES; i++) {
+        const uint16_t* pid = PID_DEFAULTS[i];
+        config.pid[i] = {pid[0], pid[1], pid[2], pid[3], pid[4], 0};
+    }
+    config.level = {LEVEL_MAX_ANGLE, LEVEL_GAIN_TENTHS, 0};
 }
 
-void ServoManager::runManualTests() {
-    Serial.println("🧪 MANUAL TEST SEQUENCE");
-    Serial.println("⚠️  WARNING: Ensure propeller is removed!");
-    Serial.println("Send 'y' to confirm or any key to cancel...");
-    
-    // Ждем подтверждения 5 секунд
-    unsigned long start = millis();
-    while (millis() - start < 5000) {
-        if (Serial.available()) {
-            char c = Serial.read();
-            if (c == 'y' || c == 'Y') {
-                Serial.println("✅ Starting full test sequence...");
-                simultaneousTestSequence();
-                return;
-            } else {
-                Serial.println("❌ Test cancelled");
-                return;
-            }
-        }
+const CurveTable* ServoManager::selectCurve(uint8_t slot, const CurveParams& params) {
+    if (sameCurveParams(params, CURVE_DEFAULTS[slot])) {
+        return &CURVE_TABLES[slot];
     }
-    Serial.println("⏰ Timeout - test cancelled");
+    fillCurveTable(runtimeCurves[slot], params);
+    return &runtimeCurves[slot];
 }
 
-void ServoManager::calibrateESC() {
-    Serial.println("\n🎛️ ESC CALIBRATION MODE");
-    Serial.println("⚠️  ⚠️  ⚠️  WARNING: REMOVE PROPELLER! ⚠️  ⚠️  ⚠️");
-    Serial.println("\n📋 Procedure:");
-    Serial.println("1. Disconnect battery from ESC");
-    Serial.println("2. Send 'y' to start calibration");
-    Serial.println("3. Follow instructions");
-    
-    while (!Serial.available()) delay(100);
-    if (Serial.read() != 'y') {
-        Serial.println("❌ Calibration cancelled");
-        return;
+void ServoManager::applyConfig(const FlightConfig& config) {
+    for (uint8_t i = 0; i < OUTPUT_COUNT; i++) {
+        const OutputConfig& output = config.outputs[i];
+        mixer.configureOutput(i, output.minUs, output.neutralUs, output.maxUs,
+                              output.reversed != 0, OUTPUTS[i].kind == OUTPUT_ESC);
     }
     
-    Serial.println("\n🔧 Starting calibration...");
-    
-    // ШАГ 1: Подготовка
-    Serial.println("\n🎯 STEP 1: Disconnect battery from ESC");
-    Serial.println("   Ensure battery is DISCONNECTED");
-    Serial.println("   Press any key when ready...");
-    while (!Serial.available()) delay(100);
-    Serial.read();
-    
-    // ШАГ 2: Максимальный газ
-    Serial.println("\n🎯 STEP 2: Sending MAX signal (2000μs)");
-    motorServo.writeMicroseconds(2000);
-    
-    Serial.println("⚠️  NOW: Connect battery to ESC!");
-    Serial.println("   Wait for beeps (2-3 beeps)");
-    delay(8000);
-    
-    // ШАГ 3: Минимальный газ
-    Serial.println("\n🎯 STEP 3: Sending MIN signal (1000μs)");
-    motorServo.writeMicroseconds(1000);
-    Serial.println("   Wait for confirmation beeps (1 long beep)");
-    delay(8000);
-    
-    // ШАГ 4: Готово
-    Serial.println("\n✅ Calibration complete!");
-    Serial.println("✅ ESC is now calibrated to 1000-2000μs range");
-    
-    motorArmed = true;
-    firstMotorUpdate = true;
-    
-    Serial.println("\n🔧 Testing calibration...");
-    Serial.println("   Sending 1500μs (50% power)");
-    motorServo.writeMicroseconds(1500);
-    delay(3000);
-    
-    Serial.println("   Returning to STOP (1000μs)");
-    motorServo.writeMicroseconds(1000);
-    delay(1000);
-    
-    Serial.println("✅ ESC calibrated and ready!");
+    const AxisConfig& pitch = config.axes[MIX_IN_PITCH];
+    const AxisConfig& yaw = config.axes[MIX_IN_YAW];
+    const AxisConfig& roll = config.axes[MIX_IN_ROLL];
+    const AxisConfig& throttle = config.axes[MIX_IN_THROTTLE];
+    elevatorCurves[RATE_SET_HIGH] = selectCurve(CURVE_PITCH_HIGH, {pitch.deadzone, pitch.expoPercent, config.rateHighPercent, false});
+    elevatorCurves[RATE_SET_LOW] = selectCurve(CURVE_PITCH_LOW, {pitch.deadzone, pitch.expoPercent, config.rateLowPercent, false});
+    rudderCurves[RATE_SET_HIGH] = selectCurve(CURVE_YAW_HIGH, {yaw.deadzone, yaw.expoPercent, config.rateHighPercent, false});
+    rudderCurves[RATE_SET_LOW] = selectCurve(CURVE_YAW_LOW, {yaw.deadzone, yaw.expoPercent, config.rateLowPercent, false});
+    aileronCurves[RATE_SET_HIGH] = selectCurve(CURVE_ROLL_HIGH, {roll.deadzone, roll.expoPercent, config.rateHighPercent, false});
+    aileronCurves[RATE_SET_LOW] = selectCurve(CURVE_ROLL_LOW, {roll.deadzone, roll.expoPercent, config.rateLowPercent, false});
+    throttleCurve = selectCurve(CURVE_THROTTLE, {throttle.deadzone, throttle.expoPercent, 100, !AIRFRAME_ESC_REVERSIBLE});
+    
+    escCalibrated = config.esc.calibrated != 0;
+    stabilizer.applyConfig(config);
 }
 
-void ServoManager::safeStartSequence() {
-    Serial.println("\n🔒 SAFE START SEQUENCE");
-    Serial.println("📋 Follow these steps:");
-    
-    // 1. Проверка пропеллера
-    Serial.println("\n1. ⚠️  PROPELLER REMOVED?");
-    Serial.println("   Type 'y' to confirm or any key to cancel");
+void ServoManager::setMotorArmed(bool armed) {
+    motorArmed = armed;
+    ConfigStore::getInstance().noteEscState(escCalibrated, armed);
+}
+
+void ServoManager::configureMixer() {
+    // Таблица правил профиля (для самолета - по MIXER_PRESET)
+    mixer.loadRules(MIX_RULES, MIX_RULE_COUNT(MIX_RULES));
+}
+
+void ServoManager::configureMotion() {
+    // SERVO_SPEED_* - время полного хода, переводим в ограничение скорости канала
+    const float medium = travelTimeToVelocity(SERVO_SPEED_MEDIUM);
+    const float fast = travelTimeToVelocity(SERVO_SPEED_FAST);
+    const float slow = travelTimeToVelocity(SERVO_SPEED_SLOW);
+    
+    const float acceleration = angleRateToPulseRate(SERVO_ACCELERATION);
+    
+    for (uint8_t i = 0; i < SURFACE_COUNT; i++) {
+        const uint8_t speed = OUTPUTS[i].motion;
+        motion.configure(i, channels[i].getCurrentPulse(),
+                         speed == MOTION_FAST ? fast : (speed == MOTION_SLOW ? slow : medium), acceleration);
+    }
+}
+
+void ServoManager::tick(uint32_t dtUs) {
+    advanceSequence();
     
-    unsigned long start = millis();
-    while (millis() - start < 10000) {
-        if (Serial.available()) {
-            char c = Serial.read();
-            if (c == 'y' || c == 'Y') {
-                break;
-            } else {
-                Serial.println("❌ Cancelled - safety first!");
-                return;
-            }
+    #if SMOOTH_SERVO_MOVEMENT
+        // Во время тестов сервоприводами управляет тестовая последовательность
+        if (getIsTesting() || motion.isSettled()) {
+            return;
+        }
+        
+        motion.step(dtUs);
+        
+        for (uint8_t i = 0; i < SURFACE_COUNT; i++) {
+            channels[i].stageMicroseconds(motion.getOutput(i));
+        }
+        PwmBank::commit();
+    #else
+        (void)dtUs;
+    #endif
+}
+
+void ServoManager::applySurfaces(const int16_t outputs[MIXER_MAX_OUTPUTS]) {
+    #if SMOOTH_SERVO_MOVEMENT
+        // Плавное движение: задаем только цели, движение выполняет tick()
+        for (uint8_t i = 0; i < SURFACE_COUNT; i++) {
+            motion.setTarget(i, outputs[i]);
+        }
+    #else
+        // Прямое управление сервоприводами (выходы микшера уже в микросекундах)
+        for (uint8_t i = 0; i < SURFACE_COUNT; i++) {
+            channels[i].stageMicroseconds(outputs[i]);
         }
+    #endif
+}
+
+void ServoManager::applyFailsafe(const FailsafeStage& stage) {
+    // Тест без связи не продолжается: мотор на STOP, дальше - ступень failsafe.
+    // Калибровкой ESC на стенде по-прежнему управляет оператор с консоли
+    if (activeSequence != nullptr) {
+        if (activeSequence->keepOnFailsafe) {
+            return;
+        }
+        cancelSequence("🛟 Link lost");
     }
     
-    // 2. Отключение батареи
-    Serial.println("\n2. 🔋 Disconnect battery from ESC");
-    Serial.println("   Type 'y' when battery is disconnected");
-    
-    while (!Serial.available()) delay(100);
-    if (Serial.read() != 'y') {
-        Serial.println("❌ Cancelled");
+    int16_t mixerInputs[MIXER_INPUT_COUNT];
+    Failsafe::applyStage(stage, lastInputs, mixerInputs);
+    applyCommands(mixerInputs);
+    
+    // После потери связи фильтры и оценка начинаются заново с первого пакета:
+    // медиана, ФНЧ и ограничение скорости не возвращают команду до потери.
+    // Ступени failsafe задают поверхности напрямую: стабилизатор не участвует
+    // и после восстановления связи начинает без накопленного интеграла
+    rollFilter.reset();
+    pitchFilter.reset();
+    yawFilter.reset();
+    throttleFilter.reset();
+    estimator.reset();
+    motorRamp.reset();
+    #if STABILIZER_ENABLED
+        stabilizer.reset();
+    #endif
+}
+
+void ServoManager::updateEstimate(uint32_t nowUs) {
+    if (activeSequence != nullptr || !estimator.hasSample()) {
         return;
     }
-    
-    // 3. Инициализация ESC
-    Serial.println("\n3. 🔧 Initializing ESC...");
-    motorServo.writeMicroseconds(1000);
-    delay(1000);
-    
-    // 4. Подключение батареи
-    Serial.println("\n4. 🔋 NOW: Connect battery to ESC");
-    Serial.println("   Wait for beeps...");
-    delay(5000);
-    
-    // 5. Тест
-    Serial.println("\n5. 🎯 Testing ESC...");
-    Serial.println("   Sending 1200μs (10% power)");
-    motorServo.writeMicroseconds(1200);
-    delay(2000);
-    
-    Serial.println("   Sending 1000μs (STOP)");
-    motorServo.writeMicroseconds(1000);
-    delay(1000);
-    
-    motorArmed = true;
-    firstMotorUpdate = true;
-    
-    Serial.println("\n✅ SAFE START COMPLETE");
-    Serial.println("✅ ESC armed and ready");
+    #if ESTIMATOR_MODE == ESTIMATOR_HOLD
+        // Без стабилизации команда между пакетами не меняется.
+        // Со стабилизацией ПИД работает каждый тик: датчик обновляется чаще пакетов
+        #if STABILIZER_ENABLED
+            if (stabilizer.getMode() == FLIGHT_MODE_MANUAL) {
+                return;
+            }
+        #else
+            return;
+        #endif
+    #endif
+    int16_t mixerInputs[MIXER_INPUT_COUNT];
+    estimator.estimate(nowUs, mixerInputs);
+    mixerInputs[MIX_IN_THROTTLE] = motorRamp.process(mixerInputs[MIX_IN_THROTTLE], nowUs);
+    #if STABILIZER_ENABLED
+        stabilizer.apply(mixerInputs, flightMode);
+    #endif
+    applyCommands(mixerInputs);
 }
 
-void ServoManager::escTestSimple() {
-    Serial.println("🎯 SIMPLE ESC TEST (using microseconds)");
+void ServoManager::sampleImu() {
+    #if STABILIZER_ENABLED
+        stabilizer.sample();
+    #endif
+}
+
+void ServoManager::beginImu() {
+    #if STABILIZER_ENABLED
+        stabilizer.begin();
+    #endif
+}
+
+void ServoManager::applyCommands(const int16_t mixerInputs[MIXER_INPUT_COUNT]) {
+    int16_t outputs[MIXER_MAX_OUTPUTS];
+    mixer.evaluate(mixerInputs, outputs);
     
+    // Мотор: во время активации BLHeli импульсы задает update()
     if (!motorArmed) {
-        Serial.println("⚠️  Arming ESC first...");
-        motorServo.writeMicroseconds(1000);
-        delay(2000);
-        motorArmed = true;
+        channels[CH_MOTOR].stageMicroseconds(MOTOR_STOP_PULSE);
+    } else if (!blheliFirstRun && !firstMotorUpdate) {
+        channels[CH_MOTOR].stageMicroseconds(motorPulse(mixerInputs[MIX_IN_THROTTLE], outputs[CH_MOTOR]));
     }
     
-    int testValues[] = {1000, 1100, 1200, 1300, 1400, 1500, 1600, 1700, 1800, 1900, 2000};
-    const char* labels[] = {"STOP", "5%", "10%", "15%", "20%", "25%", "30%", "35%", "40%", "45%", "50%"};
-    
-    for (int i = 0; i < 11; i++) {
-        Serial.print("🎯 ");
-        Serial.print(labels[i]);
-        Serial.print(" (");
-        Serial.print(testValues[i]);
-        Serial.println("μs)");
-        
-        motorServo.writeMicroseconds(testValues[i]);
-        delay(2000);
+    applySurfaces(outputs);
+    PwmBank::commit();
+}
+
+void ServoManager::attachOutputs(bool verbose) {
+    // ESC подключается со стоп-импульсом (MOTOR_STOP_PULSE)
+    for (uint8_t i = 0; i < OUTPUT_COUNT; i++) {
+        if (verbose) {
+            channels[i].begin();
+        } else {
+            channels[i].attach();
+        }
     }
     
-    // Возврат в STOP
-    motorServo.writeMicroseconds(1000);
-    Serial.println("✅ Test complete - ESC STOPPED");
+    // Все выходы начинают импульсы в одном периоде
+    PwmBank::commit();
+    outputsLiveUs = Clock::micros();
+    configureMotion();
 }
 
-void ServoManager::safeMotorStart() {
-    Serial.println("🔧 Motor Safe Start - FULL RANGE -512 to +512");
-    
-    // Калибровка с полным диапазоном
-    motorServo.write(180);
-    Serial.println("   ⚡ MAX FORWARD (180)");
-    delay(2000);
-    
-    motorServo.write(0);
-    Serial.println("   🔄 MAX REVERSE (0)");
-    delay(2000);
-    
-    motorServo.write(0);
-    Serial.println("   ✅ NEUTRAL - READY");
-    delay(2000);
+void ServoManager::beginFast() {
+    attachOutputs(false);
+    beginImu();
     
-    motorArmed = true;
+    // Церемония уже была до сброса: восстанавливаем последнее известное состояние ESC.
+    // Первые FAST_BOOT_MOTOR_HOLD_MS мотор держится на STOP, чтобы ESC снова увидел нулевой газ
+    motorArmed = ConfigStore::getInstance().active().esc.armed != 0;
+    blheliFirstRun = false;
     firstMotorUpdate = true;
-    
-    Serial.println("✅ Motor ARMED - Full range mapping active");
+    motorHoldUntilMs = Clock::millis() + FAST_BOOT_MOTOR_HOLD_MS;
 }
 
-void ServoManager::testMotorSequence() {
-    Serial.println("🎯 MOTOR Test Sequence");
-    Serial.println("⚠️  WARNING: PROPELLER REMOVED?");
+void ServoManager::begin() {
+    console.println("🚀 ServoManager - FLIGHT MODE");
+    console.println("📌 Configuration:");
+    console.printf("   - Airframe: %s, %u outputs\n", NAME, (unsigned)OUTPUT_COUNT);
+#if MOTOR_DSHOT
+    console.printf("   - ESC: DShot%u, %u frames/s\n", (unsigned)MOTOR_PROTOCOL, (unsigned)DSHOT_FRAME_RATE_HZ);
+#else
+    console.println("   - ESC: PWM 50 Hz");
+#endif
+    console.print("   - Smooth Movement: ");
+    console.println(SMOOTH_SERVO_MOVEMENT ? "ENABLED" : "DISABLED");
+    
+    Clock::delay(100);
+    
+    // Инициализация сервоприводов управления: все выходы сразу, одна общая пауза
+    console.println("🎯 Initializing servos...");
+    attachOutputs(true);
+    Clock::delay(SERVO_SETTLE_MS);
+    
+#if MOTOR_DSHOT
+    // DShot: диапазон цифровой, ESC вооружается непрерывным потоком кадров "стоп"
+    console.println("\n🔧 ESC Initialization (DShot)");
+    console.println("⚠️  PROPELLER REMOVED / WHEELS OFF THE GROUND? Connect battery to ESC now");
+    console.println("   Sending STOP frames...");
+    channels[CH_MOTOR].writeMicroseconds(MOTOR_STOP_PULSE);
+    Clock::delay(DSHOT_ARM_MS);
+    
+    setMotorArmed(true);
+    firstMotorUpdate = true;
+    console.println("\n✅ ESC ARMED (DShot)");
+#elif AIRFRAME_ESC_REVERSIBLE
+    // ESC газ/тормоз вооружается нейтралью: без активации максимумом
+    console.println("\n🔧 ESC Initialization (throttle/brake)");
+    console.println("⚠️  WHEELS OFF THE GROUND? Connect battery to ESC now");
+    console.printf("   Holding NEUTRAL (%dμs)...\n", MOTOR_STOP_PULSE);
+    channels[CH_MOTOR].writeMicroseconds(MOTOR_STOP_PULSE);
+    Clock::delay(ESC_NEUTRAL_ARM_MS);
+    
+    setMotorArmed(true);
+    firstMotorUpdate = true;
+    console.println("\n✅ ESC ARMED (neutral)");
+#else
+    // 🔥 КРИТИЧЕСКОЕ ИСПРАВЛЕНИЕ: ПРАВИЛЬНАЯ ИНИЦИАЛИЗАЦИЯ ESC ДЛЯ BLHeli
+    console.println("\n🔧 ESC Initialization (BLHeli)");
+    console.println("⚠️  IMPORTANT: Follow steps carefully!");
+    console.println("1. PROPELLER REMOVED?");
+    console.println("2. Battery DISCONNECTED from ESC");
+    console.println("3. Wait for signal...");
     
-    if (!motorArmed) {
-        Serial.println("❌ Motor NOT armed - arming now...");
-        motorServo.write(0);  // Минимальный газ
-        delay(2000);
-        motorArmed = true;
-        firstMotorUpdate = true;
-    }
+    // 1. ESC уже подключен вместе с сервоприводами (attachOutputs)
     
-    // Тест 1: Нейтраль
-    Serial.println("🎯 TEST 1: Motor NEUTRAL (0%)");
-    motorServo.write(0);
-    delay(2000);
-    
-    // Тест 2: Плавное увеличение до 25%
-    Serial.println("🎯 TEST 2: Motor 25% power");
-    for (int i = 0; i <= 45; i += 5) {
-        motorServo.write(i);
-        Serial.print("   Power: ");
-        Serial.print(i);
-        Serial.print("° (");
-        Serial.print(map(i, 0, 180, 0, 100));
-        Serial.println("%)");
-        delay(500);  // Увеличил задержку для ESC
-    }
-    delay(2000);
-    
-    // Тест 3: Плавное увеличение до 50%
-    Serial.println("🎯 TEST 3: Motor 50% power");
-    for (int i = 45; i <= 90; i += 5) {
-        motorServo.write(i);
-        Serial.print("   Power: ");
-        Serial.print(i);
-        Serial.println("/180");
-        delay(300);
-    }
-    delay(2000);
-    
-    // Тест 4: Плавное уменьшение до 10%
-    Serial.println("🎯 TEST 4: Motor 10% power");
-    for (int i = 90; i >= 18; i -= 5) {
-        motorServo.write(i);
-        Serial.print("   Power: ");
-        Serial.print(i);
-        Serial.println("/180");
-        delay(300);
-    }
-    delay(2000);
+    // 2. Отправляем STOP сигнал (БАТАРЕЯ ОТКЛЮЧЕНА)
+    console.println("\n🎯 STEP 1: Sending STOP signal (1000μs) - NO BATTERY");
+    channels[CH_MOTOR].writeMicroseconds(MOTOR_STOP_PULSE);
+    Clock::delay(1000);
     
-    // Тест 5: Нейтраль
-    Serial.println("🎯 TEST 5: Motor NEUTRAL");
-    motorServo.write(0);
-    delay(2000);
+    // 3. Говорим подключить батарею
+    console.println("\n⚠️  ⚠️  ⚠️  NOW: CONNECT BATTERY to ESC! ⚠️  ⚠️  ⚠️");
+    console.println("   Wait for 3 beeps (cell count)...");
+    Clock::delay(3000);  // Даем время подключить батарею
     
-    Serial.println("✅ Motor test COMPLETE");
-}
-
-void ServoManager::moveAllServos(int L_elevator, int R_elevator, int L_rudder, int R_rudder, 
-                                int L_aileron, int R_aileron, int L_flaps, int R_flaps, int motor) {
-    // Сервоприводы
-    L_elevatorServo.write(L_elevator);
-    R_elevatorServo.write(R_elevator);
-    L_rudderServo.write(L_rudder);
-    R_rudderServo.write(R_rudder);
-    L_aileronServo.write(L_aileron);
-    R_aileronServo.write(R_aileron);
-    L_flapServo.write(L_flaps);
-    R_flapServo.write(R_flaps);
+    // 4. Ждем завершения инициализации ESC
+    console.println("\n🎯 STEP 2: Waiting for ESC initialization...");
+    console.println("   You should hear 1 more beep (signal received)");
+    Clock::delay(2000);
     
-    // Двигатель - безопасное ограничение для тестов
-    int safeMotor = constrain(motor, 0, MOTOR_TEST_MAX);
-    motorServo.write(safeMotor);
-    
-    // Вывод для отладки
-    Serial.print("   Motor: ");
-    Serial.print(safeMotor);
-    Serial.print("/180 (");
-    Serial.print((safeMotor * 100) / 180);
-    Serial.println("%)");
-}
-
-void ServoManager::simultaneousTestSequence() {
-    Serial.println("🧪 SIMULTANEOUS Servo Test Sequence");
-    Serial.println("🎯 ALL servos moving TOGETHER at the same time!");
-    Serial.println("⚠️  MOTOR LIMITED TO 33% FOR SAFETY TESTING");
-    
-    // Включаем тестовый режим, но не блокируем двигатель
-    isTesting = true;
-    
-    // ТЕСТ 0: Отдельный тест двигателя
-    Serial.println("🔧 Testing MOTOR separately first...");
-    testMotorSequence();
-
-    // ТЕСТ 1: Все в нейтральное положение ОДНОВРЕМЕННО
-    Serial.println("🎯 TEST 1: ALL SERVOS → NEUTRAL");
-    moveAllServos(L_ELEVATOR_NEUTRAL, R_ELEVATOR_NEUTRAL, L_RUDDER_NEUTRAL, R_RUDDER_NEUTRAL,
-                  L_AILERON_NEUTRAL, R_AILERON_NEUTRAL,
-                  L_FLAPS_NEUTRAL, R_FLAPS_NEUTRAL, 
-                  0);
-    delay(TEST_DELAY_LONG);
-    
-    // ТЕСТ 2: Все в минимальное положение ОДНОВРЕМЕННО
-    Serial.println("🎯 TEST 2: ALL SERVOS → MINIMUM");
-    moveAllServos(L_ELEVATOR_MIN, R_ELEVATOR_MIN, 
-                  L_RUDDER_MIN, R_RUDDER_MIN,
-                  L_AILERON_MIN, R_AILERON_MIN,
-                  L_FLAPS_MIN, R_FLAPS_MIN, 
-                  0);
-    delay(TEST_DELAY_LONG);
-    
-    // ТЕСТ 3: Все в максимальное положение ОДНОВРЕМЕННО
-    Serial.println("🎯 TEST 3: ALL SERVOS → MAXIMUM");
-    moveAllServos(L_ELEVATOR_MAX, R_ELEVATOR_MAX, 
-                  L_RUDDER_MAX, R_RUDDER_MAX,
-                  L_AILERON_MAX, R_AILERON_MAX,
-                  L_FLAPS_MAX, R_FLAPS_MAX, 
-                  30); // Мотор на 30% одновременно с сервоприводами
-    delay(TEST_DELAY_LONG);
-    
-    // ТЕСТ 4: Элероны в противофазе
-    Serial.println("🎯 TEST 4: AILERONS ANTI-PHASE");
-    moveAllServos(L_ELEVATOR_NEUTRAL, R_ELEVATOR_NEUTRAL,
-                  L_RUDDER_NEUTRAL, R_RUDDER_NEUTRAL,
-                  L_AILERON_MAX, R_AILERON_MIN,
-                  L_FLAPS_NEUTRAL, R_FLAPS_NEUTRAL,
-                  20);
-    delay(TEST_DELAY_SHORT);
-    
-    // ТЕСТ 5: Руль направления + закрылки
-    Serial.println("🎯 TEST 5: RUDDER + FLAPS");
-    moveAllServos(L_ELEVATOR_NEUTRAL, R_ELEVATOR_NEUTRAL,
-                  L_RUDDER_MAX, R_RUDDER_MAX,
-                  L_AILERON_NEUTRAL, R_AILERON_NEUTRAL,
-                  L_FLAPS_MAX, R_FLAPS_MAX,
-                  25);
-    delay(TEST_DELAY_SHORT);
-    
-    // ТЕСТ 6: Все сервоприводы + мотор плавно
-    Serial.println("🎯 TEST 6: ALL SERVOS + MOTOR SMOOTH");
-    for (int i = 0; i <= 30; i += 5) {
-        moveAllServos(
-            map(i, 0, 30, L_ELEVATOR_NEUTRAL, L_ELEVATOR_MAX),
-            map(i, 0, 30, R_ELEVATOR_NEUTRAL, R_ELEVATOR_MAX),
-            map(i, 0, 30, L_RUDDER_NEUTRAL, L_RUDDER_MAX),
-            map(i, 0, 30, R_RUDDER_NEUTRAL, R_RUDDER_MAX),
-            map(i, 0, 30, L_AILERON_NEUTRAL, L_AILERON_MAX),
-            map(i, 0, 30, R_AILERON_NEUTRAL, R_AILERON_MAX),
-            map(i, 0, 30, L_FLAPS_NEUTRAL, L_FLAPS_MAX),
-            map(i, 0, 30, R_FLAPS_NEUTRAL, R_FLAPS_MAX),
-            i
-        );
-        delay(200);
-    }
-    delay(1000);
-    
-    // ФИНАЛ: Все обратно в нейтральное
-    Serial.println("🎯 FINAL: ALL SERVOS → NEUTRAL");
-    moveAllServos(L_ELEVATOR_NEUTRAL, R_ELEVATOR_NEUTRAL, 
-                  L_RUDDER_NEUTRAL, R_RUDDER_NEUTRAL,
-                  L_AILERON_NEUTRAL, R_AILERON_NEUTRAL,
-                  L_FLAPS_NEUTRAL, R_FLAPS_NEUTRAL, 
-                  0);
-    delay(TEST_DELAY_SHORT);
-    
-    Serial.println("✅ SIMULTANEOUS Tests COMPLETE - All servos moved together!");
-    isTesting = false;
-}
-
-void ServoManager::safeTestSequence() {
-    Serial.println("🧪 SAFE Servo Test Sequence");
-    Serial.println("🎯 Testing ONE servo at a time for power safety");
-    
-    isTesting = true;
-    
-    Serial.println("🎯 Testing ELEVATOR");
-    L_elevatorServo.testSequence();
-    delay(TEST_DELAY_LONG);
-    R_elevatorServo.testSequence();
-    delay(TEST_DELAY_LONG);
-    
-    Serial.println("🎯 Testing RUDDER");
-    L_rudderServo.testSequence();
-    delay(TEST_DELAY_LONG);
-    R_rudderServo.testSequence();
-    delay(TEST_DELAY_LONG);
-    
-    Serial.println("🎯 Testing AILERONS");
-    L_aileronServo.testSequence();
-    delay(TEST_DELAY_SHORT);
-    R_aileronServo.testSequence();
-    delay(TEST_DELAY_LONG);
-    
-    Serial.println("🎯 Testing FLAPS");
-    L_flapServo.testSequence();
-    delay(TEST_DELAY_LONG);
-    R_flapServo.testSequence();
-    delay(TEST_DELAY_LONG);
-    
-    Serial.println("🎯 Testing MOTOR (Safe Mode)");
-    Serial.println("⚠️  Motor test - SAFE RANGE ONLY");
-    
-    // Безопасный тест двигателя
-    motorServo.write(0);
-    delay(1000);
-    
-    for (int i = 0; i <= 30; i += 5) {
-        motorServo.write(i);
-        Serial.print("   Motor: ");
-        Serial.print(i);
-        Serial.println("/180");
-        delay(500);
-    }
+    // 5. BLHeli АКТИВАЦИЯ: максимум на 1 секунду
+    console.println("\n🎯 STEP 3: BLHeli activation sequence");
+    console.println("   Sending 2000μs (max) for 1 second...");
+    channels[CH_MOTOR].writeMicroseconds(MOTOR_FULL_PULSE);
+    Clock::delay(1000);
     
-    delay(1000);
+    // 6. Возвращаем STOP
+    console.println("   Sending 1000μs (stop)...");
+    channels[CH_MOTOR].writeMicroseconds(MOTOR_STOP_PULSE);
+    Clock::delay(1000);
     
-    for (int i = 30; i >= 0; i -= 5) {
-        motorServo.write(i);
-        delay(300);
-    }
+    // 7. Проверка работы
+    console.println("\n🎯 STEP 4: Testing ESC (1200μs = 10% power)...");
+    channels[CH_MOTOR].writeMicroseconds(MOTOR_PERCENT_US(20));
+    Clock::delay(500);
+    
+    console.println("   Returning to STOP (1000μs)...");
+    channels[CH_MOTOR].writeMicroseconds(MOTOR_STOP_PULSE);
+    Clock::delay(500);
     
-    motorServo.write(0);
-    delay(1000);
+    setMotorArmed(true);
+    firstMotorUpdate = true;
     
-    Serial.println("✅ Motor test completed safely");
+    console.println("\n✅ ESC ARMED and READY for BLHeli");
+#endif
+    console.println("✅ All servos READY");
+    #if STABILIZER_ENABLED
+        if (stabilizer.begin()) {
+            console.println("✅ IMU READY: stabilization available");
+        }
+    #endif
+    console.println("\n📝 Send 'h' for available commands");
     
-    Serial.println("✅ SAFE Tests COMPLETE");
-    isTesting = false;
+    // Сбрасываем флаг BLHeli активации (уже сделали в begin)
+    blheliFirstRun = false;
+    blheliActivationStart = 0;
+    blheliActivationStep = 0;
 }
 
-void ServoManager::testSequence() {
-    simultaneousTestSequence();
-}
+// ============================================================================
+// ПОСЛЕДОВАТЕЛЬНОСТИ: КАЛИБРОВКА ESC, ВООРУЖЕНИЕ, ТЕСТЫ
+// ============================================================================
+//
+// Бывшие блокирующие функции с delay() - теперь таблицы шагов (Sequence.h).
+// Их продвигает advanceSequence() из тика управления. Любая клавиша вне
+// запроса или 'x' отменяет последовательность, ожидание ответа ограничено таймаутом.
 
-void ServoManager::applyDeadZone(int16_t& axisValue, int deadZone) {
-    if (abs(axisValue) < deadZone) {
-        axisValue = 0;
-    }
-}
+#define SEQUENCE_KEY_TIMEOUT_MS  30000
+
+// Диапазон ESC запоминает по сигналам при подключении батареи: прерванная на
+// середине калибровка оставит ESC с неверным диапазоном. Ее запускают только
+// с консоли на стенде, поэтому failsafe ее не прерывает (keepOnFailsafe).
+// Остальное, что крутит мотор, при потере связи отменяется
+
+#if MOTOR_DSHOT
+// DShot: значение газа цифровое, диапазон ESC калибровать не нужно
+static const SequenceStep CALIBRATE_ESC_STEPS[] = {
+    {SEQ_PRINT, 0, 0, 0, 0, "\n🎛️ DShot ESC: throttle range is digital, calibration is not needed"},
+    {SEQ_END, 0, 0, 0, 0, nullptr},
+};
+static const Sequence CALIBRATE_ESC = {"ESC calibration", CALIBRATE_ESC_STEPS, false, nullptr, true};
+#elif AIRFRAME_ESC_REVERSIBLE
+// ESC газ/тормоз: нейтраль, полный газ, полный тормоз - обычная процедура машинных ESC
+static const SequenceStep CALIBRATE_ESC_STEPS[] = {
+    {SEQ_CONFIRM, SEQUENCE_KEY_TIMEOUT_MS, 0, 0, 0,
+        "\n🎛️ ESC CALIBRATION MODE (throttle/brake)\n⚠️  ⚠️  ⚠️  WARNING: WHEELS OFF THE GROUND! ⚠️  ⚠️  ⚠️\n"
+        "\n📋 Procedure:\n1. Disconnect battery from ESC\n2. Send 'y' to start calibration\n3. Follow instructions"},
+    {SEQ_MOTOR, MOTOR_STOP_US, 0, 0, 0, nullptr},
+    {SEQ_WAIT_KEY, SEQUENCE_KEY_TIMEOUT_MS, 0, 0, 0,
+        "\n🎯 STEP 1: Sending NEUTRAL\n   Connect battery and enter ESC calibration (SET button)\n   Press any key when the ESC is waiting for neutral..."},
+    {SEQ_MOTOR, MOTOR_STOP_US, 0, 0, 4000, "\n🎯 STEP 2: NEUTRAL - wait for confirmation (beep/LED)"},
+    {SEQ_MOTOR, MOTOR_FULL_US, 0, 0, 4000, "\n🎯 STEP 3: FULL THROTTLE - wait for confirmation"},
+    {SEQ_MOTOR, MOTOR_REVERSE_US, 0, 0, 4000, "\n🎯 STEP 4: FULL BRAKE - wait for confirmation"},
+    {SEQ_MOTOR, MOTOR_STOP_US, 0, 0, 1000, "   Returning to NEUTRAL"},
+    {SEQ_ARM, 0, 0, 0, 0, "\n✅ Calibration complete!"},
+    {SEQ_END, 0, 0, 0, 0, "✅ ESC calibrated and ready!"},
+};
+static const Sequence CALIBRATE_ESC = {"ESC calibration", CALIBRATE_ESC_STEPS, false, nullptr, true};
+#else
+static const SequenceStep CALIBRATE_ESC_STEPS[] = {
+    {SEQ_CONFIRM, SEQUENCE_KEY_TIMEOUT_MS, 0, 0, 0,
+        "\n🎛️ ESC CALIBRATION MODE\n⚠️  ⚠️  ⚠️  WARNING: REMOVE PROPELLER! ⚠️  ⚠️  ⚠️\n"
+        "\n📋 Procedure:\n1. Disconnect battery from ESC\n2. Send 'y' to start calibration\n3. Follow instructions"},
+    {SEQ_WAIT_KEY, SEQUENCE_KEY_TIMEOUT_MS, 0, 0, 0,
+        "\n🔧 Starting calibration...\n\n🎯 STEP 1: Disconnect battery from ESC\n"
+        "   Ensure battery is DISCONNECTED\n   Press any key when ready..."},
+    {SEQ_MOTOR, MOTOR_FULL_US, 0, 0, 8000,
+        "\n🎯 STEP 2: Sending MAX signal (2000μs)\n⚠️  NOW: Connect battery to ESC!\n   Wait for beeps (2-3 beeps)"},
+    {SEQ_MOTOR, MOTOR_STOP_US, 0, 0, 8000,
+        "\n🎯 STEP 3: Sending MIN signal (1000μs)\n   Wait for confirmation beeps (1 long beep)"},
+    {SEQ_ARM, 0, 0, 0, 0,
+        "\n✅ Calibration complete!\n✅ ESC is now calibrated to 1000-2000μs range"},
+    {SEQ_END, 0, 0, 0, 0, nullptr},
+};
+// Проверка на 50% - уже не калибровка: при потере связи прерывается как любой тест
+static const SequenceStep CALIBRATION_CHECK_STEPS[] = {
+    {SEQ_MOTOR, MOTOR_PERCENT_US(50), 0, 0, 3000, "\n🔧 Testing calibration...\n   Sending 50% power"},
+    {SEQ_MOTOR, MOTOR_STOP_US, 0, 0, 1000, "   Returning to STOP"},
+    {SEQ_END, 0, 0, 0, 0, "✅ ESC calibrated and ready!"},
+};
+static const Sequence CALIBRATION_CHECK = {"ESC calibration check", CALIBRATION_CHECK_STEPS, false, nullptr, false};
+static const Sequence CALIBRATE_ESC = {"ESC calibration", CALIBRATE_ESC_STEPS, false, &CALIBRATION_CHECK, true};
+#endif
+
+static const SequenceStep SAFE_START_STEPS[] = {
+    {SEQ_CONFIRM, 10000, 0, 0, 0,
+        "\n🔒 SAFE START SEQUENCE\n📋 Follow these steps:\n"
+        "\n1. ⚠️  PROPELLER REMOVED / WHEELS OFF THE GROUND?\n   Type 'y' to confirm or any key to cancel"},
+    {SEQ_CONFIRM, SEQUENCE_KEY_TIMEOUT_MS, 0, 0, 0,
+        "\n2. 🔋 Disconnect battery from ESC\n   Type 'y' when battery is disconnected"},
+    {SEQ_MOTOR, MOTOR_STOP_US, 0, 0, 1000, "\n3. 🔧 Initializing ESC..."},
+    {SEQ_PRINT, 0, 0, 0, 5000, "\n4. 🔋 NOW: Connect battery to ESC\n   Wait for beeps..."},
+    {SEQ_MOTOR, MOTOR_PERCENT_US(20), 0, 0, 2000, "\n5. 🎯 Testing ESC...\n   Sending 20% power"},
+    {SEQ_MOTOR, MOTOR_STOP_US, 0, 0, 1000, "   Sending STOP"},
+    {SEQ_ARM, 0, 0, 0, 0, nullptr},
+    {SEQ_END, 0, 0, 0, 0, "\n✅ SAFE START COMPLETE\n✅ ESC armed and ready"},
+};
+static const Sequence SAFE_START = {"Safe start", SAFE_START_STEPS, false, nullptr, false};
 
-void ServoManager::updateAilerons(int rollValue) {
-    int leftAileronAngle = map(rollValue, -512, 512, L_AILERON_MAX, L_AILERON_MIN);
-    int rightAileronAngle = map(rollValue, -512, 512, R_AILERON_MIN, R_AILERON_MAX);
+static const SequenceStep ESC_TEST_SIMPLE_STEPS[] = {
+    {SEQ_PRINT, 0, 0, 0, 0, "🎯 SIMPLE ESC TEST (using microseconds)"},
+    {SEQ_SKIP_IF_ARMED, 2, 0, 0, 0, nullptr},
+    {SEQ_MOTOR, MOTOR_STOP_US, 0, 0, 2000, "⚠️  Arming ESC first..."},
+    {SEQ_ARM, 0, 0, 0, 0, nullptr},
+    {SEQ_MOTOR_RAMP, MOTOR_STOP_US, MOTOR_FULL_US, MOTOR_PERCENT_US(10) - MOTOR_STOP_US, 2000,
+        "🎯 STOP → 100%, 10% per step, 2 s per step"},
+    {SEQ_MOTOR, MOTOR_STOP_US, 0, 0, 0, nullptr},
+    {SEQ_END, 0, 0, 0, 0, "✅ Test complete - ESC STOPPED"},
+};
+static const Sequence ESC_TEST_SIMPLE = {"Simple ESC test", ESC_TEST_SIMPLE_STEPS, false, nullptr, false};
+
+static const SequenceStep MOTOR_DIRECT_STEPS[] = {
+    {SEQ_ARM, 0, 0, 0, 0, "🔧 DIRECT MOTOR TEST (using microseconds)"},
+    {SEQ_MOTOR_RAMP, MOTOR_STOP_US, MOTOR_PERCENT_US(50), MOTOR_PERCENT_US(1) - MOTOR_STOP_US, 100,
+        "⚡ Smooth acceleration 0-50%..."},
+    {SEQ_PRINT, 0, 0, 0, 2000, nullptr},
+    {SEQ_MOTOR_RAMP, MOTOR_PERCENT_US(50), MOTOR_STOP_US, MOTOR_PERCENT_US(1) - MOTOR_STOP_US, 100,
+        "⚡ Smooth deceleration 50-0%..."},
+    {SEQ_END, 0, 0, 0, 0, "✅ Direct motor test complete"},
+};
+static const Sequence MOTOR_DIRECT = {"Direct motor test", MOTOR_DIRECT_STEPS, false, nullptr, false};
+
+static const SequenceStep MOTOR_SET_STEPS[] = {
+    {SEQ_SKIP_IF_ARMED, 2, 0, 0, 0, nullptr},
+    {SEQ_MOTOR, MOTOR_STOP_US, 0, 0, 2000, "⚠️  Arming motor first..."},
+    {SEQ_ARM, 0, 0, 0, 0, nullptr},
+    {SEQ_MOTOR_PENDING, 0, 0, 0, 0, nullptr},
+    {SEQ_END, 0, 0, 0, 0, nullptr},
+};
+static const Sequence MOTOR_SET = {"Motor set", MOTOR_SET_STEPS, false, nullptr, false};
+
+#if MOTOR_DSHOT
+// DShot: поток кадров "стоп", затем короткий сигнал ESC - вооружен
+static const SequenceStep BLHELI_ARMING_STEPS[] = {
+    {SEQ_MOTOR, MOTOR_STOP_US, 0, 0, DSHOT_ARM_MS,
+        "🔐 ESC ARMING (DShot)\n   Connect battery to ESC, sending STOP frames..."},
+    {SEQ_ARM, 0, 0, 0, 0, nullptr},
+    {SEQ_ESC_COMMAND, DSHOT_CMD_BEEP1, 1, 0, DSHOT_BEEP_GAP_MS, nullptr},
+    {SEQ_END, 0, 0, 0, 0, "\n✅ ESC ARMED (DShot)"},
+};
+static const Sequence BLHELI_ARMING = {"ESC arming", BLHELI_ARMING_STEPS, false, nullptr, false};
+#elif AIRFRAME_ESC_REVERSIBLE
+// ESC газ/тормоз вооружается нейтралью (команда 'b' на машине)
+static const SequenceStep BLHELI_ARMING_STEPS[] = {
+    {SEQ_MOTOR, MOTOR_STOP_US, 0, 0, ESC_NEUTRAL_ARM_MS,
+        "🔐 ESC ARMING (throttle/brake)\n   Connect battery to ESC, holding NEUTRAL..."},
+    {SEQ_ARM, 0, 0, 0, 0, nullptr},
+    {SEQ_END, 0, 0, 0, 0, "\n✅ ESC ARMED (neutral)"},
+};
+static const Sequence BLHELI_ARMING = {"ESC arming", BLHELI_ARMING_STEPS, false, nullptr, false};
+#else
+static const SequenceStep BLHELI_ARMING_STEPS[] = {
+    {SEQ_WAIT_KEY, SEQUENCE_KEY_TIMEOUT_MS, 0, 0, 0,
+        "🔐 BLHeli ARMING SEQUENCE\n⚠️  This is REQUIRED for BLHeli ESCs\n"
+        "\n1. Disconnect battery from ESC\n   Press any key when ready..."},
+    {SEQ_MOTOR, MOTOR_STOP_US, 0, 0, 100, "\n2. Sending 1000μs (min)"},
+    {SEQ_PRINT, 0, 0, 0, 5000, "\n3. ⚡ NOW: Connect battery to ESC!\n   Wait for 3 beeps (cell count)..."},
+    {SEQ_MOTOR, MOTOR_STOP_US, 0, 0, 2000, "\n4. BLHeli arming sequence:\n   a. 1000μs for 2 seconds"},
+    {SEQ_MOTOR, MOTOR_FULL_US, 0, 0, 1000, "   b. 2000μs for 1 second"},
+    {SEQ_MOTOR, MOTOR_STOP_US, 0, 0, 1000, "   c. 1000μs (armed)"},
+    {SEQ_MOTOR, MOTOR_PERCENT_US(20), 0, 0, 2000, "\n5. Testing...\n   Sending 1200μs (20%)"},
+    {SEQ_MOTOR, MOTOR_STOP_US, 0, 0, 1000, "   Sending 1000μs (stop)"},
+    {SEQ_ARM, 0, 0, 0, 0, nullptr},
+    {SEQ_END, 0, 0, 0, 0, "\n✅ BLHeli ESC ARMED and READY!"},
+};
+static const Sequence BLHELI_ARMING = {"BLHeli arming", BLHELI_ARMING_STEPS, false, nullptr, false};
+#endif
+
+// Тоны ESC по возрастанию - найти модель или проверить связь с ESC без вращения.
+// Мотор в это время на стопе: ESC выполняет команды только без газа
+static const SequenceStep ESC_BEEP_STEPS[] = {
+    {SEQ_MOTOR, MOTOR_STOP_US, 0, 0, DSHOT_BEEP_GAP_MS, "🔊 ESC beep (DShot)"},
+    {SEQ_ESC_COMMAND, DSHOT_CMD_BEEP1, 1, 0, DSHOT_BEEP_GAP_MS, nullptr},
+    {SEQ_ESC_COMMAND, DSHOT_CMD_BEEP1 + 1, 1, 0, DSHOT_BEEP_GAP_MS, nullptr},
+    {SEQ_ESC_COMMAND, DSHOT_CMD_BEEP1 + 2, 1, 0, DSHOT_BEEP_GAP_MS, nullptr},
+    {SEQ_ESC_COMMAND, DSHOT_CMD_BEEP1 + 3, 1, 0, DSHOT_BEEP_GAP_MS, nullptr},
+    {SEQ_ESC_COMMAND, DSHOT_CMD_BEEP5, 1, 0, DSHOT_BEEP_GAP_MS, nullptr},
+    {SEQ_END, 0, 0, 0, 0, nullptr},
+};
+static const Sequence ESC_BEEP = {"ESC beep", ESC_BEEP_STEPS, false, nullptr, false};
+
+// Мотор отдельно, затем все поверхности одновременно
+static const SequenceStep SIMULTANEOUS_TEST_STEPS[] = {
+    {SEQ_PRINT, 0, 0, 0, 0,
+        "🧪 SIMULTANEOUS Servo Test Sequence\n🎯 ALL servos moving TOGETHER at the same time!\n"
+        "⚠️  MOTOR LIMITED TO 33% FOR SAFETY TESTING\n🔧 Testing MOTOR separately first...\n"
+        "🎯 MOTOR Test Sequence\n⚠️  WARNING: PROPELLER REMOVED?"},
+    {SEQ_SKIP_IF_ARMED, 2, 0, 0, 0, nullptr},
+    {SEQ_MOTOR, MOTOR_STOP_US, 0, 0, 2000, "❌ Motor NOT armed - arming now..."},
+    {SEQ_ARM, 0, 0, 0, 0, nullptr},
+    {SEQ_MOTOR, MOTOR_STOP_US, 0, 0, 2000, "🎯 TEST 1: Motor NEUTRAL (0%)"},
+    {SEQ_MOTOR_RAMP, MOTOR_STOP_US, MOTOR_ANGLE_US(45), MOTOR_ANGLE_STEP_US, 500, "🎯 TEST 2: Motor 25% power"},
+    {SEQ_PRINT, 0, 0, 0, 2000, nullptr},
+    {SEQ_MOTOR_RAMP, MOTOR_ANGLE_US(45), MOTOR_ANGLE_US(90), MOTOR_ANGLE_STEP_US, 300, "🎯 TEST 3: Motor 50% power"},
+    {SEQ_PRINT, 0, 0, 0, 2000, nullptr},
+    {SEQ_MOTOR_RAMP, MOTOR_ANGLE_US(90), MOTOR_ANGLE_US(18), MOTOR_ANGLE_STEP_US, 300, "🎯 TEST 4: Motor 10% power"},
+    {SEQ_PRINT, 0, 0, 0, 2000, nullptr},
+    {SEQ_MOTOR, MOTOR_STOP_US, 0, 0, 2000, "🎯 TEST 5: Motor NEUTRAL"},
+    {SEQ_POSE, POSE_NEUTRAL, MOTOR_STOP_US, 0, TEST_DELAY_LONG, "✅ Motor test COMPLETE\n🎯 TEST 1: ALL SERVOS → NEUTRAL"},
+    {SEQ_POSE, POSE_MIN, MOTOR_STOP_US, 0, TEST_DELAY_LONG, "🎯 TEST 2: ALL SERVOS → MINIMUM"},
+    {SEQ_POSE, POSE_MAX, MOTOR_ANGLE_US(30), 0, TEST_DELAY_LONG, "🎯 TEST 3: ALL SERVOS → MAXIMUM"},
+    {SEQ_POSE, POSE_AILERONS_SPLIT, MOTOR_ANGLE_US(20), 0, TEST_DELAY_SHORT, "🎯 TEST 4: AILERONS ANTI-PHASE"},
+    {SEQ_POSE, POSE_RUDDER_FLAPS, MOTOR_ANGLE_US(25), 0, TEST_DELAY_SHORT, "🎯 TEST 5: RUDDER + FLAPS"},
+    {SEQ_POSE_RAMP, POSE_MAX, MOTOR_ANGLE_US(30), 17, 200, "🎯 TEST 6: ALL SERVOS + MOTOR SMOOTH"},
+    {SEQ_PRINT, 0, 0, 0, 1000, nullptr},
+    {SEQ_POSE, POSE_NEUTRAL, MOTOR_STOP_US, 0, TEST_DELAY_SHORT, "🎯 FINAL: ALL SERVOS → NEUTRAL"},
+    {SEQ_END, 0, 0, 0, 0, "✅ SIMULTANEOUS Tests COMPLETE - All servos moved together!"},
+};
+static const Sequence SIMULTANEOUS_TEST = {"Simultaneous test", SIMULTANEOUS_TEST_STEPS, true, nullptr, false};
+
+static const SequenceStep MANUAL_TEST_STEPS[] = {
+    {SEQ_CONFIRM, 5000, 0, 0, 0,
+        "🧪 MANUAL TEST SEQUENCE\n⚠️  WARNING: Ensure propeller is removed!\nSend 'y' to confirm or any key to cancel..."},
+    {SEQ_END, 0, 0, 0, 0, "✅ Starting full test sequence..."},
+};
+static const Sequence MANUAL_TEST = {"Manual test", MANUAL_TEST_STEPS, false, &SIMULTANEOUS_TEST, false};
+
+// По одной поверхности: минимум, максимум, нейтраль
+#define SURFACE_TEST_STEPS(surface, delayMs, message) \
+    {SEQ_SURFACE, surface, POSE_MIN, 0, 500, message}, \
+    {SEQ_SURFACE, surface, POSE_MAX, 0, 500, nullptr}, \
+    {SEQ_SURFACE, surface, POSE_NEUTRAL, 0, delayMs, nullptr}
+
+static const SequenceStep SAFE_TEST_STEPS[] = {
+    {SEQ_PRINT, 0, 0, 0, 0, "🧪 SAFE Servo Test Sequence\n🎯 Testing ONE servo at a time for power safety"},
+#if AIRFRAME_PROFILE == AIRFRAME_CAR
+    SURFACE_TEST_STEPS(ServoManager::CH_STEERING, TEST_DELAY_LONG, "🎯 Testing STEERING"),
+#else
+    SURFACE_TEST_STEPS(ServoManager::CH_L_ELEVATOR, TEST_DELAY_LONG, "🎯 Testing ELEVATOR"),
+    SURFACE_TEST_STEPS(ServoManager::CH_R_ELEVATOR, TEST_DELAY_LONG, nullptr),
+    SURFACE_TEST_STEPS(ServoManager::CH_L_RUDDER, TEST_DELAY_LONG, "🎯 Testing RUDDER"),
+    SURFACE_TEST_STEPS(ServoManager::CH_R_RUDDER, TEST_DELAY_LONG, nullptr),
+    SURFACE_TEST_STEPS(ServoManager::CH_L_AILERON, TEST_DELAY_SHORT, "🎯 Testing AILERONS"),
+    SURFACE_TEST_STEPS(ServoManager::CH_R_AILERON, TEST_DELAY_LONG, nullptr),
+    SURFACE_TEST_STEPS(ServoManager::CH_L_FLAPS, TEST_DELAY_LONG, "🎯 Testing FLAPS"),
+    SURFACE_TEST_STEPS(ServoManager::CH_R_FLAPS, TEST_DELAY_LONG, nullptr),
+#endif
+    {SEQ_MOTOR, MOTOR_STOP_US, 0, 0, 1000, "🎯 Testing MOTOR (Safe Mode)\n⚠️  Motor test - SAFE RANGE ONLY"},
+    {SEQ_MOTOR_RAMP, MOTOR_STOP_US, MOTOR_ANGLE_US(30), MOTOR_ANGLE_STEP_US, 500, nullptr},
+    {SEQ_PRINT, 0, 0, 0, 1000, nullptr},
+    {SEQ_MOTOR_RAMP, MOTOR_ANGLE_US(30), MOTOR_STOP_US, MOTOR_ANGLE_STEP_US, 300, nullptr},
+    {SEQ_MOTOR, MOTOR_STOP_US, 0, 0, 1000, nullptr},
+    {SEQ_END, 0, 0, 0, 0, "✅ Motor test completed safely\n✅ SAFE Tests COMPLETE"},
+};
+static const Sequence SAFE_TEST = {"Safe test", SAFE_TEST_STEPS, true, nullptr, false};
+
+void ServoManager::runManualTests() { startSequence(MANUAL_TEST); }
+void ServoManager::calibrateESC() { startSequence(CALIBRATE_ESC); }
+void ServoManager::safeStartSequence() { startSequence(SAFE_START); }
+void ServoManager::escTestSimple() { startSequence(ESC_TEST_SIMPLE); }
+void ServoManager::simultaneousTestSequence() { startSequence(SIMULTANEOUS_TEST); }
+void ServoManager::safeTestSequence() { startSequence(SAFE_TEST); }
+void ServoManager::testSequence() { startSequence(SIMULTANEOUS_TEST); }
+void ServoManager::testMotorDirect() { startSequence(MOTOR_DIRECT); }
+void ServoManager::blheliArmingSequence() { startSequence(BLHELI_ARMING); }
+void ServoManager::escBeepSequence() { startSequence(ESC_BEEP); }
+
+void ServoManager::directMotorTest(int powerPercent) {
+    // Преобразуем проценты в микросекунды
+    int us = map(powerPercent, 0, 100, MOTOR_STOP_PULSE, MOTOR_FULL_PULSE);
+    us = constrain(us, MOTOR_STOP_PULSE, MOTOR_FULL_PULSE);
     
-    L_aileronServo.write(leftAileronAngle);
-    R_aileronServo.write(rightAileronAngle);
+    console.print("🔧 Direct motor test: ");
+    console.print(powerPercent);
+    console.print("% = ");
+    console.print(us);
+    console.println("μs");
+    
+    pendingMotorUs = us;
+    startSequence(MOTOR_SET);
 }
 
-void ServoManager::updateAileronsSmooth(int rollValue) {
-    int L_aileronAngle = map(rollValue, -512, 512, L_AILERON_MAX, L_AILERON_MIN);
-    int R_aileronAngle = map(rollValue, -512, 512, R_AILERON_MIN, R_AILERON_MAX);
-    
-    L_aileronServo.writeSmooth(L_aileronAngle, SERVO_SPEED_FAST);
-    R_aileronServo.writeSmooth(R_aileronAngle, SERVO_SPEED_FAST);
+void ServoGroup::writeMicroseconds(int us) {
+    servo.writeMicroseconds(us);
 }
 
-void ServoManager::updateFlaps(int flapsValue) {
-    int L_flapsAngle, R_flapsAngle;
-    
-    if (flapsValue < -300) {
-        L_flapsAngle = L_FLAPS_MIN;
-        R_flapsAngle = R_FLAPS_MIN;
-    } else if (flapsValue > 300) {
-        L_flapsAngle = L_FLAPS_MAX;
-        R_flapsAngle = R_FLAPS_MAX;
-    } else {
-        L_flapsAngle = L_FLAPS_NEUTRAL;
-        R_flapsAngle = R_FLAPS_NEUTRAL;
+void ServoManager::startSequence(const Sequence& sequence) {
+    if (activeSequence != nullptr) {
+        LOG_EVENT_TEXT(LOG_SEQUENCE_BUSY, activeSequence->name);
+        return;
     }
     
-    L_flapServo.write(L_flapsAngle);
-    R_flapServo.write(R_flapsAngle);
+    activeSequence = &sequence;
+    pendingKey = -1;
+    enterStep(0);
 }
 
-void ServoManager::updateFlapsSmooth(int flapsValue) {
-    int L_flapsAngle, R_flapsAngle;
-    
-    if (flapsValue < -300) {
-        L_flapsAngle = L_FLAPS_MIN;
-        R_flapsAngle = R_FLAPS_MIN;
-    } else if (flapsValue > 300) {
-        L_flapsAngle = L_FLAPS_MAX;
-        R_flapsAngle = R_FLAPS_MAX;
-    } else {
-        L_flapsAngle = L_FLAPS_NEUTRAL;
-        R_flapsAngle = R_FLAPS_NEUTRAL;
+void ServoManager::cancelSequence(const char* reason) {
+    if (activeSequence == nullptr) {
+        return;
     }
     
-    L_flapServo.writeSmooth(L_flapsAngle, SERVO_SPEED_SLOW);
-    R_flapServo.writeSmooth(R_flapsAngle, SERVO_SPEED_SLOW);
+    channels[CH_MOTOR].writeMicroseconds(MOTOR_STOP_PULSE);
+    LOG_EVENT_TEXT(LOG_SEQUENCE_ABORTED, reason);
+    activeSequence = nullptr;
 }
 
-void ServoManager::testMotorDirect() {
-    Serial.println("🔧 DIRECT MOTOR TEST (using microseconds)");
-    
-    // Принудительно вооружаем двигатель
-    motorArmed = true;
-    firstMotorUpdate = false;
-    
-    // Плавный разгон как в работающем тесте
-    Serial.println("⚡ Smooth acceleration 1000-1500μs...");
-    for (int us = 1000; us <= 1500; us += 10) {
-        motorServo.writeMicroseconds(us);
-        Serial.print("  Setting: ");
-        Serial.print(us);
-        Serial.println("μs");
-        delay(100);
+bool ServoManager::handleKey(char key) {
+    if (activeSequence == nullptr) {
+        return false;
     }
     
-    delay(2000);
+    const uint8_t action = activeSequence->steps[sequenceStep].action;
+    if (action == SEQ_CONFIRM || action == SEQ_WAIT_KEY) {
+        pendingKey = key;
+    } else {
+        cancelSequence("🛑 Cancelled by key");
+    }
+    return true;
+}
+
+void ServoManager::enterStep(uint8_t index) {
+    sequenceStep = index;
+    stepStartMs = Clock::millis();
     
-    // Плавное торможение
-    Serial.println("⚡ Smooth deceleration 1500-1000μs...");
-    for (int us = 1500; us >= 1000; us -= 10) {
-        motorServo.writeMicroseconds(us);
-        delay(100);
+    const SequenceStep& step = activeSequence->steps[index];
+    if (step.message != nullptr) {
+        LOG_EVENT_TEXT(LOG_TEXT, step.message);
     }
     
-    Serial.println("✅ Direct motor test complete");
+    switch (step.action) {
+        case SEQ_CONFIRM:
+        case SEQ_WAIT_KEY:
+            pendingKey = -1;  // Ответом считается только клавиша после запроса
+            break;
+        case SEQ_SKIP_IF_ARMED:
+            if (motorArmed) {
+                sequenceStep += step.value;
+            }
+            break;
+        case SEQ_MOTOR:
+            channels[CH_MOTOR].writeMicroseconds(step.value);
+            break;
+        case SEQ_MOTOR_RAMP:
+            rampValue = step.value;
+            channels[CH_MOTOR].writeMicroseconds(rampValue);
+            break;
+        case SEQ_MOTOR_PENDING:
+            channels[CH_MOTOR].writeMicroseconds(pendingMotorUs);
+            break;
+        case SEQ_POSE:
+            applyPose(step.value, 100, step.target);
+            break;
+        case SEQ_POSE_RAMP:
+            rampValue = 0;
+            applyPose(step.value, 0, MOTOR_STOP_PULSE);
+            break;
+        case SEQ_SURFACE:
+            channels[step.value].stageMicroseconds(posePulse(step.value, step.target, 100));
+            PwmBank::commit();
+            break;
+        case SEQ_ARM:
+            if (activeSequence == &CALIBRATE_ESC) {
+                escCalibrated = true;
+            }
+            setMotorArmed(true);
+            firstMotorUpdate = true;
+            break;
+        case SEQ_ESC_COMMAND:
+            channels[CH_MOTOR].sendEscCommand((uint8_t)step.value, (uint8_t)step.target);
+            break;
+        case SEQ_END: {
+            const Sequence* next = activeSequence->next;
+            activeSequence = nullptr;
+            if (next != nullptr) {
+                startSequence(*next);
+            }
+            break;
+        }
+        default:
+            break;
+    }
 }
 
-void ServoManager::directMotorTest(int powerPercent) {
-    if (!motorArmed) {
-        Serial.println("⚠️  Arming motor first...");
-        motorServo.writeMicroseconds(1000);  // STOP
-        delay(2000);
-        motorArmed = true;
+void ServoManager::advanceSequence() {
+    if (activeSequence == nullptr) {
+        return;
     }
     
-    // Преобразуем проценты в микросекунды
-    int us = map(powerPercent, 0, 100, 1000, 2000);
-    us = constrain(us, 1000, 2000);
-    
-    Serial.print("🔧 Direct motor test: ");
-    Serial.print(powerPercent);
-    Serial.print("% = ");
-    Serial.print(us);
-    Serial.println("μs");
-    
-    motorServo.writeMicroseconds(us);
+    const SequenceStep& step = activeSequence->steps[sequenceStep];
+    const uint32_t elapsed = Clock::millis() - stepStartMs;
+    
+    switch (step.action) {
+        case SEQ_CONFIRM:
+        case SEQ_WAIT_KEY:
+            if (pendingKey >= 0) {
+                const char key = (char)pendingKey;
+                pendingKey = -1;
+                if (step.action == SEQ_CONFIRM && key != 'y' && key != 'Y') {
+                    cancelSequence("❌ Cancelled");
+                    return;
+                }
+                enterStep(sequenceStep + 1);
+            } else if (elapsed >= (uint32_t)step.value) {
+                cancelSequence("⏰ Timeout");
+            }
+            return;
+            
+        case SEQ_MOTOR_RAMP:
+            if (elapsed < step.holdMs) {
+                return;
+            }
+            if (rampValue == step.target) {
+                enterStep(sequenceStep + 1);
+                return;
+            }
+            // Следующая точка рампы без перелета через цель
+            if (step.target > rampValue) {
+                rampValue = min(rampValue + step.increment, (int)step.target);
+            } else {
+                rampValue = max(rampValue - step.increment, (int)step.target);
+            }
+            channels[CH_MOTOR].writeMicroseconds(rampValue);
+            LOG_EVENT(LOG_SEQUENCE_MOTOR, rampValue);
+            stepStartMs = Clock::millis();
+            return;
+            
+        case SEQ_POSE_RAMP:
+            if (elapsed < step.holdMs) {
+                return;
+            }
+            if (rampValue >= 100) {
+                enterStep(sequenceStep + 1);
+                return;
+            }
+            rampValue = min(rampValue + step.increment, 100);
+            applyPose(step.value, rampValue, MOTOR_STOP_PULSE + (step.target - MOTOR_STOP_PULSE) * rampValue / 100);
+            stepStartMs = Clock::millis();
+            return;
+            
+        default:
+            if (elapsed >= step.holdMs) {
+                enterStep(sequenceStep + 1);
+            }
+            return;
+    }
 }
 
-void ServoGroup::writeMicroseconds(int us) {
-    servo.writeMicroseconds(us);
+int ServoManager::posePulse(uint8_t surface, uint8_t pose, int percent) {
+    // Поза профиля: -1 минимум, 0 нейтраль, 1 максимум
+    const OutputSpec& output = OUTPUTS[surface];
+    const int8_t direction = pose < POSE_COUNT ? POSES[pose][surface] : 0;
+    const int target = direction > 0 ? output.maxUs : (direction < 0 ? output.minUs : output.neutralUs);
+    return output.neutralUs + (target - output.neutralUs) * percent / 100;
 }
 
-void ServoManager::blheliArmingSequence() {
-    Serial.println("🔐 BLHeli ARMING SEQUENCE");
-    Serial.println("⚠️  This is REQUIRED for BLHeli ESCs");
-    
-    // 1. Убедитесь, что батарея отключена
-    Serial.println("\n1. Disconnect battery from ESC");
-    Serial.println("   Press any key when ready...");
-    while(!Serial.available());
-    Serial.read();
-    
-    // 2. Инициализация ESC
-    motorServo.begin();
-    delay(100);
-    
-    // 3. Отправляем минимальный сигнал
-    Serial.println("\n2. Sending 1000μs (min)");
-    motorServo.writeMicroseconds(1000);
-    delay(100);
-    
-    // 4. Подключаем батарею
-    Serial.println("\n3. ⚡ NOW: Connect battery to ESC!");
-    Serial.println("   Wait for 3 beeps (cell count)...");
-    delay(5000);
-    
-    // 5. Специальная последовательность для BLHeli
-    Serial.println("\n4. BLHeli arming sequence:");
-    
-    // 5a. Минимум 2 секунды
-    Serial.println("   a. 1000μs for 2 seconds");
-    motorServo.writeMicroseconds(1000);
-    delay(2000);
-    
-    // 5b. Максимум 1 секунда
-    Serial.println("   b. 2000μs for 1 second");
-    motorServo.writeMicroseconds(2000);
-    delay(1000);
-    
-    // 5c. Возврат к минимуму
-    Serial.println("   c. 1000μs (armed)");
-    motorServo.writeMicroseconds(1000);
-    delay(1000);
-    
-    // 6. Проверка
-    Serial.println("\n5. Testing...");
-    Serial.println("   Sending 1200μs (10%)");
-    motorServo.writeMicroseconds(1200);
-    delay(2000);
-    
-    Serial.println("   Sending 1000μs (stop)");
-    motorServo.writeMicroseconds(1000);
-    delay(1000);
-    
-    motorArmed = true;
-    firstMotorUpdate = true;
+void ServoManager::applyPose(uint8_t pose, int percent, int motorUs) {
+    for (uint8_t i = 0; i < SURFACE_COUNT; i++) {
+        channels[i].stageMicroseconds(posePulse(i, pose, percent));
+    }
     
-    Serial.println("\n✅ BLHeli ESC ARMED and READY!");
+    // Двигатель - безопасное ограничение для тестов
+    const int safeMotor = constrain(motorUs, MOTOR_STOP_PULSE, MOTOR_TEST_MAX_PULSE);
+    channels[CH_MOTOR].stageMicroseconds(safeMotor);
+    PwmBank::commit();
+    
+    LOG_EVENT(LOG_SEQUENCE_MOTOR, safeMotor);
 }
 
 void ServoManager::update(const ControlData& data) {
     // 🔥 BLHeli АКТИВАЦИЯ - ТОЛЬКО ПЕРВЫЙ РАЗ (без блокировки)
-    static bool blheliFirstRun = true;
-    static unsigned long blheliActivationStart = 0;
-    static int blheliActivationStep = 0;
-    
-    if (blheliFirstRun && motorArmed) {
+    // Во время калибровки/теста мотором управляет последовательность
+    if (blheliFirstRun && motorArmed && activeSequence == nullptr) {
         if (blheliActivationStep == 0) {
-            Serial.println("\n⚡ BLHeli ACTIVATION: Starting in update()");
-            Serial.println("   Sending 2000μs for 1 second...");
-            motorServo.writeMicroseconds(2000);
-            blheliActivationStart = millis();
+            LOG_EVENT(LOG_BLHELI_START);
+            channels[CH_MOTOR].writeMicroseconds(MOTOR_FULL_PULSE);
+            blheliActivationStart = Clock::millis();
             blheliActivationStep = 1;
         } 
-        else if (blheliActivationStep == 1 && millis() - blheliActivationStart > 1000) {
-            Serial.println("   Sending 1000μs (armed)...");
-            motorServo.writeMicroseconds(1000);
-            blheliActivationStart = millis();
+        else if (blheliActivationStep == 1 && Clock::millis() - blheliActivationStart > 1000) {
+            LOG_EVENT(LOG_BLHELI_ARMED);
+            channels[CH_MOTOR].writeMicroseconds(MOTOR_STOP_PULSE);
+            blheliActivationStart = Clock::millis();
             blheliActivationStep = 2;
         }
-        else if (blheliActivationStep == 2 && millis() - blheliActivationStart > 1000) {
+        else if (blheliActivationStep == 2 && Clock::millis() - blheliActivationStart > 1000) {
             blheliFirstRun = false;
-            Serial.println("✅ BLHeli activation COMPLETE in update()");
-            Serial.println("   ESC ready for normal operation!");
+            LOG_EVENT(LOG_BLHELI_COMPLETE);
         }
         
         // Не обрабатываем обычное управление во время активации
         // Но сервоприводы будут работать (код ниже)
     }
     
+    // ============================================================================
+    // 🎛️ КРИВЫЕ СТИКОВ И МИКШЕР
+    // ============================================================================
+    
+    // Фильтры осей (медиана, ФНЧ, скорость), затем кривые: мертвая зона,
+    // экспонента и расходы - одно чтение из таблицы на ось
+    const uint8_t rate = (data.buttons & DUAL_RATE_BUTTON_MASK) ? RATE_SET_LOW : RATE_SET_HIGH;
+    int16_t mixerInputs[MIXER_INPUT_COUNT];
+    mixerInputs[MIX_IN_ROLL] = aileronCurves[rate]->lookup(rollFilter.process(data.xAxis2));
+    mixerInputs[MIX_IN_PITCH] = elevatorCurves[rate]->lookup(pitchFilter.process(data.yAxis1));
+    mixerInputs[MIX_IN_YAW] = rudderCurves[rate]->lookup(yawFilter.process(data.xAxis1));
+    mixerInputs[MIX_IN_THROTTLE] = throttleCurve->lookup(throttleFilter.process(data.yAxis2));
+    mixerInputs[MIX_IN_FLAPS] = data.button1 ? CURVE_SCALE : (data.button2 ? -CURVE_SCALE : 0);
+    
+    // Последние команды пульта - для удержания в failsafe
+    for (uint8_t i = 0; i < MIXER_INPUT_COUNT; i++) {
+        lastInputs[i] = mixerInputs[i];
+    }
+    
+    // Команда на текущий момент: между пакетами ее продолжает updateEstimate()
+    estimator.addSample(mixerInputs, data);
+    const uint32_t nowUs = Clock::micros();
+    estimator.estimate(nowUs, mixerInputs);
+    mixerInputs[MIX_IN_THROTTLE] = motorRamp.process(mixerInputs[MIX_IN_THROTTLE], nowUs);
+    
+    // Стабилизация: команды крена, тангажа и курса -> выходы ПИД по гироскопу
+    #if STABILIZER_ENABLED
+        flightMode = Stabilizer::modeFromButtons(data.buttons);
+        stabilizer.apply(mixerInputs, flightMode);
+    #endif
+    
+    int16_t outputs[MIXER_MAX_OUTPUTS];
+    mixer.evaluate(mixerInputs, outputs);
+    
+    LatencyMonitor::getInstance().mark(LATENCY_MIXED, data.receivedAtUs);
+    
     // ============================================================================
     // 🔥 УПРАВЛЕНИЕ ДВИГАТЕЛЕМ ЧЕРЕЗ МИКРОСЕКУНДЫ
     // ============================================================================
     
     // Если BLHeli активация завершена, управляем двигателем нормально
-    if (motorArmed && !blheliFirstRun) {
-        int motorMicroseconds = 1000;  // По умолчанию STOP
-        
+    if (activeSequence != nullptr) {
+        // Мотором управляет калибровка/тест (advanceSequence)
+    } else if (motorArmed && !blheliFirstRun) {
         // Преобразуем значение джойстика в микросекунды
         // yAxis2: от -512 (низ) до +512 (верх)
         
-        if (data.yAxis2 > 10) {  // Добавляем мертвую зону 10
-            // От 10 до 512 -> от 1100 до 2000 мкс
-            motorMicroseconds = map(data.yAxis2, 10, 512, 1100, 2000);
-            motorMicroseconds = constrain(motorMicroseconds, 1100, 2000);
-            
+        // Мертвая зона DEADZONE_THROTTLE заложена в кривую, диапазон импульсов - в микшер.
+        // Нереверсивный ESC ниже мертвой зоны стоит (STOP), ESC газ/тормоз ниже нейтрали тормозит
+        int motorMicroseconds = motorPulse(mixerInputs[MIX_IN_THROTTLE], outputs[CH_MOTOR]);
+        if (mixerInputs[MIX_IN_THROTTLE] != 0) {
             // Диагностика (раз в 500мс)
             static unsigned long lastMotorLog = 0;
-            if (millis() - lastMotorLog > 500) {
-                Serial.print("🎮 Motor: ");
-                Serial.print(motorMicroseconds);
-                Serial.print("μs (");
-                Serial.print(map(motorMicroseconds, 1000, 2000, 0, 100));
-                Serial.print("%), Joy: ");
-                Serial.println(data.yAxis2);
-                lastMotorLog = millis();
+            if (Clock::millis() - lastMotorLog > 500) {
+                LOG_EVENT(LOG_MOTOR_OUTPUT, motorMicroseconds,
+                          (motorMicroseconds - MOTOR_STOP_PULSE) * 100 / (MOTOR_FULL_PULSE - MOTOR_STOP_PULSE), data.yAxis2);
+                lastMotorLog = Clock::millis();
             }
-        } else {
-            // Джойстик в нейтрали или внизу -> STOP (1000μs)
-            motorMicroseconds = 1000;
         }
         
-        // 🔒 БЕЗОПАСНОСТЬ: Первое обновление всегда STOP
+        // 🔒 БЕЗОПАСНОСТЬ: Первое обновление всегда STOP (после быстрой загрузки - все время удержания)
         if (firstMotorUpdate) {
-            motorMicroseconds = 1000;
-            firstMotorUpdate = false;
-            Serial.println("🛡️ First motor update - SAFETY STOP (1000μs)");
+            motorMicroseconds = MOTOR_STOP_PULSE;
+            if ((int32_t)(Clock::millis() - motorHoldUntilMs) >= 0) {
+                firstMotorUpdate = false;
+                LOG_EVENT(LOG_MOTOR_SAFETY_STOP);
+            }
         }
         
-        // 🔧 Отправляем команду ESC
-        motorServo.writeMicroseconds(motorMicroseconds);
+        // 🔧 Команда ESC уходит вместе с поверхностями одним PwmBank::commit()
+        channels[CH_MOTOR].stageMicroseconds(motorMicroseconds);
         
     } else if (motorArmed && blheliFirstRun) {
         // Во время BLHeli активации двигатель управляется выше
         // Просто логируем состояние
         static unsigned long lastActivationLog = 0;
-        if (millis() - lastActivationLog > 1000) {
-            Serial.print("⏳ BLHeli activation: step ");
-            Serial.print(blheliActivationStep);
-            Serial.print("/2, time: ");
-            Serial.print((millis() - blheliActivationStart) / 1000.0, 1);
-            Serial.println("s");
-            lastActivationLog = millis();
+        if (Clock::millis() - lastActivationLog > 1000) {
+            LOG_EVENT(LOG_BLHELI_PROGRESS, blheliActivationStep,
+                      (int32_t)(Clock::millis() - blheliActivationStart));
+            lastActivationLog = Clock::millis();
         }
     } else {
         // Двигатель не вооружен
-        motorServo.writeMicroseconds(1000);  // STOP
+        channels[CH_MOTOR].stageMicroseconds(MOTOR_STOP_PULSE);
         
         static unsigned long lastWarning = 0;
-        if (millis() - lastWarning > 3000) {
-            Serial.println("⚠️  Motor NOT armed! Send 'c' to calibrate or wait for BLHeli activation");
-            lastWarning = millis();
+        if (Clock::millis() - lastWarning > 3000) {
+            LOG_EVENT(LOG_MOTOR_NOT_ARMED);
+            lastWarning = Clock::millis();
         }
     }
     
     // ============================================================================
     // ⚠️ ЕСЛИ ТЕСТИРОВАНИЕ АКТИВНО - ВЫХОДИМ
     // ============================================================================
-    if (isTesting) {
+    if (getIsTesting()) {
         // ❌ В тестовом режиме НЕ управляем сервоприводами от пульта
         // Но двигатель работает (управляется выше)
+        PwmBank::commit();
         return;
     }
     
@@ -796,121 +982,43 @@ void ServoManager::update(const ControlData& data) {
     // 🎮 НОРМАЛЬНОЕ УПРАВЛЕНИЕ СЕРВОПРИВОДАМИ
     // ============================================================================
     
-    // Применяем мертвые зоны
-    ControlData processedData = data;
-    applyDeadZone(processedData.xAxis1, DEADZONE_XAXIS1);
-    applyDeadZone(processedData.yAxis1, DEADZONE_YAXIS1);
-    applyDeadZone(processedData.xAxis2, DEADZONE_XAXIS2);
-    
-    // Руль высоты
-    int L_elevatorAngle = map(processedData.yAxis1, -512, 512, L_ELEVATOR_MIN, L_ELEVATOR_MAX);
-    int R_elevatorAngle = map(processedData.yAxis1, -512, 512, R_ELEVATOR_MAX, R_ELEVATOR_MIN);
-    
-    // Руль направления
-    int L_rudderAngle = map(processedData.xAxis1, -512, 512, L_RUDDER_MIN, L_RUDDER_MAX);
-    int R_rudderAngle = map(processedData.xAxis1, -512, 512, R_RUDDER_MIN, R_RUDDER_MAX);
-    
-    // Элероны
-    int L_aileronAngle, R_aileronAngle;
-    if (processedData.xAxis2 >= 0) {
-        L_aileronAngle = map(processedData.xAxis2, 0, 512, L_AILERON_NEUTRAL, L_AILERON_MIN);
-        R_aileronAngle = map(processedData.xAxis2, 0, 512, R_AILERON_NEUTRAL, R_AILERON_MAX);
-    } else {
-        L_aileronAngle = map(processedData.xAxis2, -512, 0, L_AILERON_MAX, L_AILERON_NEUTRAL);
-        R_aileronAngle = map(processedData.xAxis2, -512, 0, R_AILERON_MIN, R_AILERON_NEUTRAL);
-    }
+    // Применяем управление; все измененные каналы защелкиваются одним PwmBank::commit()
+    applySurfaces(outputs);
+    PwmBank::commit();
     
-    // Закрылки
-    int L_flapsAngle = L_FLAPS_NEUTRAL;
-    int R_flapsAngle = R_FLAPS_NEUTRAL;
-    if (processedData.button1) {
-        L_flapsAngle = L_FLAPS_MIN;
-        R_flapsAngle = R_FLAPS_MIN;
-    } else if (processedData.button2) {
-        L_flapsAngle = L_FLAPS_MAX;
-        R_flapsAngle = R_FLAPS_MAX;
+    LatencyMonitor::getInstance().mark(LATENCY_OUTPUT, data.receivedAtUs);
+    if (!firstCommandDone) {
+        firstCommandDone = true;
+        firstCommandUs = Clock::micros();
+        LOG_EVENT(LOG_FIRST_COMMAND, (int32_t)(firstCommandUs / 1000));
     }
     
-    // Применяем управление
-    #if SMOOTH_SERVO_MOVEMENT
-        // Плавное движение сервоприводов
-        L_elevatorServo.writeSmooth(L_elevatorAngle, SERVO_SPEED_MEDIUM);
-        R_elevatorServo.writeSmooth(R_elevatorAngle, SERVO_SPEED_MEDIUM);
-        L_rudderServo.writeSmooth(L_rudderAngle, SERVO_SPEED_MEDIUM);
-        R_rudderServo.writeSmooth(R_rudderAngle, SERVO_SPEED_MEDIUM);
-        
-        // Элероны и закрылки с отдельными методами плавного движения
-        updateAileronsSmooth(processedData.xAxis2);
-        updateFlapsSmooth(processedData.button1 ? 512 : (processedData.button2 ? -512 : 0));
-    #else
-        // Прямое управление сервоприводами
-        L_elevatorServo.write(L_elevatorAngle);
-        R_elevatorServo.write(R_elevatorAngle);
-        L_rudderServo.write(L_rudderAngle);
-        R_rudderServo.write(R_rudderAngle);
-        
-        // Элероны и закрылки
-        updateAilerons(processedData.xAxis2);
-        updateFlaps(processedData.button1 ? 512 : (processedData.button2 ? -512 : 0));
-    #endif
-    
     // 📊 ДИАГНОСТИКА ПОЛОЖЕНИЙ СЕРВОПРИВОДОВ (раз в 2 секунды)
     static unsigned long lastServoDebug = 0;
-    if (millis() - lastServoDebug > 2000 && !blheliFirstRun) {
-        // Проверяем, были ли изменения в управлении
-        static int lastElevator = 0, lastRudder = 0, lastAileron = 0;
-        static bool lastFlaps = false;
-        
-        bool shouldPrint = false;
-        
-        if (abs(L_elevatorAngle - lastElevator) > 5) {
-            lastElevator = L_elevatorAngle;
-            shouldPrint = true;
-        }
-        if (abs(L_rudderAngle - lastRudder) > 5) {
-            lastRudder = L_rudderAngle;
-            shouldPrint = true;
-        }
-        if (abs(L_aileronAngle - lastAileron) > 5) {
-            lastAileron = L_aileronAngle;
-            shouldPrint = true;
-        }
-        bool currentFlaps = (processedData.button1 || processedData.button2);
-        if (currentFlaps != lastFlaps) {
-            lastFlaps = currentFlaps;
-            shouldPrint = true;
-        }
-        
-        if (shouldPrint) {
-            Serial.print("🎮 SERVO Positions: ");
-            Serial.print("Elev=");
-            Serial.print(L_elevatorAngle);
-            Serial.print("°, Rud=");
-            Serial.print(L_rudderAngle);
-            Serial.print("°, Ail=");
-            Serial.print(L_aileronAngle);
-            Serial.print("°, Flaps=");
-            Serial.print(L_flapsAngle);
-            Serial.print("°, MotorArmed=");
-            Serial.print(motorArmed ? "YES" : "NO");
-            Serial.print(", BLHeliActive=");
-            Serial.println(blheliFirstRun ? "NO" : "YES");
+    if (Clock::millis() - lastServoDebug > 2000 && !blheliFirstRun) {
+        // Печатаем поверхности, сдвинувшиеся больше чем на 50 мкс
+        static int lastPulses[SURFACE_COUNT] = {};
+        for (uint8_t i = 0; i < SURFACE_COUNT; i++) {
+            if (abs(outputs[i] - lastPulses[i]) > 50) {
+                lastPulses[i] = outputs[i];
+                LOG_EVENT_TEXT(LOG_SERVO_POSITIONS, OUTPUTS[i].name, outputs[i]);
+            }
         }
         
-        lastServoDebug = millis();
+        lastServoDebug = Clock::millis();
     }
     
     // ============================================================================
     // 🔄 ОБНОВЛЕНИЕ СОСТОЯНИЯ ТЕСТОВ (если включены)
     // ============================================================================
     
-    if (testsEnabled && !isTesting && !blheliFirstRun) {
+    if (testsEnabled && activeSequence == nullptr && !blheliFirstRun) {
         // Проверяем условия для автоматического запуска тестов
         // Например, если все оси в нейтрали и нажата комбинация кнопок
         if (abs(data.yAxis1) < 50 && abs(data.xAxis1) < 50 && 
             abs(data.xAxis2) < 50 && abs(data.yAxis2) < 50 &&
             data.button1 && data.button2) {
-            Serial.println("🧪 AUTO-TEST triggered by button combo!");
+            LOG_EVENT(LOG_AUTO_TEST);
             simultaneousTestSequence();
         }
     }
@@ -1,7 +1,17 @@
 #pragma once
-#include <ESP32Servo.h>
+#include <utility>
 #include "Core/Types.h"
+#include "Actuators/AirframeProfile.h"
 #include "ServoGroup.h"
+#include "MotionEngine.h"
+#include "Control/StickCurve.h"
+#include "Control/InputFilter.h"
+#include "Control/ThrottleRamp.h"
+#include "Control/Mixer.h"
+#include "Control/Failsafe.h"
+#include "Control/InputEstimator.h"
+#include "Control/Stabilizer.h"
+#include "Actuators/Sequence.h"
 
 // ============================================================================
 // НАСТРОЙКИ БЕЗОПАСНОСТИ
@@ -16,6 +26,30 @@
 #define SERVO_SPEED_SLOW     500    // Закрылки - медленно
 #define SERVO_SPEED_TEST    1000    // Тестирование - очень медленно
 
+// Ограничение ускорения сервоприводов в плавном режиме (°/с²)
+#define SERVO_ACCELERATION  6000
+
+// Холодный старт: пауза после подачи нейтрали сразу на все выходы
+#define SERVO_SETTLE_MS     500
+
+// Быстрая загрузка после теплого сброса (просадка питания, сторожевой таймер):
+// выходы и прием пакетов сразу, состояние ESC из ConfigStore, без церемонии вооружения
+#define FAST_BOOT_ENABLED        true
+#define FAST_BOOT_MOTOR_HOLD_MS  300    // Мотор на STOP: ESC заново видит нулевой газ
+
+// ESC газ/тормоз (AIRFRAME_ESC_REVERSIBLE): вооружение удержанием нейтрали
+#define ESC_NEUTRAL_ARM_MS       2000
+
+// Протокол ESC. MOTOR_PROTOCOL_PWM - импульс 50 Гц: газ доходит до ESC за период
+// до 20 мс, диапазон нужно калибровать, BLHeli вооружается церемонией.
+// DSHOT150/300/600 - цифровые кадры RMT с частотой DSHOT_FRAME_RATE_HZ (HAL/Dshot.h):
+// задержка до 0.5 мс, калибровка не нужна, вооружение - поток кадров "стоп".
+// ESC газ/тормоз по DShot должен быть в режиме 3D
+#define MOTOR_PROTOCOL_PWM       0
+#define MOTOR_PROTOCOL           MOTOR_PROTOCOL_PWM
+#define MOTOR_DSHOT              (MOTOR_PROTOCOL != MOTOR_PROTOCOL_PWM)
+#define DSHOT_ARM_MS             1000   // Кадры "стоп" до вооружения
+
 // ============================================================================
 // НАСТРОЙКИ ТЕСТИРОВАНИЯ  
 // ============================================================================
@@ -33,12 +67,83 @@
 #define DEADZONE_YAXIS1 20  
 #define DEADZONE_XAXIS2 20
 #define DEADZONE_YAXIS2 20
+#define DEADZONE_THROTTLE 10    // Газ: в этой зоне оси мотор остановлен
+
+// Фильтрация осей до кривых (выключенная ступень не компилируется).
+// Мертвая зона уже заложена в кривые стиков, отдельная ступень не нужна
+#define INPUT_MEDIAN_FILTER   true  // Медиана 3 пакетов: подавление одиночных выбросов
+#define INPUT_LOWPASS_SHIFT   1     // ФНЧ y += (x - y) / 2^N, 0 - выключен
+#define INPUT_SLEW_LIMIT      0     // Макс. изменение оси рулей за пакет (отсчетов), 0 - без ограничения
+#define THROTTLE_SLEW_LIMIT   0     // То же для газа
+
+// Экспонента стиков (0-100%): смягчает реакцию около центра.
+// Экспонента и ограничение нарастания газа - в профиле аппарата
+#define EXPO_ELEVATOR  0
+#define EXPO_RUDDER    0
+#define EXPO_AILERON   0
+
+// Двойные расходы (% полного хода). Малые расходы включаются битом в ControlData::buttons
+#define RATE_HIGH      100
+#define RATE_LOW       60
+#define DUAL_RATE_BUTTON_MASK 0x01
 
-class ServoManager {
+// Схема микширования поверхностей самолета (MIXER_PRESET) - в Actuators/Profiles/PlaneProfile.h
+
+typedef AxisPipeline<
+    FilterStage<INPUT_MEDIAN_FILTER, Median3>,
+    FilterStage<(INPUT_LOWPASS_SHIFT > 0), LowPass<INPUT_LOWPASS_SHIFT>>,
+    FilterStage<(INPUT_SLEW_LIMIT > 0), SlewLimit<INPUT_SLEW_LIMIT>>> StickFilter;
+
+typedef AxisPipeline<
+    FilterStage<INPUT_MEDIAN_FILTER, Median3>,
+    FilterStage<(INPUT_LOWPASS_SHIFT > 0), LowPass<INPUT_LOWPASS_SHIFT>>,
+    FilterStage<(THROTTLE_SLEW_LIMIT > 0), SlewLimit<THROTTLE_SLEW_LIMIT>>> ThrottleFilter;
+
+typedef ThrottleRamp<AirframeProfile::THROTTLE_RAMP_UP_MS, AirframeProfile::THROTTLE_RAMP_BRAKE_MS> MotorRamp;
+
+// Каналы (CH_*, SURFACE_COUNT, OUTPUT_COUNT) и таблицы выходов - из профиля аппарата
+class ServoManager : public AirframeProfile {
 public:
+    // ESC: стоп (нереверсивный - минимум, газ/тормоз - нейтраль) и полный газ вперед
+    static constexpr int MOTOR_STOP_PULSE = outputRestPulse(OUTPUTS[CH_MOTOR]);
+    static constexpr int MOTOR_FULL_PULSE = OUTPUTS[CH_MOTOR].maxUs;
+    static constexpr int MOTOR_TEST_MAX = 60;  // Максимум для тестов (безопасно), из 180
+    static constexpr int MOTOR_TEST_MAX_PULSE = MOTOR_STOP_PULSE + MOTOR_TEST_MAX * (MOTOR_FULL_PULSE - MOTOR_STOP_PULSE) / 180;
+
     ServoManager();
-    void begin();
+    void begin();       // Холодный старт: полная церемония ESC
+    void beginFast();   // Теплый сброс: без задержек, ESC вооружен, если был вооружен
     void update(const ControlData& data);
+    void tick(uint32_t dtUs);   // Шаг плавного движения, вызывается каждый тик управления
+    
+    // Ступень failsafe вместо пакета: каждый тик, пока нет связи
+    void applyFailsafe(const FailsafeStage& stage);
+    
+    // Тик без нового пакета: команда по оценке между пакетами (см. ESTIMATOR_MODE)
+    void updateEstimate(uint32_t nowUs);
+    
+    // Чтение IMU - каждый тик управления, до команд
+    void sampleImu();
+    // Поиск датчика и калибровка нуля гироскопа заново (самолет неподвижен)
+    void beginImu();
+    const Stabilizer& getStabilizer() const { return stabilizer; }
+    
+    // Настройки из ConfigStore: диапазоны и реверс выходов, кривые осей.
+    // Вызывается из задачи управления; кривые, отличные от стандартных, строятся в RAM
+    void applyConfig(const FlightConfig& config);
+    static void makeDefaultConfig(FlightConfig& config);
+    
+    // Слоты кривых стиков (таблицы во flash или в RAM)
+    enum CurveSlot {
+        CURVE_PITCH_HIGH = 0,
+        CURVE_PITCH_LOW,
+        CURVE_YAW_HIGH,
+        CURVE_YAW_LOW,
+        CURVE_ROLL_HIGH,
+        CURVE_ROLL_LOW,
+        CURVE_THROTTLE,
+        CURVE_SLOT_COUNT
+    };
 
     void testSequence();
     void safeTestSequence();
@@ -52,10 +157,20 @@ public:
     void escTestSimple();
     void writeMicroseconds(int us);  // ← ДОБАВЬТЕ ЭТУ СТРОЧКУ
     void blheliArmingSequence();
+    void escBeepSequence();         // DShot: звуковые команды ESC (поиск модели)
+    
+    // Калибровка и тесты не блокируют: они только запускают последовательность,
+    // которую продвигает tick(). Клавиши консоли передаются через handleKey()
+    bool isSequenceRunning() const { return activeSequence != nullptr; }
+    bool handleKey(char key);
+    void cancelSequence(const char* reason);
     
     // Геттеры
     bool isMotorArmed() const { return motorArmed; }
-    bool getIsTesting() const { return isTesting; }
+    uint32_t getOutputsLiveUs() const { return outputsLiveUs; }     // Clock::micros(): импульсы на всех выходах
+    uint32_t getFirstCommandUs() const { return firstCommandUs; }   // Первая команда пульта на выходах
+    bool hasFirstCommand() const { return firstCommandDone; }
+    bool getIsTesting() const { return activeSequence != nullptr && activeSequence->ownsSurfaces; }
     
     // Управление тестами
     void enableTests() { testsEnabled = true; }
@@ -63,8 +178,9 @@ public:
     
     // Экстренная остановка двигателя
     void emergencyStop() { 
-    motorServo.writeMicroseconds(1000);  // ← Используем микросекунды
-    motorArmed = false; 
+    cancelSequence("🛑 EMERGENCY STOP");
+    channels[CH_MOTOR].writeMicroseconds(MOTOR_STOP_PULSE);
+    setMotorArmed(false);
     }
     
     // НОВЫЕ ПУБЛИЧНЫЕ МЕТОДЫ ДЛЯ ТЕСТИРОВАНИЯ
@@ -72,83 +188,84 @@ public:
     void directMotorTest(int powerPercent);
     
 private:
-    // Основные сервоприводы управления полетом
-    ServoGroup L_elevatorServo;
-    ServoGroup R_elevatorServo;
-    ServoGroup L_rudderServo;
-    ServoGroup R_rudderServo;
-    ServoGroup L_aileronServo;
-    ServoGroup R_aileronServo;
-    ServoGroup L_flapServo;
-    ServoGroup R_flapServo;
-    ServoGroup motorServo;
-    
-    bool isTesting = false;
+    // Выходы в порядке таблицы профиля: поверхности, затем ESC (CH_MOTOR)
+    ServoGroup channels[OUTPUT_COUNT];
+    MotionEngine motion;
+    
+    // Таблицы кривых стиков для полных и малых расходов
+    enum RateSet {
+        RATE_SET_HIGH = 0,
+        RATE_SET_LOW,
+        RATE_SET_COUNT
+    };
+    
+    const CurveTable* elevatorCurves[RATE_SET_COUNT];
+    const CurveTable* rudderCurves[RATE_SET_COUNT];
+    const CurveTable* aileronCurves[RATE_SET_COUNT];
+    const CurveTable* throttleCurve;
+    CurveTable runtimeCurves[CURVE_SLOT_COUNT];     // Только для кривых, измененных в настройках
+    
+    // Фильтры осей: состояние между пакетами, без выделения памяти
+    StickFilter rollFilter;
+    StickFilter pitchFilter;
+    StickFilter yawFilter;
+    ThrottleFilter throttleFilter;
+    MotorRamp motorRamp;        // После кривой газа: нарастание по времени (наземные профили)
+    
+    Mixer mixer;
+    int16_t lastInputs[MIXER_INPUT_COUNT] = {};   // Последние команды пульта (для FAILSAFE_HOLD)
+    InputEstimator estimator;
+    Stabilizer stabilizer;
+    uint8_t flightMode = FLIGHT_MODE_MANUAL;    // Режим, запрошенный пультом
+    
+    // Активная последовательность калибровки/теста
+    const Sequence* activeSequence = nullptr;
+    uint8_t sequenceStep = 0;
+    uint32_t stepStartMs = 0;
+    int rampValue = 0;
+    int pendingKey = -1;
+    int pendingMotorUs = outputRestPulse(OUTPUTS[CH_MOTOR]);
+    
     bool motorArmed = false;
+    bool escCalibrated = false;
     bool firstMotorUpdate = true;
     bool testsEnabled = false;  // Флаг для включения тестов
 
     bool blheliFirstRun = true;
     unsigned long blheliActivationStart = 0;
     int blheliActivationStep = 0;
+    uint32_t motorHoldUntilMs = 0;      // Быстрая загрузка: до этого момента мотор на STOP
+    
+    uint32_t outputsLiveUs = 0;
+    uint32_t firstCommandUs = 0;
+    bool firstCommandDone = false;
+    
+    void attachOutputs(bool verbose);
     
-    // Настройки углов сервоприводов
-    // ELEVATOR
-    static const int L_ELEVATOR_MIN = 0;
-    static const int L_ELEVATOR_MAX = 180;
-    static const int L_ELEVATOR_NEUTRAL = 90;
-
-    static const int R_ELEVATOR_MIN = 0;
-    static const int R_ELEVATOR_MAX = 180;
-    static const int R_ELEVATOR_NEUTRAL = 90;
-    
-    // RUDDER
-    static const int L_RUDDER_MIN = 0;
-    static const int L_RUDDER_MAX = 180;
-    static const int L_RUDDER_NEUTRAL = 90;
-    
-    static const int R_RUDDER_MIN = 0;
-    static const int R_RUDDER_MAX = 180;
-    static const int R_RUDDER_NEUTRAL = 90;
-    
-    // AILERON
-    static const int L_AILERON_MIN = 0;
-    static const int L_AILERON_MAX = 180;
-    static const int L_AILERON_NEUTRAL = 90;
-
-    static const int R_AILERON_MIN = 0;
-    static const int R_AILERON_MAX = 180;
-    static const int R_AILERON_NEUTRAL = 90;
-    
-    // FLAPS
-    static const int L_FLAPS_MIN = 0;
-    static const int L_FLAPS_MAX = 180;
-    static const int L_FLAPS_NEUTRAL = 90;
-    
-    static const int R_FLAPS_MIN = 0;
-    static const int R_FLAPS_MAX = 180;
-    static const int R_FLAPS_NEUTRAL = 90;
-
-    // MOTOR
-    static const int MOTOR_MIN = 0;
-    static const int MOTOR_MAX = 180;
-    static const int MOTOR_NEUTRAL = 0;
-    static const int MOTOR_TEST_MAX = 60;  // Максимальное значение для тестов (безопасно)
-
-    // Настройки импульсов
-    static const int SERVO_MIN_PULSE = 500;
-    static const int SERVO_MAX_PULSE = 2400;
-    static const int MOTOR_MIN_PULSE = 1000;
-    static const int MOTOR_MAX_PULSE = 2000;
+    // Выходы строятся из constexpr-таблицы профиля (по одному ServoGroup на строку)
+    template <size_t... Index>
+    explicit ServoManager(std::index_sequence<Index...>);
     
     // Вспомогательные методы
-    void updateAilerons(int rollValue);
-    void updateAileronsSmooth(int rollValue);
-    void updateFlaps(int flapsValue);
-    void updateFlapsSmooth(int flapsValue);
-    void applyDeadZone(int16_t& axisValue, int deadZone);
-    void safeMotorStart();
-    void testMotorSequence();
-    void moveAllServos(int L_elevator, int R_elevator, int L_rudder, int R_rudder,
-                       int L_aileron, int R_aileron, int L_flaps, int R_flaps, int motor);
+    void configureMixer();
+    const CurveTable* selectCurve(uint8_t slot, const CurveParams& params);
+    void setMotorArmed(bool armed);
+    void configureMotion();
+    void applySurfaces(const int16_t outputs[MIXER_MAX_OUTPUTS]);
+    void applyCommands(const int16_t mixerInputs[MIXER_INPUT_COUNT]);
+    // Импульс ESC: нереверсивный стоит до конца мертвой зоны газа, газ/тормоз - всегда по микшеру
+    static int motorPulse(int16_t throttle, int16_t mixed) {
+        return AIRFRAME_ESC_REVERSIBLE || throttle > 0 ? mixed : MOTOR_STOP_PULSE;
+    }
+    static float angleRateToPulseRate(float degreesPerSecond) {
+        return degreesPerSecond * (SERVO_MAX_PULSE - SERVO_MIN_PULSE) / 180.0f;
+    }
+    static float travelTimeToVelocity(int fullTravelMs) {
+        return (SERVO_MAX_PULSE - SERVO_MIN_PULSE) * 1000.0f / fullTravelMs;
+    }
+    void startSequence(const Sequence& sequence);
+    void enterStep(uint8_t index);
+    void advanceSequence();
+    int posePulse(uint8_t surface, uint8_t pose, int percent);
+    void applyPose(uint8_t pose, int percent, int motorUs);
 };
\ No newline at end of file
@@ -0,0 +1,174 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "Core/Types.h"
+#include "Core/Crc16.h"
+
+// ============================================================================
+// ФОРМАТ КАДРА ESP-NOW
+// ============================================================================
+//
+// Версия 1 (13 байт, little-endian):
+//   [0]      версия формата (CONTROL_FRAME_VERSION)
+//   [1..2]   номер пакета (uint16)
+//   [3..10]  64-битное слово полезной нагрузки:
+//              биты  0-9   xAxis1 (знаковое, -512..511)
+//              биты 10-19  yAxis1
+//              биты 20-29  xAxis2
+//              биты 30-39  yAxis2
+//              бит  40     button1
+//              бит  41     button2
+//              биты 42-49  buttons
+//              биты 50-63  время отправки, мс по модулю 2^14
+//   [11..12] CRC-16 (Core/Crc16.h) по байтам 0..10
+//
+// Версия 0 - старый формат: сырая структура LegacyControlData (14 байт).
+// Версии различаются по длине кадра, поэтому пульт и приемник можно
+// обновлять независимо.
+//
+// Заголовочный файл без зависимостей от Arduino - подключается и в прошивку пульта.
+
+#define CONTROL_FRAME_VERSION      1
+#define CONTROL_FRAME_SIZE         13
+#define CONTROL_FRAME_AXIS_BITS    10
+#define CONTROL_FRAME_TIME_MASK    0x3FFF
+
+// Кадр версии 0: структура, которую старый пульт отправляет как есть
+struct LegacyControlData {
+    int16_t xAxis1;
+    int16_t yAxis1;
+    int16_t xAxis2;
+    int16_t yAxis2;
+    bool button1;
+    bool button2;
+    uint8_t buttons;
+    uint16_t crc;
+};
+
+enum FrameStatus {
+    FRAME_OK = 0,
+    FRAME_BAD_LENGTH,
+    FRAME_BAD_VERSION,
+    FRAME_BAD_CRC
+};
+
+class ControlFrame {
+public:
+    // Упаковать пакет в кадр версии 1. out должен вмещать CONTROL_FRAME_SIZE байт
+    static size_t encode(const ControlData& data, uint8_t* out) {
+        uint64_t payload = 0;
+        payload |= packAxis(data.xAxis1) << 0;
+        payload |= packAxis(data.yAxis1) << 10;
+        payload |= packAxis(data.xAxis2) << 20;
+        payload |= packAxis(data.yAxis2) << 30;
+        payload |= (uint64_t)(data.button1 ? 1 : 0) << 40;
+        payload |= (uint64_t)(data.button2 ? 1 : 0) << 41;
+        payload |= (uint64_t)data.buttons << 42;
+        payload |= (uint64_t)(data.senderTimeMs & CONTROL_FRAME_TIME_MASK) << 50;
+
+        out[0] = CONTROL_FRAME_VERSION;
+        writeU16(out + 1, data.sequence);
+        for (int i = 0; i < 8; i++) {
+            out[3 + i] = (uint8_t)(payload >> (8 * i));
+        }
+        writeU16(out + 11, Crc16::compute(out, CONTROL_FRAME_SIZE - 2));
+        return CONTROL_FRAME_SIZE;
+    }
+
+    // Разобрать кадр прямо из буфера радио (без промежуточного memcpy)
+    static FrameStatus decode(const uint8_t* frame, int len, ControlData& out) {
+        if (len == CONTROL_FRAME_SIZE) {
+            return decodeV1(frame, out);
+        }
+        if (len == (int)sizeof(LegacyControlData)) {
+            return decodeLegacy(frame, out);
+        }
+        return FRAME_BAD_LENGTH;
+    }
+
+    // Кадр версии 0 (для старых пультов и тестов)
+    static size_t encodeLegacy(const ControlData& data, uint8_t* out) {
+        LegacyControlData legacy = {};
+        legacy.xAxis1 = data.xAxis1;
+        legacy.yAxis1 = data.yAxis1;
+        legacy.xAxis2 = data.xAxis2;
+        legacy.yAxis2 = data.yAxis2;
+        legacy.button1 = data.button1;
+        legacy.button2 = data.button2;
+        legacy.buttons = data.buttons;
+        legacy.crc = Crc16::compute((const uint8_t*)&legacy, offsetof(LegacyControlData, crc));
+        const uint8_t* bytes = (const uint8_t*)&legacy;
+        for (size_t i = 0; i < sizeof(legacy); i++) {
+            out[i] = bytes[i];
+        }
+        return sizeof(legacy);
+    }
+
+private:
+    static uint64_t packAxis(int16_t value) {
+        // 10 бит со знаком: -512..511 (значение +512 ограничивается до 511)
+        if (value > 511) value = 511;
+        if (value < -512) value = -512;
+        return (uint64_t)((uint16_t)value & 0x3FF);
+    }
+
+    static int16_t unpackAxis(uint64_t payload, int shift) {
+        int16_t value = (int16_t)((payload >> shift) & 0x3FF);
+        return (value & 0x200) ? (int16_t)(value - 0x400) : value;
+    }
+
+    static uint16_t readU16(const uint8_t* p) {
+        return (uint16_t)(p[0] | (p[1] << 8));
+    }
+
+    static void writeU16(uint8_t* p, uint16_t value) {
+        p[0] = (uint8_t)value;
+        p[1] = (uint8_t)(value >> 8);
+    }
+
+    static FrameStatus decodeV1(const uint8_t* frame, ControlData& out) {
+        if (frame[0] != CONTROL_FRAME_VERSION) {
+            return FRAME_BAD_VERSION;
+        }
+        if (Crc16::compute(frame, CONTROL_FRAME_SIZE - 2) != readU16(frame + 11)) {
+            return FRAME_BAD_CRC;
+        }
+
+        uint64_t payload = 0;
+        for (int i = 7; i >= 0; i--) {
+            payload = (payload << 8) | frame[3 + i];
+        }
+
+        out.xAxis1 = unpackAxis(payload, 0);
+        out.yAxis1 = unpackAxis(payload, 10);
+        out.xAxis2 = unpackAxis(payload, 20);
+        out.yAxis2 = unpackAxis(payload, 30);
+        out.button1 = (payload >> 40) & 1;
+        out.button2 = (payload >> 41) & 1;
+        out.buttons = (uint8_t)(payload >> 42);
+        out.senderTimeMs = (uint16_t)((payload >> 50) & CONTROL_FRAME_TIME_MASK);
+        out.sequence = readU16(frame + 1);
+        out.version = CONTROL_FRAME_VERSION;
+        return FRAME_OK;
+    }
+
+    static FrameStatus decodeLegacy(const uint8_t* frame, ControlData& out) {
+        // Поля читаются по смещениям структуры, без копирования всего кадра
+        const size_t crcOffset = offsetof(LegacyControlData, crc);
+        if (Crc16::compute(frame, crcOffset) != readU16(frame + crcOffset)) {
+            return FRAME_BAD_CRC;
+        }
+
+        out.xAxis1 = (int16_t)readU16(frame + offsetof(LegacyControlData, xAxis1));
+        out.yAxis1 = (int16_t)readU16(frame + offsetof(LegacyControlData, yAxis1));
+        out.xAxis2 = (int16_t)readU16(frame + offsetof(LegacyControlData, xAxis2));
+        out.yAxis2 = (int16_t)readU16(frame + offsetof(LegacyControlData, yAxis2));
+        out.button1 = frame[offsetof(LegacyControlData, button1)] != 0;
+        out.button2 = frame[offsetof(LegacyControlData, button2)] != 0;
+        out.buttons = frame[offsetof(LegacyControlData, buttons)];
+        out.sequence = 0;
+        out.senderTimeMs = 0;
+        out.version = 0;
+        return FRAME_OK;
+    }
+};
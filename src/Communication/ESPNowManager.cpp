@@ -1,62 +1,65 @@
 #include "ESPNowManager.h"
-#include <Arduino.h>
+#include "ControlFrame.h"
+#include "Diagnostics/LatencyMonitor.h"
+#include "Diagnostics/EventLog.h"
+#include "Diagnostics/FlightRecorder.h"
+#include "HAL/Hal.h"
 
 // Статическая переменная для доступа к экземпляру из статической функции
 static ESPNowManager* espNowInstance = nullptr;
 
 void ESPNowManager::begin() {
-    WiFi.mode(WIFI_STA);
-    
-    if (esp_now_init() != ESP_OK) {
-        Serial.println("❌ Ошибка инициализации ESP-NOW");
+    if (!Radio::begin()) {
+        console.println("❌ Ошибка инициализации ESP-NOW");
         return;
     }
     
     // Сохраняем указатель на экземпляр ДО регистрации callback
     espNowInstance = this;
     
-    esp_now_register_recv_cb(onDataReceived);
+    Radio::onReceive(onDataReceived);
     
     // Инициализация пина светодиода
-    pinMode(HardwareConfig::LED_PIN, OUTPUT);
-    digitalWrite(HardwareConfig::LED_PIN, LOW); // Изначально выключен
+    Gpio::setOutput(HardwareConfig::LED_PIN);
+    Gpio::write(HardwareConfig::LED_PIN, false); // Изначально выключен
     
     // Вывод MAC адреса для спаривания
-    Serial.print("📡 MAC приемника: ");
-    Serial.println(WiFi.macAddress());
+    uint8_t receiverMac[6];
+    Radio::getMacAddress(receiverMac);
+    console.print("📡 MAC приемника: ");
+    for (int i = 0; i < 6; i++) {
+        console.print(receiverMac[i], CONSOLE_HEX);
+        if (i < 5) console.print(":");
+    }
+    console.println();
     
     // Вывод MAC адреса передатчика
-    Serial.print("📡 MAC передатчика: ");
+    console.print("📡 MAC передатчика: ");
     for (int i = 0; i < 6; i++) {
-        Serial.print(transmitterMac[i], HEX);
-        if (i < 5) Serial.print(":");
+        console.print(transmitterMac[i], CONSOLE_HEX);
+        if (i < 5) console.print(":");
     }
-    Serial.println();
+    console.println();
     
-    Serial.println("✅ ESP-NOW инициализирован");
+    console.println("✅ ESP-NOW инициализирован");
 }
 
 void ESPNowManager::registerCallback(DataReceivedCallback callback) {
     dataCallback = callback;
-    Serial.println("✅ Callback зарегистрирован в ESPNowManager");
+    console.println("✅ Callback зарегистрирован в ESPNowManager");
 }
 
 bool ESPNowManager::addPeer() {
-    esp_now_peer_info_t peerInfo = {};
-    memcpy(peerInfo.peer_addr, transmitterMac, 6);
-    peerInfo.channel = 0;
-    peerInfo.encrypt = false;
-    
-    if (esp_now_add_peer(&peerInfo) == ESP_OK) {
-        Serial.print("✅ Peer добавлен: ");
+    if (Radio::addPeer(transmitterMac)) {
+        console.print("✅ Peer добавлен: ");
         for (int i = 0; i < 6; i++) {
-            Serial.print(transmitterMac[i], HEX);
-            if (i < 5) Serial.print(":");
+            console.print(transmitterMac[i], CONSOLE_HEX);
+            if (i < 5) console.print(":");
         }
-        Serial.println();
+        console.println();
         return true;
     } else {
-        Serial.println("❌ Ошибка добавления peer через ESPNowManager");
+        console.println("❌ Ошибка добавления peer через ESPNowManager");
         return false;
     }
 }
@@ -65,11 +68,11 @@ void ESPNowManager::setConnectionStatus(bool connected) {
     if (connectionActive != connected) {
         connectionActive = connected;
         if (connected) {
-            Serial.println("📶 Связь с пультом УСТАНОВЛЕНА");
-            digitalWrite(HardwareConfig::LED_PIN, HIGH); // Постоянно горит при связи
+            LOG_EVENT(LOG_LINK_UP);
+            Gpio::write(HardwareConfig::LED_PIN, true); // Постоянно горит при связи
         } else {
-            Serial.println("📶 Связь с пультом ПОТЕРЯНА");
-            digitalWrite(HardwareConfig::LED_PIN, LOW); // Выключаем при потере
+            LOG_EVENT(LOG_LINK_DOWN);
+            Gpio::write(HardwareConfig::LED_PIN, false); // Выключаем при потере
         }
     }
 }
@@ -81,51 +84,70 @@ void ESPNowManager::updateConnectionIndicator() {
     }
     
     // Если связи нет - мигаем каждые 500мс
-    unsigned long currentTime = millis();
+    unsigned long currentTime = Clock::millis();
     if (currentTime - lastIndicatorUpdate > 500) {
         indicatorState = !indicatorState;
-        digitalWrite(HardwareConfig::LED_PIN, indicatorState);
+        Gpio::write(HardwareConfig::LED_PIN, indicatorState);
         lastIndicatorUpdate = currentTime;
     }
 }
 
 void ESPNowManager::updateConnection() {
-    const unsigned long CONNECTION_TIMEOUT = 2000; // Таймаут связи 2 секунды
-    
     // Проверяем потерю связи только если она была активна
     if (connectionActive) {
-        if (millis() - lastPacketTime > CONNECTION_TIMEOUT) {
+        if (Clock::millis() - lastPacketTime > CONNECTION_TIMEOUT_MS) {
             setConnectionStatus(false);
         }
     }
     
     // Обновляем индикатор (для мигания при потере связи)
     updateConnectionIndicator();
+    
+    // Сводка по каналу за последние 30 секунд
+    if (Clock::millis() - lastStatsPrint > 30000) {
+        const LinkStatsSnapshot stats = linkStats.getSnapshot();
+        LOG_EVENT(LOG_LINK_STATS, stats.received - lastStats.received, stats.lost - lastStats.lost,
+                  stats.crcErrors - lastStats.crcErrors, (int32_t)stats.jitterUs, stats.lastRssi);
+        lastStats = stats;
+        lastStatsPrint = Clock::millis();
+    }
 }
 
-void ESPNowManager::onDataReceived(const uint8_t* mac, const uint8_t* data, int len) {
-    if (len != sizeof(ControlData)) {
-        Serial.printf("❌ Неверный пакет: %d байт\n", len);
-        return;
-    }
+void ESPNowManager::onDataReceived(const uint8_t* mac, const uint8_t* data, int len, int8_t rssi) {
+    uint32_t receivedAtUs = Clock::micros();
     
-    ControlData receivedData;
-    memcpy(&receivedData, data, sizeof(receivedData));
+#if FLIGHT_RECORDER_ENABLED
+    // Сырой кадр до разбора: воспроизведение повторяет и ошибки CRC
+    FlightRecorder::getInstance().record(data, len, rssi, receivedAtUs);
+#endif
     
-    // Валидация CRC
-    uint16_t calculatedCRC = 0;
-    const uint8_t* bytes = (const uint8_t*)&receivedData;
-    for(size_t i = 0; i < sizeof(ControlData) - sizeof(uint16_t); i++) {
-        calculatedCRC += bytes[i];
+    // Разбор и проверка CRC прямо из буфера радио
+    ControlData receivedData;
+    FrameStatus status = ControlFrame::decode(data, len, receivedData);
+    
+    if (status != FRAME_OK) {
+        if (espNowInstance != nullptr) {
+            if (status == FRAME_BAD_CRC) {
+                espNowInstance->linkStats.onCrcError();
+            } else {
+                espNowInstance->linkStats.onBadFrame();
+            }
+        }
+        if (status == FRAME_BAD_LENGTH) {
+            LOG_EVENT(LOG_FRAME_BAD_LENGTH, len);
+        } else if (status == FRAME_BAD_VERSION) {
+            LOG_EVENT(LOG_FRAME_BAD_VERSION, data[0]);
+        }
+        return; // Пакет с ошибкой CRC сбрасывается без вывода, но учитывается
     }
     
-    if (calculatedCRC != receivedData.crc) {
-        return; // Тихий сброс пакета с ошибкой CRC
-    }
+    receivedData.receivedAtUs = receivedAtUs;
+    LatencyMonitor::getInstance().mark(LATENCY_DECODED, receivedAtUs);
     
     // Обновляем время последнего пакета и статус связи
     if (espNowInstance != nullptr) {
-        espNowInstance->lastPacketTime = millis();
+        espNowInstance->linkStats.onFrame(receivedData.sequence, receivedData.version > 0, receivedAtUs, rssi);
+        espNowInstance->lastPacketTime = Clock::millis();
         espNowInstance->setConnectionStatus(true);
     }
     
@@ -133,17 +155,4 @@ void ESPNowManager::onDataReceived(const uint8_t* mac, const uint8_t* data, int
     if (espNowInstance != nullptr && espNowInstance->dataCallback != nullptr) {
         espNowInstance->dataCallback(receivedData);
     }
-    
-    // УПРОЩЕННАЯ диагностика связи
-    static unsigned long lastStablePrint = 0;
-    static int packetCount = 0;
-    packetCount++;
-    
-    // Раз в 30 секунд вместо 10
-    if (millis() - lastStablePrint > 30000) {
-        Serial.printf("📡 ESP-NOW: %d packets/30sec | RSSI: %d\n", 
-                     packetCount, WiFi.RSSI());
-        lastStablePrint = millis();
-        packetCount = 0;
-    }
 }
\ No newline at end of file
@@ -1,7 +1,10 @@
 #pragma once
-#include <esp_now.h>
-#include <WiFi.h>
+#include "HAL/Radio.h"
 #include "Core/Types.h"
+#include "LinkStats.h"
+
+// Нет ни одного верного кадра дольше этого времени -> связь потеряна (индикатор мигает)
+#define CONNECTION_TIMEOUT_MS 2000
 
 class ESPNowManager {
 public:
@@ -16,6 +19,10 @@ public:
     bool isConnected() const { return connectionActive; }
     void updateConnection(); // Обновление состояния связи и индикации
     
+    // Статистика канала по каждому кадру (потери, дубли, джиттер, RSSI)
+    const LinkStats& getLinkStats() const { return linkStats; }
+    void requestLinkStatsReset() { linkStats.requestReset(); lastStats = {}; }   // С приходом следующего кадра
+    
     // Singleton instance
     static ESPNowManager& getInstance() {
         static ESPNowManager instance;
@@ -28,12 +35,14 @@ private:
     unsigned long lastPacketTime = 0;
     unsigned long lastIndicatorUpdate = 0;
     bool indicatorState = false;
+    LinkStats linkStats;
+    LinkStatsSnapshot lastStats = {};       // Снимок на начало 30-секундного окна
+    unsigned long lastStatsPrint = 0;
     
     // MAC-адрес передатчика
     const uint8_t transmitterMac[6] = {0x14, 0x33, 0x5C, 0x37, 0x82, 0x58};
     
-    static void onDataReceived(const uint8_t* mac, const uint8_t* data, int len);
-    bool validateCRC(const ControlData& data);
+    static void onDataReceived(const uint8_t* mac, const uint8_t* data, int len, int8_t rssi);
     void updateConnectionIndicator();
     
     // Приватный конструктор для singleton
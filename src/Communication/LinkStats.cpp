@@ -0,0 +1,109 @@
+#include "LinkStats.h"
+#include <cmath>
+#include "HAL/Console.h"
+
+void LinkStats::onFrame(uint16_t sequence, bool hasSequence, uint32_t arrivalUs, int8_t rssi) {
+    applyResetRequest();
+    received++;
+
+    // Нумерация: пропуски, дубли, перестановки
+    if (hasSequence) {
+        if (!haveSequence) {
+            haveSequence = true;
+            highestSequence = sequence;
+        } else {
+            const int16_t gap = (int16_t)(sequence - highestSequence);
+            if (gap > LINK_STATS_RESYNC_GAP || gap < -LINK_STATS_RESYNC_GAP) {
+                resyncs++;
+                highestSequence = sequence;
+            } else if (gap > 0) {
+                lost += gap - 1;
+                highestSequence = sequence;
+            } else if (gap == 0) {
+                duplicates++;
+            } else {
+                // Пакет из прошлого: уже учтен как потерянный
+                reordered++;
+                if (lost > 0) {
+                    lost--;
+                }
+            }
+        }
+    }
+
+    // Интервалы между пакетами
+    if (haveArrival) {
+        const float interval = (float)(arrivalUs - lastArrivalUs);
+        intervalCount++;
+        const float delta = interval - intervalMean;
+        intervalMean += delta / intervalCount;
+        intervalM2 += delta * (interval - intervalMean);
+        jitterHistogram.record((uint32_t)fabsf(interval - intervalMean));
+    }
+    haveArrival = true;
+    lastArrivalUs = arrivalUs;
+
+    // RSSI из служебной информации кадра
+    lastRssi = rssi;
+    if (rssiCount == 0 || rssi < minRssi) {
+        minRssi = rssi;
+    }
+    rssiSum += rssi;
+    rssiCount++;
+}
+
+LinkStatsSnapshot LinkStats::getSnapshot() const {
+    LinkStatsSnapshot snapshot = {};
+    snapshot.received = received;
+    snapshot.lost = lost;
+    snapshot.duplicates = duplicates;
+    snapshot.reordered = reordered;
+    snapshot.crcErrors = crcErrors;
+    snapshot.badFrames = badFrames;
+    snapshot.resyncs = resyncs;
+
+    const uint32_t expected = snapshot.received - snapshot.duplicates + snapshot.lost;
+    snapshot.lossPercent = expected > 0 ? 100.0f * snapshot.lost / expected : 0.0f;
+
+    snapshot.meanIntervalUs = intervalMean;
+    snapshot.jitterUs = intervalCount > 1 ? sqrtf(intervalM2 / (intervalCount - 1)) : 0.0f;
+
+    snapshot.lastRssi = lastRssi;
+    snapshot.minRssi = minRssi;
+    snapshot.meanRssi = rssiCount > 0 ? (float)rssiSum / rssiCount : 0.0f;
+    return snapshot;
+}
+
+void LinkStats::printReport() const {
+    const LinkStatsSnapshot s = getSnapshot();
+    console.printf("  Link: rx %lu, lost %lu (%.2f%%), dup %lu, reordered %lu, CRC %lu, bad %lu, resync %lu\n",
+                   (unsigned long)s.received, (unsigned long)s.lost, s.lossPercent,
+                   (unsigned long)s.duplicates, (unsigned long)s.reordered,
+                   (unsigned long)s.crcErrors, (unsigned long)s.badFrames, (unsigned long)s.resyncs);
+    console.printf("  Interval: mean %.0f us, jitter %.0f us (p50 %lu, p99 %lu, max %lu)\n",
+                   s.meanIntervalUs, s.jitterUs,
+                   (unsigned long)jitterHistogram.percentile(50),
+                   (unsigned long)jitterHistogram.percentile(99),
+                   (unsigned long)jitterHistogram.getMax());
+    console.printf("  RSSI: last %d dBm, min %d dBm, mean %.1f dBm\n",
+                   s.lastRssi, s.minRssi, s.meanRssi);
+}
+
+void LinkStats::reset() {
+    received = 0;
+    lost = 0;
+    duplicates = 0;
+    reordered = 0;
+    crcErrors = 0;
+    badFrames = 0;
+    resyncs = 0;
+    haveSequence = false;
+    haveArrival = false;
+    intervalCount = 0;
+    intervalMean = 0.0f;
+    intervalM2 = 0.0f;
+    jitterHistogram.reset();
+    minRssi = 0;
+    rssiSum = 0;
+    rssiCount = 0;
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include "Diagnostics/LatencyHistogram.h"
+
+// Порог, после которого скачок номера пакета считается перезапуском пульта
+#define LINK_STATS_RESYNC_GAP  1000
+
+// Снимок статистики канала для вывода и настройки частоты пакетов
+struct LinkStatsSnapshot {
+    uint32_t received;          // Принятых кадров с верным CRC
+    uint32_t lost;              // Пропуски в нумерации (минус пришедшие позже)
+    uint32_t duplicates;
+    uint32_t reordered;         // Пришли после более нового пакета
+    uint32_t crcErrors;
+    uint32_t badFrames;         // Неверная длина/версия
+    uint32_t resyncs;           // Перезапуски нумерации
+    float lossPercent;
+    float meanIntervalUs;       // Средний интервал между пакетами
+    float jitterUs;             // Стандартное отклонение интервала
+    int8_t lastRssi;
+    int8_t minRssi;
+    float meanRssi;
+};
+
+// Статистика канала ESP-NOW по каждому кадру.
+// Постоянный объем памяти, без выделений; onFrame() - несколько сложений и
+// одно деление, безопасно вызывать из callback приема.
+// Писатель - callback ESP-NOW; чтение из loop() дает приблизительный снимок.
+// Сброс из другой задачи - только запросом: его выполняет сам писатель.
+class LinkStats {
+public:
+    // Кадр с верным CRC. hasSequence = false для кадров без нумерации (версия 0)
+    void onFrame(uint16_t sequence, bool hasSequence, uint32_t arrivalUs, int8_t rssi);
+    void onCrcError() { applyResetRequest(); crcErrors++; }
+    void onBadFrame() { applyResetRequest(); badFrames++; }
+
+    LinkStatsSnapshot getSnapshot() const;
+
+    // Отклонения интервала от среднего, log2-корзины (мкс)
+    const LatencyHistogram& getJitterHistogram() const { return jitterHistogram; }
+
+    void printReport() const;
+    // Статистика обнуляется перед следующим кадром (верным или битым):
+    // счетчики и среднее Уэлфорда не сбрасываются посреди обновления
+    void requestReset() { pendingReset.store(true, std::memory_order_release); }
+
+private:
+    volatile uint32_t received = 0;
+    volatile uint32_t lost = 0;
+    volatile uint32_t duplicates = 0;
+    volatile uint32_t reordered = 0;
+    volatile uint32_t crcErrors = 0;
+    volatile uint32_t badFrames = 0;
+    volatile uint32_t resyncs = 0;
+
+    bool haveSequence = false;
+    uint16_t highestSequence = 0;
+
+    // Интервалы: среднее и дисперсия по Уэлфорду
+    bool haveArrival = false;
+    uint32_t lastArrivalUs = 0;
+    uint32_t intervalCount = 0;
+    float intervalMean = 0.0f;
+    float intervalM2 = 0.0f;
+    LatencyHistogram jitterHistogram;
+
+    int8_t lastRssi = 0;
+    int8_t minRssi = 0;
+    int32_t rssiSum = 0;
+    uint32_t rssiCount = 0;
+
+    std::atomic<bool> pendingReset{false};
+
+    void applyResetRequest() {
+        if (pendingReset.load(std::memory_order_relaxed) &&
+            pendingReset.exchange(false, std::memory_order_acquire)) {
+            reset();
+        }
+    }
+    void reset();
+};
@@ -0,0 +1,218 @@
+#include "ControlTask.h"
+#include "Diagnostics/LatencyMonitor.h"
+#include "Core/TaskLayout.h"
+#include "Communication/LinkStats.h"
+
+// Запросы сброса статистики (pendingReset)
+#define RESET_JITTER  0x01
+#define RESET_STATS   0x02
+
+ControlTask::ControlTask(ServoManager& servoManager)
+    : servoManager(servoManager) {
+}
+
+bool ControlTask::begin(uint16_t rate) {
+    rateHz = constrain(rate, 50, 1000);
+    periodUs = 1000000UL / rateHz;
+    
+    // Настройки из NVS применяются до первого тика
+    applyConfigIfChanged();
+
+#if defined(ARDUINO)
+    actuatorMutex = xSemaphoreCreateMutex();
+    if (actuatorMutex == nullptr) {
+        console.println("❌ ControlTask: не удалось создать mutex");
+        return false;
+    }
+
+    if (!startTask(TASK_CONTROL, taskEntry, this, &taskHandle)) {
+        return false;
+    }
+
+    // Тик FreeRTOS = 1 мс, поэтому период задаем таймером с микросекундным разрешением
+    esp_timer_create_args_t timerArgs = {};
+    timerArgs.callback = onTimer;
+    timerArgs.arg = this;
+    timerArgs.name = "control_tick";
+    if (esp_timer_create(&timerArgs, &tickTimer) != ESP_OK ||
+        esp_timer_start_periodic(tickTimer, periodUs) != ESP_OK) {
+        console.println("❌ ControlTask: не удалось запустить таймер");
+        return false;
+    }
+
+    console.printf("✅ ControlTask: %u Hz на ядре %u\n", rateHz, TASK_LAYOUT[TASK_CONTROL].core);
+#endif
+    return true;
+}
+
+void ControlTask::submit(const ControlData& data) {
+    // Тот же знаковый разрыв номера, что в LinkStats: дубль (0) и кадр из
+    // прошлого (< 0) отбрасываются, скачок больше LINK_STATS_RESYNC_GAP - перезапуск
+    if (data.version > 0) {
+        if (haveSequence &&
+            data.receivedAtUs - lastAcceptedUs <= (uint32_t)CONTROL_SEQUENCE_RESYNC_MS * 1000) {
+            const int16_t gap = (int16_t)(data.sequence - lastSequence);
+            if (gap <= 0 && gap >= -LINK_STATS_RESYNC_GAP) {
+                stalePackets++;
+                return;
+            }
+        }
+        haveSequence = true;
+        lastSequence = data.sequence;
+        lastAcceptedUs = data.receivedAtUs;
+    }
+    slot.publish(data);
+}
+
+void ControlTask::tick() {
+    uint32_t now = Clock::micros();
+    applyResetRequest();
+
+    uint32_t interval = periodUs;
+    if (lastTickUs != 0) {
+        interval = now - lastTickUs;
+        uint32_t jitter = interval > periodUs ? interval - periodUs : periodUs - interval;
+        if (jitter > maxJitterUs) {
+            maxJitterUs = jitter;
+        }
+        jitterHistogram.record(jitter);
+    }
+    lastTickUs = now;
+    tickCount++;
+
+    // Команда из Serial держит сервоприводы - пропускаем тик, но не блокируемся
+    if (!tryLockActuators()) {
+        skippedTicks++;
+        return;
+    }
+
+    // Новая версия настроек из консоли: применяется между пакетами, целиком
+    applyConfigIfChanged();
+    
+    // Датчик - до команд: и пакет, и оценка между пакетами стабилизируются по свежим показаниям
+    servoManager.sampleImu();
+    
+    ControlData data;
+    bool updated = false;
+    if (slot.consume(data)) {
+        lastLatencyUs = now - data.receivedAtUs;
+        if (lastLatencyUs > maxLatencyUs) {
+            maxLatencyUs = lastLatencyUs;
+        }
+        LatencyMonitor::getInstance().mark(LATENCY_DEQUEUED, data.receivedAtUs);
+        failsafe.onPacket(data.receivedAtUs);
+        
+        // Пока не прошел гистерезис восстановления, пакеты только отмечаются
+        if (!failsafe.isActive()) {
+            servoManager.update(data);
+            updated = true;
+        }
+    }
+    
+    // Потеря связи проверяется каждый тик: реакция ограничена периодом тика
+    const FailsafeStage* failsafeStage = failsafe.evaluate(now);
+    if (failsafeStage != nullptr) {
+        servoManager.applyFailsafe(*failsafeStage);
+    } else if (!updated) {
+        // Между пакетами команда продолжается по оценке - выход обновляется с частотой тика
+        servoManager.updateEstimate(now);
+    }
+    
+    // Плавное движение продвигается каждый тик, даже без нового пакета.
+    // Пропущенные тики не превращаются в скачок больше нескольких периодов
+    servoManager.tick(min(interval, 4 * periodUs));
+
+    unlockActuators();
+    
+    const uint32_t execUs = Clock::micros() - now;
+    if (execUs > maxExecUs) {
+        maxExecUs = execUs;
+    }
+    if (execUs > periodUs) {
+        overruns++;
+    }
+    execHistogram.record(execUs);
+}
+
+#if defined(ARDUINO)
+
+bool ControlTask::tryLockActuators() {
+    return actuatorMutex == nullptr || xSemaphoreTake(actuatorMutex, 0) == pdTRUE;
+}
+
+void ControlTask::lockActuators() {
+    if (actuatorMutex != nullptr) {
+        xSemaphoreTake(actuatorMutex, portMAX_DELAY);
+    }
+}
+
+void ControlTask::unlockActuators() {
+    if (actuatorMutex != nullptr) {
+        xSemaphoreGive(actuatorMutex);
+    }
+}
+
+#else
+
+// На хосте все выполняется в одном потоке
+bool ControlTask::tryLockActuators() { return true; }
+void ControlTask::lockActuators() {}
+void ControlTask::unlockActuators() {}
+
+#endif
+
+void ControlTask::applyConfigIfChanged() {
+    ConfigStore& store = ConfigStore::getInstance();
+    const uint32_t generation = store.getGeneration();
+    if (generation == configGeneration) {
+        return;
+    }
+    const FlightConfig& config = store.active();
+    servoManager.applyConfig(config);
+    failsafe.applyConfig(config.failsafe);
+    configGeneration = generation;
+    store.acknowledge(generation);
+}
+
+void ControlTask::requestStatsReset() {
+    pendingReset.fetch_or(RESET_STATS | RESET_JITTER, std::memory_order_release);
+}
+
+void ControlTask::requestJitterReset() {
+    pendingReset.fetch_or(RESET_JITTER, std::memory_order_release);
+}
+
+void ControlTask::applyResetRequest() {
+    const uint8_t request = pendingReset.exchange(0, std::memory_order_acquire);
+    if (request & RESET_STATS) {
+        skippedTicks = 0;
+        maxLatencyUs = 0;
+    }
+    if (request & RESET_JITTER) {
+        maxJitterUs = 0;
+        jitterHistogram.reset();
+        maxExecUs = 0;
+        execHistogram.reset();
+        overruns = 0;
+    }
+}
+
+#if defined(ARDUINO)
+
+void ControlTask::taskEntry(void* arg) {
+    ControlTask* self = static_cast<ControlTask*>(arg);
+    for (;;) {
+        // Ждем сигнала таймера; накопившиеся сигналы схлопываются в один тик
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        self->tick();
+    }
+}
+
+void ControlTask::onTimer(void* arg) {
+    ControlTask* self = static_cast<ControlTask*>(arg);
+    if (self->taskHandle != nullptr) {
+        xTaskNotifyGive(self->taskHandle);
+    }
+}
+
+#endif
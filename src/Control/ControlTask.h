@@ -0,0 +1,120 @@
+#pragma once
+#include <atomic>
+#include "HAL/Hal.h"
+#include "Core/Types.h"
+#include "Core/SpscSlot.h"
+#include "Actuators/ServoManager.h"
+#include "Control/Failsafe.h"
+#include "Core/ConfigStore.h"
+#include "Diagnostics/LatencyHistogram.h"
+
+// ============================================================================
+// НАСТРОЙКИ ЗАДАЧИ УПРАВЛЕНИЯ
+// ============================================================================
+
+// Частота цикла управления (Гц). Разумный диапазон 100-1000.
+// Со стабилизацией - частота ПИД (STABILIZER_RATE_HZ), без нее хватает 200
+#if STABILIZER_ENABLED
+#define CONTROL_TASK_RATE_HZ     STABILIZER_RATE_HZ
+#else
+#define CONTROL_TASK_RATE_HZ     200
+#endif
+
+// Ядро, приоритет и стек задачи - в Core/TaskLayout.h
+
+// Дубль или запоздавший кадр (номер не новее последнего принятого) не
+// применяется. После тишины дольше этого времени нумерация принимается
+// заново: пульт мог перезапуститься с меньшим номером
+#define CONTROL_SEQUENCE_RESYNC_MS  500
+
+#if defined(ARDUINO)
+#include <esp_timer.h>
+#endif
+
+// Задача управления: забирает последний пакет из lock-free слота
+// с фиксированной частотой и управляет сервоприводами.
+// Callback ESP-NOW только кладет пакет в слот и никогда не ждет актуаторы.
+//
+// На хосте задача не создается: tick() вызывает хост-программа.
+class ControlTask {
+public:
+    explicit ControlTask(ServoManager& servoManager);
+
+    bool begin(uint16_t rateHz = CONTROL_TASK_RATE_HZ);
+
+    // Вызывается из callback ESP-NOW (производитель).
+    // Кадр старше уже принятого отбрасывается до слота: не перезаписывает
+    // свежий, не продлевает связь для failsafe и не попадает в update()
+    void submit(const ControlData& data);
+
+    // Один шаг цикла управления (потребитель)
+    void tick();
+
+    // Монопольный доступ к сервоприводам для команд из Serial.
+    // Пока доступ захвачен, тики управления пропускаются
+    void lockActuators();
+    void unlockActuators();
+
+    // Статистика
+    uint16_t getRateHz() const { return rateHz; }
+    uint32_t getTickCount() const { return tickCount; }
+    uint32_t getSkippedTicks() const { return skippedTicks; }
+    uint32_t getMaxJitterUs() const { return maxJitterUs; }
+    const LatencyHistogram& getJitterHistogram() const { return jitterHistogram; }  // Отклонение от периода
+    // Сброс статистики из других задач: выполняет сама задача управления
+    // в начале следующего тика, пока гистограммы никто не пишет
+    void requestJitterReset();  // Вместе со статистикой времени выполнения
+    // Время выполнения тика: запас до периода при стабилизации
+    uint32_t getMaxExecUs() const { return maxExecUs; }
+    const LatencyHistogram& getExecHistogram() const { return execHistogram; }
+    uint32_t getOverruns() const { return overruns; }   // Тиков дольше периода
+    uint32_t getLastLatencyUs() const { return lastLatencyUs; }
+    uint32_t getMaxLatencyUs() const { return maxLatencyUs; }
+    uint32_t getOverwrittenPackets() const { return slot.getOverwrittenCount(); }
+    uint32_t getStalePackets() const { return stalePackets; }    // Дубли и запоздавшие
+    const Failsafe& getFailsafe() const { return failsafe; }
+    void requestStatsReset();
+
+private:
+    ServoManager& servoManager;
+    SpscSlot<ControlData> slot;
+    Failsafe failsafe;
+
+    // Последний принятый номер - пишет только производитель (submit)
+    bool haveSequence = false;
+    uint16_t lastSequence = 0;
+    uint32_t lastAcceptedUs = 0;
+    volatile uint32_t stalePackets = 0;
+
+#if defined(ARDUINO)
+    TaskHandle_t taskHandle = nullptr;
+    SemaphoreHandle_t actuatorMutex = nullptr;
+    esp_timer_handle_t tickTimer = nullptr;
+#endif
+
+    uint32_t configGeneration = 0;      // Версия настроек, примененная в тике
+
+    uint16_t rateHz = CONTROL_TASK_RATE_HZ;
+    uint32_t periodUs = 1000000UL / CONTROL_TASK_RATE_HZ;
+
+    uint32_t tickCount = 0;
+    uint32_t skippedTicks = 0;
+    uint32_t lastTickUs = 0;
+    uint32_t maxJitterUs = 0;
+    LatencyHistogram jitterHistogram;
+    uint32_t maxExecUs = 0;
+    LatencyHistogram execHistogram;
+    uint32_t overruns = 0;
+    uint32_t lastLatencyUs = 0;
+    uint32_t maxLatencyUs = 0;
+    std::atomic<uint8_t> pendingReset{0};   // RESET_* от консоли
+
+    bool tryLockActuators();
+    void applyResetRequest();
+    void applyConfigIfChanged();
+
+#if defined(ARDUINO)
+    static void taskEntry(void* arg);
+    static void onTimer(void* arg);
+#endif
+};
@@ -0,0 +1,118 @@
+#include "Failsafe.h"
+#include "Diagnostics/EventLog.h"
+
+Failsafe::Failsafe() {
+    FailsafeConfig config;
+    makeDefaultConfig(config);
+    applyConfig(config);
+}
+
+void Failsafe::makeDefaultConfig(FailsafeConfig& config) {
+    config.timeoutMs = FAILSAFE_TIMEOUT_MS;
+    config.recoveryMs = FAILSAFE_RECOVERY_MS;
+    config.holdMs = FAILSAFE_HOLD_MS;
+    config.circleRoll = FAILSAFE_CIRCLE_ROLL;
+    config.circlePitch = FAILSAFE_CIRCLE_PITCH;
+    config.circleYaw = FAILSAFE_CIRCLE_YAW;
+    config.mode = FAILSAFE_MODE_GLIDE;
+}
+
+void Failsafe::applyConfig(const FailsafeConfig& config) {
+    timeoutUs = (uint32_t)config.timeoutMs * 1000;
+    recoveryUs = (uint32_t)config.recoveryMs * 1000;
+
+    // Порядок каналов - MixerInput: крен, тангаж, курс, газ, закрылки
+    uint8_t count = 2;
+    if (config.mode == FAILSAFE_MODE_STOP) {
+        // На земле удерживать газ опасно: с первого тика руль прямо, ESC в нейтраль
+        defaultStages[0] = {"STOP", 0, {
+            {FAILSAFE_PRESET, 0}, {FAILSAFE_PRESET, 0}, {FAILSAFE_PRESET, 0},
+            {FAILSAFE_CUT, 0}, {FAILSAFE_HOLD, 0}}};
+        count = 1;
+    } else {
+        // Короткий пропуск: держим последние команды, мотор тоже
+        defaultStages[0] = {"HOLD", 0, {
+            {FAILSAFE_HOLD, 0}, {FAILSAFE_HOLD, 0}, {FAILSAFE_HOLD, 0},
+            {FAILSAFE_HOLD, 0}, {FAILSAFE_HOLD, 0}}};
+        // Связь не вернулась: мотор стоп, пологий круг со снижением
+        defaultStages[1] = {"GLIDE CIRCLE", config.holdMs, {
+            {FAILSAFE_PRESET, config.circleRoll}, {FAILSAFE_PRESET, config.circlePitch},
+            {FAILSAFE_PRESET, config.circleYaw}, {FAILSAFE_CUT, 0}, {FAILSAFE_HOLD, 0}}};
+    }
+
+    if (usingDefaultStages) {
+        stages = defaultStages;
+        stageCount = count;
+        stageIndex = stageIndex < count ? stageIndex : 0;
+    }
+}
+
+void Failsafe::configure(const FailsafeStage* stageTable, uint8_t count) {
+    stages = stageTable;
+    stageCount = count;
+    stageIndex = 0;
+    usingDefaultStages = stageTable == defaultStages;
+}
+
+void Failsafe::onPacket(uint32_t receivedAtUs) {
+    havePacket = true;
+    lastPacketUs = receivedAtUs;
+    if (active && !recovering) {
+        recovering = true;
+        recoveryStartUs = receivedAtUs;
+    }
+}
+
+const FailsafeStage* Failsafe::evaluate(uint32_t nowUs) {
+    if (!havePacket || stageCount == 0) {
+        return nullptr;     // До первого пакета управлять нечем
+    }
+
+    // Пакет мог прийти на другом ядре уже после начала тика - сравнение со знаком
+    const int32_t silenceUs = (int32_t)(nowUs - lastPacketUs);
+
+    if (silenceUs > (int32_t)timeoutUs) {
+        recovering = false;
+        if (!active) {
+            active = true;
+            detectedAtUs = nowUs;
+            stageIndex = 0;
+            activationCount++;
+            if ((uint32_t)silenceUs > maxDetectionUs) {
+                maxDetectionUs = silenceUs;
+            }
+            LOG_EVENT_TEXT(LOG_FAILSAFE_STAGE, stages[0].name, silenceUs / 1000);
+        }
+
+        // Следующая ступень - по времени с момента обнаружения
+        const uint32_t elapsedMs = (nowUs - detectedAtUs) / 1000;
+        while (stageIndex + 1 < stageCount && elapsedMs >= stages[stageIndex + 1].afterMs) {
+            stageIndex++;
+            LOG_EVENT_TEXT(LOG_FAILSAFE_STAGE, stages[stageIndex].name, silenceUs / 1000);
+        }
+    } else if (active && recovering && (int32_t)(nowUs - recoveryStartUs) >= (int32_t)recoveryUs) {
+        active = false;
+        recovering = false;
+        LOG_EVENT(LOG_FAILSAFE_RECOVERED, (int32_t)((nowUs - detectedAtUs) / 1000));
+    }
+
+    return active ? &stages[stageIndex] : nullptr;
+}
+
+void Failsafe::applyStage(const FailsafeStage& stage, const int16_t lastInputs[MIXER_INPUT_COUNT],
+                          int16_t inputs[MIXER_INPUT_COUNT]) {
+    for (uint8_t i = 0; i < MIXER_INPUT_COUNT; i++) {
+        const FailsafeChannel& channel = stage.channels[i];
+        switch (channel.action) {
+            case FAILSAFE_PRESET:
+                inputs[i] = (int16_t)(channel.percent * CURVE_SCALE / 100);
+                break;
+            case FAILSAFE_CUT:
+                inputs[i] = 0;      // Газ: 0 = мотор стоп (у реверсивного ESC - нейтраль)
+                break;
+            default:
+                inputs[i] = lastInputs[i];
+                break;
+        }
+    }
+}
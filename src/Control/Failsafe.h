@@ -0,0 +1,96 @@
+#pragma once
+#include <cstdint>
+#include "Control/Mixer.h"
+#include "Core/FlightConfig.h"
+
+// ============================================================================
+// НАСТРОЙКИ FAILSAFE (значения по умолчанию, меняются через ConfigStore)
+// ============================================================================
+
+// Нет пакетов дольше этого времени -> failsafe (пульт шлет пакет каждые 20 мс).
+// Реакция = таймаут + не более одного периода тика управления
+#define FAILSAFE_TIMEOUT_MS        60
+
+// Гистерезис возврата: связь должна держаться без пропусков столько времени
+#define FAILSAFE_RECOVERY_MS       300
+
+// Сколько удерживать последние команды, прежде чем перейти к планированию
+#define FAILSAFE_HOLD_MS           1000
+
+// Планирование по кругу: команды в % полного хода (знак крена - направление круга)
+#define FAILSAFE_CIRCLE_ROLL       15
+#define FAILSAFE_CIRCLE_PITCH      10
+#define FAILSAFE_CIRCLE_YAW        10
+
+// Стандартные ступени (FailsafeConfig::mode)
+enum FailsafeMode : uint8_t {
+    FAILSAFE_MODE_GLIDE = 0,    // Удержание holdMs, затем мотор стоп и планирование по кругу
+    FAILSAFE_MODE_STOP          // Наземный аппарат: сразу руль прямо, газ в нейтраль
+};
+
+// Действие failsafe для одного входа микшера (канала пульта)
+enum FailsafeAction : uint8_t {
+    FAILSAFE_HOLD = 0,      // Последняя принятая команда
+    FAILSAFE_PRESET,        // Заданное значение, % полного хода
+    FAILSAFE_CUT            // Газ: мотор стоп; остальные каналы - нейтраль
+};
+
+struct FailsafeChannel {
+    uint8_t action;
+    int8_t percent;         // Только для FAILSAFE_PRESET
+};
+
+// Ступень: действует с afterMs после обнаружения потери связи до следующей ступени
+struct FailsafeStage {
+    const char* name;
+    uint16_t afterMs;
+    FailsafeChannel channels[MIXER_INPUT_COUNT];   // Индекс - MixerInput
+};
+
+// Failsafe по отметке времени последнего пакета. Проверяется в каждом тике
+// управления, поэтому не зависит от частоты loop(). Состояние меняется только
+// из тика управления.
+class Failsafe {
+public:
+    Failsafe();
+
+    // Ступени в порядке возрастания afterMs (первая обычно с afterMs = 0)
+    void configure(const FailsafeStage* stages, uint8_t count);
+
+    // Таймауты и стандартные ступени (FailsafeMode) из настроек
+    void applyConfig(const FailsafeConfig& config);
+    static void makeDefaultConfig(FailsafeConfig& config);
+
+    // Принят пакет (время приема из callback радио)
+    void onPacket(uint32_t receivedAtUs);
+
+    // Проверка в тике. Возвращает действующую ступень или nullptr, если связь в норме
+    const FailsafeStage* evaluate(uint32_t nowUs);
+
+    bool isActive() const { return active; }
+    uint32_t getActivationCount() const { return activationCount; }
+    uint32_t getMaxDetectionUs() const { return maxDetectionUs; }
+
+    // Команды ступени поверх последних принятых входов микшера
+    static void applyStage(const FailsafeStage& stage, const int16_t lastInputs[MIXER_INPUT_COUNT],
+                           int16_t inputs[MIXER_INPUT_COUNT]);
+
+private:
+    const FailsafeStage* stages = nullptr;     // Таблица не копируется
+    uint8_t stageCount = 0;
+    FailsafeStage defaultStages[2];             // По FailsafeConfig::mode
+    bool usingDefaultStages = true;
+    uint32_t timeoutUs = (uint32_t)FAILSAFE_TIMEOUT_MS * 1000;
+    uint32_t recoveryUs = (uint32_t)FAILSAFE_RECOVERY_MS * 1000;
+    uint8_t stageIndex = 0;
+
+    bool havePacket = false;
+    bool active = false;
+    bool recovering = false;
+    uint32_t lastPacketUs = 0;
+    uint32_t detectedAtUs = 0;
+    uint32_t recoveryStartUs = 0;
+
+    uint32_t activationCount = 0;
+    uint32_t maxDetectionUs = 0;    // Тишина в эфире на момент срабатывания
+};
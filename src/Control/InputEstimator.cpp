@@ -0,0 +1,68 @@
+#include "InputEstimator.h"
+#include "Communication/ControlFrame.h"
+
+void InputEstimator::addSample(const int16_t inputs[MIXER_INPUT_COUNT], const ControlData& data) {
+    // Интервал: по часам пульта, если они есть в кадре - джиттер приема не влияет на скорость
+    uint32_t interval = 0;
+    if (sampleCount > 0) {
+        if (data.version > 0 && currentVersion > 0) {
+            interval = (uint32_t)((data.senderTimeMs - currentSenderMs) & CONTROL_FRAME_TIME_MASK) * 1000;
+        } else {
+            interval = data.receivedAtUs - currentReceivedUs;
+        }
+        if (interval > (uint32_t)ESTIMATOR_MAX_INTERVAL_MS * 1000) {
+            interval = 0;
+        }
+    }
+
+    for (uint8_t i = 0; i < MIXER_INPUT_COUNT; i++) {
+        previous[i] = sampleCount > 0 ? current[i] : inputs[i];
+        current[i] = inputs[i];
+    }
+    intervalUs = interval;
+    currentReceivedUs = data.receivedAtUs;
+    currentSenderMs = data.senderTimeMs;
+    currentVersion = data.version;
+    if (sampleCount < 2) {
+        sampleCount++;
+    }
+}
+
+void InputEstimator::estimate(uint32_t nowUs, int16_t inputs[MIXER_INPUT_COUNT]) const {
+    // Пакет мог быть принят на другом ядре уже после начала тика
+    int32_t elapsedUs = (int32_t)(nowUs - currentReceivedUs);
+    if (elapsedUs < 0) {
+        elapsedUs = 0;
+    }
+
+    for (uint8_t i = 0; i < MIXER_INPUT_COUNT; i++) {
+        inputs[i] = current[i];
+    }
+
+#if ESTIMATOR_MODE != ESTIMATOR_HOLD
+    if (sampleCount < 2 || intervalUs == 0) {
+        return;     // Скорость неизвестна - удержание
+    }
+
+#if ESTIMATOR_MODE == ESTIMATOR_INTERPOLATE
+    // От предыдущего пакета к текущему за один интервал
+    const int32_t span = elapsedUs < (int32_t)intervalUs ? elapsedUs : (int32_t)intervalUs;
+    for (uint8_t i = 0; i < MIXER_INPUT_COUNT; i++) {
+        if (isEstimated(i)) {
+            inputs[i] = (int16_t)(previous[i] + (int32_t)(current[i] - previous[i]) * span / (int32_t)intervalUs);
+        }
+    }
+#else
+    // Продолжение по скорости, не дальше горизонта
+    const int32_t span = elapsedUs < (int32_t)ESTIMATOR_HORIZON_MS * 1000 ? elapsedUs : (int32_t)ESTIMATOR_HORIZON_MS * 1000;
+    for (uint8_t i = 0; i < MIXER_INPUT_COUNT; i++) {
+        if (isEstimated(i)) {
+            int32_t value = current[i] + (int32_t)(current[i] - previous[i]) * span / (int32_t)intervalUs;
+            if (value > CURVE_SCALE) value = CURVE_SCALE;
+            if (value < -CURVE_SCALE) value = -CURVE_SCALE;
+            inputs[i] = (int16_t)value;
+        }
+    }
+#endif
+#endif
+}
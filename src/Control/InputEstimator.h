@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include "Core/Types.h"
+#include "Control/Mixer.h"
+
+// ============================================================================
+// НАСТРОЙКИ ОЦЕНКИ КОМАНД МЕЖДУ ПАКЕТАМИ
+// ============================================================================
+
+#define ESTIMATOR_HOLD         0    // Команда меняется только с приходом пакета
+#define ESTIMATOR_INTERPOLATE  1    // Плавный переход к новому пакету за один интервал (+1 интервал задержки)
+#define ESTIMATOR_EXTRAPOLATE  2    // Продолжение по скорости двух последних пакетов (без задержки)
+#define ESTIMATOR_MODE  ESTIMATOR_EXTRAPOLATE
+
+// Дальше этого времени после пакета экстраполяция не идет - команда удерживается
+#define ESTIMATOR_HORIZON_MS       40
+
+// Интервал между пакетами больше этого (потери, пауза пульта) - скорость не оценивается
+#define ESTIMATOR_MAX_INTERVAL_MS  100
+
+// Оценка нормированных команд (входов микшера) между пакетами пульта.
+// Пакет приходит с частотой пульта (~50 Гц), а тик управления - 200 Гц: на
+// промежуточных тиках команда интерполируется или экстраполируется по двум
+// последним пакетам. Интервал между пакетами берется из времени отправки
+// (версия кадра >= 1), иначе из времени приема.
+// Дискретные входы (закрылки) не оцениваются.
+class InputEstimator {
+public:
+    // Новый пакет: входы микшера после фильтров и кривых
+    void addSample(const int16_t inputs[MIXER_INPUT_COUNT], const ControlData& data);
+
+    // Команды на момент nowUs
+    void estimate(uint32_t nowUs, int16_t inputs[MIXER_INPUT_COUNT]) const;
+
+    bool hasSample() const { return sampleCount > 0; }
+
+    // Следующий пакет начинает оценку заново (после failsafe)
+    void reset() { sampleCount = 0; }
+
+private:
+    int16_t current[MIXER_INPUT_COUNT] = {};
+    int16_t previous[MIXER_INPUT_COUNT] = {};
+    uint32_t currentReceivedUs = 0;
+    uint32_t intervalUs = 0;            // 0 - скорость неизвестна
+    uint16_t currentSenderMs = 0;
+    uint8_t currentVersion = 0;
+    uint8_t sampleCount = 0;
+
+    static bool isEstimated(uint8_t input) { return input != MIX_IN_FLAPS; }
+};
@@ -0,0 +1,155 @@
+#pragma once
+#include <cstdint>
+#include <type_traits>
+
+// ============================================================================
+// ФИЛЬТРАЦИЯ ОСЕЙ ПУЛЬТА: цепочка ступеней на целых числах
+// ============================================================================
+//
+// Ось (-512..512) проходит через цепочку ступеней до кривой стика. Ступени -
+// параметры шаблона, состояние лежит в самом объекте (без выделений памяти).
+// Выключенная ступень (FilterStage<false, ...>) превращается в PassThrough и
+// после встраивания не стоит ничего.
+//
+//   AxisPipeline<Median3, LowPass<2>, SlewLimit<64>> pitchFilter;
+//   int16_t filtered = pitchFilter.process(data.yAxis1);
+//
+// Каждая ступень: int16_t process(int16_t x) и int16_t reset(int16_t x) -
+// установить состояние "вход давно равен x" и вернуть выход в этом состоянии.
+// Шаг - один принятый пакет.
+
+#define INPUT_AXIS_LIMIT  512
+
+// Пустая ступень
+struct PassThrough {
+    int16_t process(int16_t x) { return x; }
+    int16_t reset(int16_t x) { return x; }
+};
+
+// Медиана трех последних отсчетов: одиночный выброс не проходит дальше
+struct Median3 {
+    int16_t process(int16_t x) {
+        const int16_t a = previous[0];
+        const int16_t b = previous[1];
+        previous[0] = b;
+        previous[1] = x;
+        const int16_t low = a < b ? a : b;
+        const int16_t high = a < b ? b : a;
+        return x < low ? low : (x > high ? high : x);
+    }
+    int16_t reset(int16_t x) { previous[0] = previous[1] = x; return x; }
+
+private:
+    int16_t previous[2] = {};
+};
+
+// Однополюсный ФНЧ: y += (x - y) / 2^Shift. Состояние в Q8, чтобы малые шаги не терялись
+template <uint8_t Shift>
+struct LowPass {
+    static_assert(Shift <= 6, "LowPass: Shift 0..6");
+
+    int16_t process(int16_t x) {
+        state += (((int32_t)x << 8) - state) >> Shift;
+        return (int16_t)((state + 128) >> 8);
+    }
+    int16_t reset(int16_t x) { state = (int32_t)x << 8; return x; }
+
+private:
+    int32_t state = 0;
+};
+
+// Биквад (прямая форма I), коэффициенты в Q14: b0, b1, b2, a1, a2 (a0 = 1)
+template <int16_t B0, int16_t B1, int16_t B2, int16_t A1, int16_t A2>
+struct Biquad {
+    int16_t process(int16_t x) {
+        const int32_t acc = B0 * x + B1 * x1 + B2 * x2 - A1 * y1 - A2 * y2;
+        const int16_t y = (int16_t)((acc + (1 << 13)) >> 14);
+        x2 = x1;
+        x1 = x;
+        y2 = y1;
+        y1 = y;
+        return y;
+    }
+    int16_t reset(int16_t x) { x1 = x2 = y1 = y2 = x; return x; }
+
+private:
+    int32_t x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+};
+
+// Баттерворт 2-го порядка, срез 8 Гц при 50 пакетах/с (единичное усиление на DC)
+typedef Biquad<2381, 4762, 2381, -10994, 4134> Butterworth8Hz50Hz;
+
+// Мертвая зона с растяжением оставшегося хода на весь диапазон
+template <int16_t Width>
+struct Deadzone {
+    static_assert(Width >= 0 && Width < INPUT_AXIS_LIMIT, "Deadzone: 0..511");
+
+    int16_t process(int16_t x) {
+        const int32_t magnitude = x < 0 ? -x : x;
+        if (magnitude <= Width) {
+            return 0;
+        }
+        const int32_t scaled = (magnitude - Width) * INPUT_AXIS_LIMIT / (INPUT_AXIS_LIMIT - Width);
+        return (int16_t)(x < 0 ? -scaled : scaled);
+    }
+    int16_t reset(int16_t x) { return process(x); }
+};
+
+// Ограничение скорости изменения: не больше MaxStep отсчетов за шаг
+template <int16_t MaxStep>
+struct SlewLimit {
+    static_assert(MaxStep > 0, "SlewLimit: MaxStep > 0");
+
+    int16_t process(int16_t x) {
+        int32_t delta = (int32_t)x - last;
+        if (delta > MaxStep) delta = MaxStep;
+        if (delta < -MaxStep) delta = -MaxStep;
+        last = (int16_t)(last + delta);
+        return last;
+    }
+    int16_t reset(int16_t x) { last = x; return x; }
+
+private:
+    int16_t last = 0;
+};
+
+// Ступень, включаемая при компиляции
+template <bool Enabled, typename Stage>
+using FilterStage = typename std::conditional<Enabled, Stage, PassThrough>::type;
+
+// Цепочка ступеней (рекурсия по списку типов, без виртуальных вызовов)
+template <typename... Stages>
+struct StageChain {
+    int16_t process(int16_t x) { return x; }
+    int16_t reset(int16_t x) { return x; }
+};
+
+template <typename First, typename... Rest>
+struct StageChain<First, Rest...> {
+    int16_t process(int16_t x) { return rest.process(stage.process(x)); }
+    int16_t reset(int16_t x) { return rest.reset(stage.reset(x)); }
+
+    First stage;
+    StageChain<Rest...> rest;
+};
+
+// Фильтр одной оси. Первый отсчет инициализирует все ступени - без переходного
+// процесса от нуля после включения
+template <typename... Stages>
+class AxisPipeline {
+public:
+    int16_t process(int16_t x) {
+        if (!primed) {
+            primed = true;
+            return chain.reset(x);
+        }
+        return chain.process(x);
+    }
+
+    // Следующий отсчет заново инициализирует ступени
+    void reset() { primed = false; }
+
+private:
+    StageChain<Stages...> chain;
+    bool primed = false;
+};
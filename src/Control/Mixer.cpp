@@ -0,0 +1,71 @@
+#include "Mixer.h"
+
+void Mixer::configureOutput(uint8_t output, int16_t minValue, int16_t neutralValue, int16_t maxValue,
+                            bool reversed, bool unipolar) {
+    if (output >= MIXER_MAX_OUTPUTS) {
+        return;
+    }
+    minValues[output] = minValue;
+    neutralValues[output] = neutralValue;
+    maxValues[output] = maxValue;
+    directions[output] = reversed ? -1 : 1;
+    unipolarFlags[output] = unipolar;
+    if (output >= outputCount) {
+        outputCount = output + 1;
+    }
+}
+
+void Mixer::setOffset(uint8_t output, int16_t offset) {
+    if (output < MIXER_MAX_OUTPUTS) {
+        offsets[output] = offset;
+    }
+}
+
+void Mixer::setWeight(uint8_t output, uint8_t input, int16_t weightPercent) {
+    if (output < MIXER_MAX_OUTPUTS && input < MIXER_INPUT_COUNT) {
+        weights[input][output] = (int16_t)((int32_t)weightPercent * MIXER_WEIGHT_ONE / 100);
+    }
+}
+
+void Mixer::loadRules(const MixRule* rules, uint8_t count) {
+    clearRules();
+    for (uint8_t i = 0; i < count; i++) {
+        setWeight(rules[i].output, rules[i].input, rules[i].weightPercent);
+    }
+}
+
+void Mixer::clearRules() {
+    for (uint8_t i = 0; i < MIXER_INPUT_COUNT; i++) {
+        for (uint8_t o = 0; o < MIXER_MAX_OUTPUTS; o++) {
+            weights[i][o] = 0;
+        }
+    }
+}
+
+void Mixer::evaluate(const int16_t inputs[MIXER_INPUT_COUNT], int16_t outputs[MIXER_MAX_OUTPUTS]) const {
+    int32_t accumulators[MIXER_MAX_OUTPUTS];
+
+    for (uint8_t o = 0; o < MIXER_MAX_OUTPUTS; o++) {
+        accumulators[o] = (int32_t)offsets[o] * MIXER_WEIGHT_ONE;
+    }
+
+    // Матрица целиком, без ветвлений: компилятор разворачивает/векторизует цикл
+    for (uint8_t i = 0; i < MIXER_INPUT_COUNT; i++) {
+        const int32_t input = inputs[i];
+        for (uint8_t o = 0; o < MIXER_MAX_OUTPUTS; o++) {
+            accumulators[o] += weights[i][o] * input;
+        }
+    }
+
+    for (uint8_t o = 0; o < outputCount; o++) {
+        int32_t mixed = accumulators[o] / MIXER_WEIGHT_ONE * directions[o];
+        if (mixed > CURVE_SCALE) mixed = CURVE_SCALE;
+        if (mixed < -CURVE_SCALE) mixed = -CURVE_SCALE;
+
+        if (unipolarFlags[o] && mixed <= 0) {
+            outputs[o] = minValues[o];
+        } else {
+            outputs[o] = (int16_t)scaleToRange(mixed, minValues[o], neutralValues[o], maxValues[o]);
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include "Control/StickCurve.h"
+
+// ============================================================================
+// МИКШЕР: матрица выходы × входы
+// ============================================================================
+//
+// Входы - нормированные команды ±CURVE_SCALE (после кривых стиков).
+// Каждый выход = сумма (вес × вход) + смещение, затем реверс, ограничение
+// ±CURVE_SCALE и пересчет в диапазон канала min..neutral..max.
+// Веса в фиксированной точке: MIXER_WEIGHT_ONE = 100%.
+//
+// Элевоны, V-хвост, флапероны и т.п. - это другие таблицы правил, а не другой код.
+
+#define MIXER_MAX_OUTPUTS   10
+#define MIXER_WEIGHT_ONE    1024
+
+enum MixerInput {
+    MIX_IN_ROLL = 0,
+    MIX_IN_PITCH,
+    MIX_IN_YAW,
+    MIX_IN_THROTTLE,
+    MIX_IN_FLAPS,
+    MIXER_INPUT_COUNT
+};
+
+// Одно правило матрицы: выход += вход × weightPercent%
+struct MixRule {
+    uint8_t output;
+    uint8_t input;
+    int16_t weightPercent;
+};
+
+class Mixer {
+public:
+    // Диапазон выхода в единицах канала (градусы или микросекунды).
+    // unipolar: при команде <= 0 выход = min (мотор: стоп ниже холостого хода)
+    void configureOutput(uint8_t output, int16_t minValue, int16_t neutralValue, int16_t maxValue,
+                         bool reversed = false, bool unipolar = false);
+    void setOffset(uint8_t output, int16_t offset);
+    void setWeight(uint8_t output, uint8_t input, int16_t weightPercent);
+    void loadRules(const MixRule* rules, uint8_t count);
+    void clearRules();
+
+    // Рассчитать все выходы за один проход
+    void evaluate(const int16_t inputs[MIXER_INPUT_COUNT], int16_t outputs[MIXER_MAX_OUTPUTS]) const;
+
+    uint8_t getOutputCount() const { return outputCount; }
+
+private:
+    // Structure-of-arrays: внутренний цикл идет по выходам подряд
+    int16_t weights[MIXER_INPUT_COUNT][MIXER_MAX_OUTPUTS] = {};
+    int16_t offsets[MIXER_MAX_OUTPUTS] = {};
+    int16_t directions[MIXER_MAX_OUTPUTS] = {};
+    int16_t minValues[MIXER_MAX_OUTPUTS] = {};
+    int16_t neutralValues[MIXER_MAX_OUTPUTS] = {};
+    int16_t maxValues[MIXER_MAX_OUTPUTS] = {};
+    bool unipolarFlags[MIXER_MAX_OUTPUTS] = {};
+    uint8_t outputCount = 0;
+};
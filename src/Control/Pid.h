@@ -0,0 +1,100 @@
+#pragma once
+#include <cstdint>
+
+// ============================================================================
+// ПИД-РЕГУЛЯТОР НА ЦЕЛЫХ ЧИСЛАХ
+// ============================================================================
+//
+// Вход (задание и измерение) и выход - целые отсчеты в единицах вызывающего
+// (стабилизатор: 1/IMU_GYRO_SCALE °/с на входе, 1/CURVE_SCALE хода на выходе).
+// Коэффициенты - в Q<GainShift>:
+//   kp   - отсчетов выхода на отсчет ошибки
+//   ki   - то же за секунду накопления
+//   kd   - то же на отсчет/мс скорости изменения измерения
+//   kff  - упреждение: отсчетов выхода на отсчет задания
+//
+// D - по измерению (скачок задания не дает броска) через ФНЧ y += (x - y) / 2^DtermShift.
+// Защита от насыщения интегратора: интеграл ограничен выходом и не копится
+// в сторону, в которую выход уже уперся в предел.
+//
+// Одно 32-битное деление на шаг (ESP32 делит аппаратно), остальное - умножения и
+// сдвиги; произведения с коэффициентами - в 64 битах, без переполнения при любых
+// входах ±32767 и коэффициентах до 2^16.
+
+template <uint8_t GainShift, uint8_t DtermShift>
+class FixedPid {
+    static_assert(GainShift >= 4 && GainShift <= 12, "FixedPid: GainShift 4..12");
+    static_assert(DtermShift <= 6, "FixedPid: DtermShift 0..6");
+
+public:
+    struct Gains {
+        int32_t kp;
+        int32_t ki;
+        int32_t kd;
+        int32_t kff;
+    };
+
+    void setGains(const Gains& value) { gains = value; }
+    void setOutputLimit(int32_t limit) { outputLimit = limit; }
+
+    // Один шаг. dtUs - время с прошлого шага (вызывающий ограничивает его сверху)
+    int32_t update(int32_t setpoint, int32_t measurement, uint32_t dtUs) {
+        const int32_t error = setpoint - measurement;
+
+        // Скорость изменения измерения, отсчетов/мс в Q4
+        int32_t rate = 0;
+        if (primed && dtUs > 0) {
+            rate = (measurement - lastMeasurement) * (1000 << 4) / (int32_t)dtUs;
+        }
+        lastMeasurement = measurement;
+        primed = true;
+        derivative += (rate - derivative) >> DtermShift;
+
+        const int64_t p = (int64_t)gains.kp * error;
+        const int64_t ff = (int64_t)gains.kff * setpoint;
+        const int64_t d = -(((int64_t)gains.kd * derivative) >> 4);
+        const int64_t proportional = p + ff + d;
+
+        // ki·e·dt/10^6: умножение на 2^32/10^6 и сдвиг вместо деления
+        const int64_t step = ((int64_t)gains.ki * error * dtUs * 4295) >> 32;
+        const int64_t limitQ = (int64_t)outputLimit << GainShift;
+        const int64_t before = proportional + integral;
+        if (!(before >= limitQ && step > 0) && !(before <= -limitQ && step < 0)) {
+            integral += step;
+            if (integral > limitQ) {
+                integral = limitQ;
+            } else if (integral < -limitQ) {
+                integral = -limitQ;
+            }
+        }
+
+        int64_t output = (proportional + integral) >> GainShift;
+        if (output > outputLimit) {
+            output = outputLimit;
+        } else if (output < -outputLimit) {
+            output = -outputLimit;
+        }
+        lastOutput = (int32_t)output;
+        return lastOutput;
+    }
+
+    // Сброс перед включением: без накопленного интеграла и скачка D
+    void reset() {
+        integral = 0;
+        derivative = 0;
+        primed = false;
+        lastOutput = 0;
+    }
+
+    int32_t getIntegral() const { return (int32_t)(integral >> GainShift); }
+    int32_t getLastOutput() const { return lastOutput; }
+
+private:
+    Gains gains = {};
+    int32_t outputLimit = 0;
+    int64_t integral = 0;           // Q<GainShift>, в единицах выхода
+    int32_t derivative = 0;         // Отсчетов/мс в Q4 после ФНЧ
+    int32_t lastMeasurement = 0;
+    int32_t lastOutput = 0;
+    bool primed = false;
+};
@@ -0,0 +1,185 @@
+#include "Stabilizer.h"
+#include <cmath>
+#include "Control/StickCurve.h"
+#include "Diagnostics/EventLog.h"
+
+#define STAB_DEG_PER_RAD  57.29578f
+
+bool Stabilizer::begin() {
+    available = Imu::begin();
+    if (!available) {
+        LOG_EVENT(LOG_IMU_MISSING);
+    }
+    haveSample = false;
+    consecutiveErrors = 0;
+    calibrationCount = 0;
+    reset();
+    return available;
+}
+
+void Stabilizer::applyConfig(const FlightConfig& config) {
+    for (uint8_t i = 0; i < FLIGHT_CONFIG_PID_AXES; i++) {
+        const PidConfig& pid = config.pid[i];
+        pids[i].setGains({pid.kp, pid.ki, pid.kd, pid.kff});
+        pids[i].setOutputLimit(CURVE_SCALE);
+        maxRate[i] = (int32_t)pid.maxRateDps * IMU_GYRO_SCALE;
+    }
+    levelMaxAngle = config.level.maxAngleDeg;
+    levelGainTenths = config.level.gainTenths;
+}
+
+uint8_t Stabilizer::modeFromButtons(uint8_t buttons) {
+    const uint8_t value = (buttons & FLIGHT_MODE_BUTTON_MASK) >> FLIGHT_MODE_BUTTON_SHIFT;
+    return value < FLIGHT_MODE_COUNT ? value : (uint8_t)FLIGHT_MODE_MANUAL;
+}
+
+const char* Stabilizer::getModeName(uint8_t value) {
+    static const char* const NAMES[FLIGHT_MODE_COUNT] = {"MANUAL", "RATE", "ANGLE"};
+    return value < FLIGHT_MODE_COUNT ? NAMES[value] : "?";
+}
+
+void Stabilizer::reset() {
+    for (uint8_t i = 0; i < FLIGHT_CONFIG_PID_AXES; i++) {
+        pids[i].reset();
+    }
+}
+
+float Stabilizer::getRollDeg() const { return roll * STAB_DEG_PER_RAD; }
+float Stabilizer::getPitchDeg() const { return pitch * STAB_DEG_PER_RAD; }
+
+void Stabilizer::sample() {
+    if (!available) {
+        return;
+    }
+    ImuSample sample;
+    if (!Imu::read(sample)) {
+        readErrors++;
+        if (consecutiveErrors < IMU_LOST_READS && ++consecutiveErrors == IMU_LOST_READS) {
+            LOG_EVENT(LOG_IMU_LOST, (int32_t)readErrors);
+        }
+        return;
+    }
+    consecutiveErrors = 0;
+
+    if (!isCalibrated()) {
+        calibrate(sample);
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+        sample.gyro[i] = (int16_t)(sample.gyro[i] - gyroBias[i]);
+    }
+
+    dtUs = haveSample ? sample.timestampUs - last.timestampUs : 0;
+    if (dtUs > STABILIZER_MAX_DT_US) {
+        dtUs = STABILIZER_MAX_DT_US;
+    }
+    last = sample;
+    updateAttitude();
+    haveSample = true;
+}
+
+void Stabilizer::calibrate(const ImuSample& sample) {
+    // Движение - отклонение от первого отсчета окна (смещение нуля само по себе бывает большим)
+    for (uint8_t i = 0; i < 3; i++) {
+        const int32_t deviation = sample.gyro[i] - calibrationFirst[i];
+        if (calibrationCount > 0 && (deviation > IMU_CALIBRATION_MOTION_DPS * IMU_GYRO_SCALE ||
+                                     deviation < -IMU_CALIBRATION_MOTION_DPS * IMU_GYRO_SCALE)) {
+            calibrationCount = 0;   // Самолет двигают - сначала
+        }
+    }
+    if (calibrationCount == 0) {
+        for (uint8_t i = 0; i < 3; i++) {
+            calibrationFirst[i] = sample.gyro[i];
+            calibrationSum[i] = 0;
+        }
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+        calibrationSum[i] += sample.gyro[i];
+    }
+    if (++calibrationCount == IMU_CALIBRATION_SAMPLES) {
+        for (uint8_t i = 0; i < 3; i++) {
+            gyroBias[i] = (int16_t)(calibrationSum[i] / IMU_CALIBRATION_SAMPLES);
+        }
+    }
+}
+
+void Stabilizer::updateAttitude() {
+    const float fx = (float)last.accel[0] / IMU_ACCEL_SCALE;
+    const float fy = (float)last.accel[1] / IMU_ACCEL_SCALE;
+    const float fz = (float)last.accel[2] / IMU_ACCEL_SCALE;
+    const float accelRoll = atan2f(-fy, -fz);
+    const float accelPitch = atan2f(fx, sqrtf(fy * fy + fz * fz));
+
+    if (!haveSample) {
+        roll = accelRoll;
+        pitch = accelPitch;
+        return;
+    }
+
+    // Угловые скорости связанных осей -> производные углов Эйлера
+    const float dt = dtUs * 1e-6f;
+    const float p = (float)last.gyro[0] / (IMU_GYRO_SCALE * STAB_DEG_PER_RAD);
+    const float q = (float)last.gyro[1] / (IMU_GYRO_SCALE * STAB_DEG_PER_RAD);
+    const float r = (float)last.gyro[2] / (IMU_GYRO_SCALE * STAB_DEG_PER_RAD);
+    const float sinRoll = sinf(roll);
+    const float cosRoll = cosf(roll);
+    roll += (p + tanf(pitch) * (q * sinRoll + r * cosRoll)) * dt;
+    pitch += (q * cosRoll - r * sinRoll) * dt;
+
+    // Коррекция по акселерометру - только когда перегрузка около 1 g
+    const float load = fx * fx + fy * fy + fz * fz;
+    if (load > 0.64f && load < 1.44f) {
+        const float weight = dt / ATTITUDE_ACCEL_TIME_S;
+        float rollError = accelRoll - roll;
+        if (rollError > (float)M_PI) {
+            rollError -= 2.0f * (float)M_PI;
+        } else if (rollError < -(float)M_PI) {
+            rollError += 2.0f * (float)M_PI;
+        }
+        roll += rollError * weight;
+        pitch += (accelPitch - pitch) * weight;
+    }
+    if (roll > (float)M_PI) {
+        roll -= 2.0f * (float)M_PI;
+    } else if (roll < -(float)M_PI) {
+        roll += 2.0f * (float)M_PI;
+    }
+}
+
+void Stabilizer::apply(int16_t inputs[MIXER_INPUT_COUNT], uint8_t requestedMode) {
+    const uint8_t target = isHealthy() && isCalibrated() && haveSample ? requestedMode : (uint8_t)FLIGHT_MODE_MANUAL;
+    if (target != mode) {
+        reset();
+        mode = target;
+        LOG_EVENT_TEXT(LOG_FLIGHT_MODE, getModeName(mode));
+    }
+    if (mode == FLIGHT_MODE_MANUAL) {
+        return;
+    }
+
+    // Стик (после кривых и расходов) -> заданная угловая скорость, отсчеты гироскопа
+    static const uint8_t AXIS_INPUTS[FLIGHT_CONFIG_PID_AXES] = {MIX_IN_ROLL, MIX_IN_PITCH, MIX_IN_YAW};
+    int32_t setpoint[FLIGHT_CONFIG_PID_AXES];
+    for (uint8_t i = 0; i < FLIGHT_CONFIG_PID_AXES; i++) {
+        setpoint[i] = (int32_t)inputs[AXIS_INPUTS[i]] * maxRate[i] / CURVE_SCALE;
+    }
+
+    if (mode == FLIGHT_MODE_ANGLE) {
+        // Стик задает угол; ошибка угла -> заданная скорость (не больше максимальной)
+        const float angles[2] = {roll, pitch};
+        for (uint8_t i = 0; i < 2; i++) {
+            const float targetDeg = (float)inputs[AXIS_INPUTS[i]] * levelMaxAngle / CURVE_SCALE;
+            const float errorDeg = targetDeg - angles[i] * STAB_DEG_PER_RAD;
+            int32_t rate = (int32_t)(errorDeg * levelGainTenths * (IMU_GYRO_SCALE / 10.0f));
+            if (rate > maxRate[i]) {
+                rate = maxRate[i];
+            } else if (rate < -maxRate[i]) {
+                rate = -maxRate[i];
+            }
+            setpoint[i] = rate;
+        }
+    }
+
+    for (uint8_t i = 0; i < FLIGHT_CONFIG_PID_AXES; i++) {
+        inputs[AXIS_INPUTS[i]] = (int16_t)pids[i].update(setpoint[i], last.gyro[i], dtUs);
+    }
+}
@@ -0,0 +1,137 @@
+#pragma once
+#include <cstdint>
+#include "HAL/Imu.h"
+#include "Core/FlightConfig.h"
+#include "Control/Mixer.h"
+#include "Control/Pid.h"
+#include "Actuators/AirframeProfile.h"
+
+// ============================================================================
+// НАСТРОЙКИ СТАБИЛИЗАЦИИ
+// ============================================================================
+
+// false - стабилизатор и опрос датчика не компилируются, цикл управления 200 Гц.
+// Профиль без стабилизации (AIRFRAME_STABILIZED, наземные аппараты) выключает его всегда
+#define STABILIZER_ENABLED     (true && AIRFRAME_STABILIZED)
+
+// Частота цикла управления со стабилизацией (ControlTask): шаг ПИД и опрос датчика
+#define STABILIZER_RATE_HZ     500
+
+// Режим полета - биты 1-2 ControlData::buttons (бит 0 - малые расходы)
+#define FLIGHT_MODE_BUTTON_SHIFT  1
+#define FLIGHT_MODE_BUTTON_MASK   0x06
+
+#define PID_GAIN_SHIFT         8    // Коэффициенты ПИД в Q8 (256 = 1.0)
+#define PID_DTERM_LPF_SHIFT    2    // ФНЧ D-составляющей: ~20 Гц при 500 Гц
+
+// Коэффициенты по умолчанию (Q8). Вход ПИД - 1/16 °/с, выход - 1/1024 хода:
+// kp = 64 - четверть отсчета выхода на отсчет ошибки, 100 °/с ошибки -> 40% хода.
+// Подобраны на модели тренера (Host/FlightSim) при 15 м/с
+#define PID_ROLL_KP      96
+#define PID_ROLL_KI      96
+#define PID_ROLL_KD      0
+#define PID_ROLL_KFF     60
+#define PID_PITCH_KP     64
+#define PID_PITCH_KI     128
+#define PID_PITCH_KD     2000
+#define PID_PITCH_KFF    120
+#define PID_YAW_KP       384
+#define PID_YAW_KI       128
+#define PID_YAW_KD       0
+#define PID_YAW_KFF      150
+
+// Заданная угловая скорость на полном стике, °/с
+#define STAB_MAX_RATE_ROLL    180
+#define STAB_MAX_RATE_PITCH   90
+#define STAB_MAX_RATE_YAW     30
+
+// Режим ANGLE: угол на полном стике и заданная скорость на градус ошибки (x10)
+#define LEVEL_MAX_ANGLE       45
+#define LEVEL_GAIN_TENTHS     40
+
+// Оценка крена и тангажа: гироскоп + коррекция по акселерометру с этой
+// постоянной времени. В установившемся вираже акселерометр "видит" горизонт,
+// поэтому постоянная больше длительности обычного разворота
+#define ATTITUDE_ACCEL_TIME_S  5.0f
+
+// Смещение нуля гироскопа: среднее первых отсчетов после включения (самолет неподвижен).
+// Отсчет, отличающийся от первого в окне больше порога, начинает калибровку заново
+#define IMU_CALIBRATION_SAMPLES    512     // ~1 с при 500 Гц
+#define IMU_CALIBRATION_MOTION_DPS 8
+
+// Столько ошибок чтения датчика подряд - стабилизация выключается (MANUAL)
+#define IMU_LOST_READS         5
+
+// Шаг больше этого (пропуск тиков) не раскачивает интеграл и D
+#define STABILIZER_MAX_DT_US   20000
+
+enum FlightMode : uint8_t {
+    FLIGHT_MODE_MANUAL = 0,     // Стики напрямую в микшер
+    FLIGHT_MODE_RATE,           // Стик задает угловую скорость, без стика самолет держит положение
+    FLIGHT_MODE_ANGLE,          // Крен и тангаж: стик задает угол, без стика - горизонт. Курс - как RATE
+    FLIGHT_MODE_COUNT
+};
+
+// Стабилизатор между кривыми стиков и микшером.
+//
+// Каждый тик управления sample() читает датчик и обновляет оценку углов,
+// apply() заменяет команды крена, тангажа и курса выходами ПИД угловой скорости.
+// Знаки: положительная команда оси дает положительную угловую скорость
+// (крен вправо, кабрирование, нос вправо) - реверс выходов задается в микшере.
+//
+// Без датчика, до конца калибровки нуля гироскопа или после IMU_LOST_READS
+// ошибок чтения подряд работает только MANUAL.
+class Stabilizer {
+public:
+    bool begin();
+    void applyConfig(const FlightConfig& config);
+
+    // Каждый тик, до команд
+    void sample();
+
+    // Команды пульта (входы микшера) -> команды поверхностей в режиме mode
+    void apply(int16_t inputs[MIXER_INPUT_COUNT], uint8_t requestedMode);
+
+    // Регуляторы с нуля (после failsafe, при смене режима)
+    void reset();
+
+    static uint8_t modeFromButtons(uint8_t buttons);
+    static const char* getModeName(uint8_t mode);
+
+    bool isAvailable() const { return available; }
+    bool isHealthy() const { return available && consecutiveErrors < IMU_LOST_READS; }
+    bool isCalibrated() const { return calibrationCount >= IMU_CALIBRATION_SAMPLES; }
+    const int16_t* getGyroBias() const { return gyroBias; }
+    uint8_t getMode() const { return mode; }
+    float getRollDeg() const;
+    float getPitchDeg() const;
+    uint32_t getReadErrors() const { return readErrors; }
+    const ImuSample& getLastSample() const { return last; }
+
+private:
+    typedef FixedPid<PID_GAIN_SHIFT, PID_DTERM_LPF_SHIFT> RatePid;
+
+    RatePid pids[FLIGHT_CONFIG_PID_AXES];
+    int32_t maxRate[FLIGHT_CONFIG_PID_AXES] = {};   // Отсчетов гироскопа
+    int32_t levelMaxAngle = LEVEL_MAX_ANGLE;
+    int32_t levelGainTenths = LEVEL_GAIN_TENTHS;
+
+    ImuSample last = {};
+    bool haveSample = false;
+    uint32_t dtUs = 0;
+    float roll = 0.0f;          // Рад
+    float pitch = 0.0f;
+
+    bool available = false;
+    uint8_t consecutiveErrors = 0;
+    uint32_t readErrors = 0;
+    uint8_t mode = FLIGHT_MODE_MANUAL;
+
+    int32_t calibrationSum[3] = {};
+    int16_t calibrationFirst[3] = {};
+    uint16_t calibrationCount = 0;
+    int16_t gyroBias[3] = {};
+
+    void calibrate(const ImuSample& sample);
+    void updateAttitude();
+};
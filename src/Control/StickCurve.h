@@ -0,0 +1,91 @@
+#pragma once
+#include <cstdint>
+
+// ============================================================================
+// КРИВЫЕ СТИКОВ: мертвая зона, экспонента и расходы в одной таблице
+// ============================================================================
+//
+// Таблица индексируется значением оси (-512..511) и возвращает нормированный
+// выход -CURVE_SCALE..+CURVE_SCALE (±100%). Вся математика (мертвая зона
+// с масштабированием, экспонента x*(1-e) + x³*e, расходы) считается один раз
+// при построении таблицы - на горячем пути остается одно индексированное чтение.
+//
+// buildCurveTable() - constexpr: таблицы по умолчанию строит компилятор и
+// кладет во flash, а ту же функцию можно вызвать при загрузке настроек.
+
+#define CURVE_INPUT_MIN   -512
+#define CURVE_INPUT_MAX   511
+#define CURVE_TABLE_SIZE  1024
+#define CURVE_SCALE       1024
+
+struct CurveParams {
+    int16_t deadzone;       // Мертвая зона в отсчетах оси
+    uint8_t expoPercent;    // Экспонента 0-100%
+    uint8_t ratePercent;    // Расход (масштаб полного хода) 0-100%
+    bool unipolar;          // Однополярная ось (газ): ниже мертвой зоны - 0
+};
+
+struct CurveTable {
+    int16_t values[CURVE_TABLE_SIZE];
+
+    int16_t lookup(int16_t axis) const {
+        int32_t index = (int32_t)axis - CURVE_INPUT_MIN;
+        if (index < 0) index = 0;
+        if (index >= CURVE_TABLE_SIZE) index = CURVE_TABLE_SIZE - 1;
+        return values[index];
+    }
+};
+
+constexpr int16_t curvePoint(const CurveParams& params, int32_t axis) {
+    int32_t magnitude = axis < 0 ? -axis : axis;
+    int32_t sign = axis < 0 ? -1 : 1;
+
+    if (params.unipolar) {
+        // Газ: рабочая только положительная половина хода
+        magnitude = axis;
+        sign = 1;
+    }
+
+    if (magnitude <= params.deadzone) {
+        return 0;
+    }
+
+    // Линейная часть после мертвой зоны растягивается на весь ход
+    int32_t x = (magnitude - params.deadzone) * CURVE_SCALE / (CURVE_INPUT_MAX - params.deadzone);
+    if (x > CURVE_SCALE) x = CURVE_SCALE;
+
+    // Экспонента: x*(1-e) + x³*e
+    int32_t cubic = x * x / CURVE_SCALE * x / CURVE_SCALE;
+    int32_t shaped = (x * (100 - params.expoPercent) + cubic * params.expoPercent) / 100;
+
+    // Расходы
+    shaped = shaped * params.ratePercent / 100;
+
+    return (int16_t)(shaped * sign);
+}
+
+// Заполнение на месте: во время работы таблица не проходит через стек (2 КБ)
+constexpr void fillCurveTable(CurveTable& table, CurveParams params) {
+    for (int32_t i = 0; i < CURVE_TABLE_SIZE; i++) {
+        table.values[i] = curvePoint(params, i + CURVE_INPUT_MIN);
+    }
+}
+
+constexpr CurveTable buildCurveTable(CurveParams params) {
+    CurveTable table = {};
+    fillCurveTable(table, params);
+    return table;
+}
+
+constexpr bool sameCurveParams(const CurveParams& a, const CurveParams& b) {
+    return a.deadzone == b.deadzone && a.expoPercent == b.expoPercent &&
+           a.ratePercent == b.ratePercent && a.unipolar == b.unipolar;
+}
+
+// Нормированный выход кривой -> диапазон канала min..neutral..max.
+// Половины хода по обе стороны нейтрали масштабируются независимо
+inline int scaleToRange(int32_t normalized, int minValue, int neutralValue, int maxValue) {
+    return normalized >= 0
+        ? neutralValue + (int)((maxValue - neutralValue) * normalized / CURVE_SCALE)
+        : neutralValue + (int)((neutralValue - minValue) * normalized / CURVE_SCALE);
+}
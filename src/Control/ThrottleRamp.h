@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+#include "Control/StickCurve.h"
+
+// ============================================================================
+// ОГРАНИЧЕНИЕ НАРАСТАНИЯ ГАЗА (наземные профили)
+// ============================================================================
+//
+// Команда газа после кривой (±CURVE_SCALE) растет от нуля не быстрее, чем
+// 0 -> 100% за UpMs (вперед) или BrakeMs (тормоз и реверс). Уменьшение к нулю
+// и смена знака проходят через ноль сразу: сброс газа никогда не задерживается.
+// Шаг - по времени, а не по пакетам: результат не зависит от частоты пульта.
+// UpMs = BrakeMs = 0 - ограничения нет, process() возвращает вход.
+
+template <uint16_t UpMs, uint16_t BrakeMs>
+class ThrottleRamp {
+public:
+    int16_t process(int16_t target, uint32_t nowUs) {
+        if (UpMs == 0 && BrakeMs == 0) {
+            return target;
+        }
+        const uint32_t dtUs = primed ? nowUs - lastUs : 0;
+        lastUs = nowUs;
+        primed = true;
+
+        // Отпускание - сразу; смена направления - сразу до нуля, дальше по рампе
+        const int32_t targetQ8 = (int32_t)target << 8;
+        if ((state > 0 && targetQ8 < state) || (state < 0 && targetQ8 > state)) {
+            state = (state > 0) == (targetQ8 > 0) && targetQ8 != 0 ? targetQ8 : 0;
+        }
+
+        const uint32_t rampUs = (uint32_t)(targetQ8 >= 0 ? UpMs : BrakeMs) * 1000;
+        if (rampUs == 0) {
+            state = targetQ8;
+        } else {
+            // Шаг в Q8: CURVE_SCALE за время рампы
+            const int32_t step = (int32_t)((uint64_t)dtUs * (CURVE_SCALE << 8) / rampUs);
+            if (targetQ8 > state) {
+                state = state + step < targetQ8 ? state + step : targetQ8;
+            } else if (targetQ8 < state) {
+                state = state - step > targetQ8 ? state - step : targetQ8;
+            }
+        }
+        return (int16_t)(state >> 8);
+    }
+
+    // Следующий вызов начинает с value без ограничения (failsafe, отмена теста)
+    void reset(int16_t value = 0) {
+        state = (int32_t)value << 8;
+        primed = false;
+    }
+
+private:
+    int32_t state = 0;      // Q8
+    uint32_t lastUs = 0;
+    bool primed = false;
+};
@@ -0,0 +1,246 @@
+#include "ConfigStore.h"
+#include <cstddef>
+#include <cstring>
+#include "Core/Crc16.h"
+#include "Control/Failsafe.h"
+#include "HAL/Hal.h"
+
+// Флаги отложенного состояния ESC (noteEscState -> service)
+#define ESC_STATE_PENDING     0x80
+#define ESC_STATE_CALIBRATED  0x01
+#define ESC_STATE_ARMED       0x02
+
+uint16_t ConfigStore::computeCrc(const FlightConfig& config) {
+    return Crc16::computeTable(reinterpret_cast<const uint8_t*>(&config), offsetof(FlightConfig, crc));
+}
+
+void ConfigStore::seal(FlightConfig& config) {
+    config.magic = FLIGHT_CONFIG_MAGIC;
+    config.version = FLIGHT_CONFIG_VERSION;
+    config.size = sizeof(FlightConfig);
+    config.padding = 0;
+    config.crc = computeCrc(config);
+}
+
+bool ConfigStore::isValid(const FlightConfig& config) {
+    for (uint8_t i = 0; i < FLIGHT_CONFIG_OUTPUTS; i++) {
+        const OutputConfig& output = config.outputs[i];
+        if (output.minUs > output.neutralUs || output.neutralUs > output.maxUs ||
+            output.minUs < 500 || output.maxUs > 2500) {
+            return false;
+        }
+    }
+    for (uint8_t i = 0; i < FLIGHT_CONFIG_AXES; i++) {
+        if (config.axes[i].deadzone < 0 || config.axes[i].deadzone > 200 || config.axes[i].expoPercent > 100) {
+            return false;
+        }
+    }
+    for (uint8_t i = 0; i < FLIGHT_CONFIG_PID_AXES; i++) {
+        const PidConfig& pid = config.pid[i];
+        if (pid.kp > FLIGHT_CONFIG_PID_GAIN_MAX || pid.ki > FLIGHT_CONFIG_PID_GAIN_MAX ||
+            pid.kd > FLIGHT_CONFIG_PID_GAIN_MAX || pid.kff > FLIGHT_CONFIG_PID_GAIN_MAX ||
+            pid.maxRateDps == 0 || pid.maxRateDps > FLIGHT_CONFIG_PID_RATE_MAX) {
+            return false;
+        }
+    }
+    return config.rateHighPercent <= 100 && config.rateLowPercent <= 100 &&
+           config.failsafe.timeoutMs >= 20 && config.failsafe.recoveryMs <= 10000 &&
+           config.level.maxAngleDeg > 0 && config.level.maxAngleDeg <= 80 && config.level.gainTenths > 0;
+}
+
+ConfigLoadStatus ConfigStore::begin(const FlightConfig& defaultConfig) {
+    const uint32_t startUs = Clock::micros();
+
+    defaults = defaultConfig;
+    seal(defaults);
+
+    // Сразу в активный буфер: одно чтение, без промежуточных копий
+    FlightConfig& target = buffers[0];
+    loadStatus = CONFIG_LOADED;
+    if (!Storage::begin() || !Storage::read(CONFIG_STORAGE_KEY, &target, sizeof(FlightConfig))) {
+        loadStatus = CONFIG_DEFAULT_MISSING;
+    } else if (target.magic != FLIGHT_CONFIG_MAGIC || target.version != FLIGHT_CONFIG_VERSION ||
+               target.size != sizeof(FlightConfig)) {
+        loadStatus = CONFIG_DEFAULT_VERSION;
+    } else if (target.crc != computeCrc(target)) {
+        loadStatus = CONFIG_DEFAULT_CRC;
+    } else if (!isValid(target)) {
+        loadStatus = CONFIG_DEFAULT_INVALID;
+    } else if (target.airframe != defaults.airframe) {
+        loadStatus = CONFIG_DEFAULT_AIRFRAME;
+    }
+
+    if (loadStatus != CONFIG_LOADED) {
+        target = defaults;
+    }
+    buffers[1] = target;
+    activeIndex.store(0, std::memory_order_release);
+    generation.store(1, std::memory_order_release);
+    loadTimeUs = Clock::micros() - startUs;
+    return loadStatus;
+}
+
+FlightConfig* ConfigStore::beginEdit() {
+    if (appliedGeneration.load(std::memory_order_acquire) != generation.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    const uint8_t inactive = activeIndex.load(std::memory_order_relaxed) ^ 1;
+    buffers[inactive] = buffers[inactive ^ 1];
+    return &buffers[inactive];
+}
+
+bool ConfigStore::publish() {
+    const uint8_t inactive = activeIndex.load(std::memory_order_relaxed) ^ 1;
+    if (!isValid(buffers[inactive])) {
+        return false;
+    }
+    seal(buffers[inactive]);
+    activeIndex.store(inactive, std::memory_order_release);
+    generation.fetch_add(1, std::memory_order_acq_rel);
+    dirty = true;
+    return true;
+}
+
+// Значение из консоли проверяется до сужения до типа поля: 300 не должно
+// превратиться в 44 и пройти isValid()
+static bool inRange(int value, int min, int max) {
+    return value >= min && value <= max;
+}
+
+bool ConfigStore::setField(const char* name, int index, int value) {
+    const bool outputIndex = index >= 0 && index < FLIGHT_CONFIG_OUTPUTS;
+    const bool axisIndex = index >= 0 && index < FLIGHT_CONFIG_AXES;
+    const bool pidIndex = index >= 0 && index < FLIGHT_CONFIG_PID_AXES;
+
+    FlightConfig* edit = beginEdit();
+    if (edit == nullptr) {
+        return false;
+    }
+
+    if (strcmp(name, "out_min") == 0 && outputIndex && inRange(value, 500, 2500)) {
+        edit->outputs[index].minUs = (int16_t)value;
+    } else if (strcmp(name, "out_neutral") == 0 && outputIndex && inRange(value, 500, 2500)) {
+        edit->outputs[index].neutralUs = (int16_t)value;
+    } else if (strcmp(name, "out_max") == 0 && outputIndex && inRange(value, 500, 2500)) {
+        edit->outputs[index].maxUs = (int16_t)value;
+    } else if (strcmp(name, "out_rev") == 0 && outputIndex) {
+        edit->outputs[index].reversed = value != 0;
+    } else if (strcmp(name, "deadzone") == 0 && axisIndex && inRange(value, 0, 200)) {
+        edit->axes[index].deadzone = (int16_t)value;
+    } else if (strcmp(name, "expo") == 0 && axisIndex && inRange(value, 0, 100)) {
+        edit->axes[index].expoPercent = (uint8_t)value;
+    } else if (strcmp(name, "rate_high") == 0 && inRange(value, 0, 100)) {
+        edit->rateHighPercent = (uint8_t)value;
+    } else if (strcmp(name, "rate_low") == 0 && inRange(value, 0, 100)) {
+        edit->rateLowPercent = (uint8_t)value;
+    } else if (strcmp(name, "pid_p") == 0 && pidIndex && inRange(value, 0, FLIGHT_CONFIG_PID_GAIN_MAX)) {
+        edit->pid[index].kp = (uint16_t)value;
+    } else if (strcmp(name, "pid_i") == 0 && pidIndex && inRange(value, 0, FLIGHT_CONFIG_PID_GAIN_MAX)) {
+        edit->pid[index].ki = (uint16_t)value;
+    } else if (strcmp(name, "pid_d") == 0 && pidIndex && inRange(value, 0, FLIGHT_CONFIG_PID_GAIN_MAX)) {
+        edit->pid[index].kd = (uint16_t)value;
+    } else if (strcmp(name, "pid_ff") == 0 && pidIndex && inRange(value, 0, FLIGHT_CONFIG_PID_GAIN_MAX)) {
+        edit->pid[index].kff = (uint16_t)value;
+    } else if (strcmp(name, "pid_rate") == 0 && pidIndex && inRange(value, 1, FLIGHT_CONFIG_PID_RATE_MAX)) {
+        edit->pid[index].maxRateDps = (uint16_t)value;
+    } else if (strcmp(name, "level_angle") == 0 && inRange(value, 1, 80)) {
+        edit->level.maxAngleDeg = (uint8_t)value;
+    } else if (strcmp(name, "level_gain") == 0 && inRange(value, 1, UINT8_MAX)) {
+        edit->level.gainTenths = (uint8_t)value;
+    } else if (strcmp(name, "fs_timeout") == 0 && inRange(value, 20, UINT16_MAX)) {
+        edit->failsafe.timeoutMs = (uint16_t)value;
+    } else if (strcmp(name, "fs_recovery") == 0 && inRange(value, 0, 10000)) {
+        edit->failsafe.recoveryMs = (uint16_t)value;
+    } else if (strcmp(name, "fs_hold") == 0 && inRange(value, 0, UINT16_MAX)) {
+        edit->failsafe.holdMs = (uint16_t)value;
+    } else if (strcmp(name, "fs_roll") == 0 && inRange(value, -100, 100)) {
+        edit->failsafe.circleRoll = (int8_t)value;
+    } else if (strcmp(name, "fs_pitch") == 0 && inRange(value, -100, 100)) {
+        edit->failsafe.circlePitch = (int8_t)value;
+    } else if (strcmp(name, "fs_yaw") == 0 && inRange(value, -100, 100)) {
+        edit->failsafe.circleYaw = (int8_t)value;
+    } else {
+        return false;
+    }
+    return publish();
+}
+
+bool ConfigStore::resetToDefaults() {
+    FlightConfig* edit = beginEdit();
+    if (edit == nullptr) {
+        return false;
+    }
+    // Состояние ESC - не настройка, а факт: его не сбрасываем
+    const EscConfig esc = edit->esc;
+    *edit = defaults;
+    edit->esc.calibrated = esc.calibrated;
+    edit->esc.armed = esc.armed;
+    return publish();
+}
+
+void ConfigStore::noteEscState(bool calibrated, bool armed) {
+    pendingEsc.store(ESC_STATE_PENDING | (calibrated ? ESC_STATE_CALIBRATED : 0) | (armed ? ESC_STATE_ARMED : 0),
+                     std::memory_order_release);
+}
+
+void ConfigStore::service() {
+    const uint8_t esc = pendingEsc.load(std::memory_order_acquire);
+    if (esc & ESC_STATE_PENDING) {
+        const bool calibrated = (esc & ESC_STATE_CALIBRATED) != 0;
+        const bool armed = (esc & ESC_STATE_ARMED) != 0;
+        if (active().esc.calibrated == calibrated && active().esc.armed == armed) {
+            // Уже сохранено; новое состояние, пришедшее за это время, не теряется
+            uint8_t expected = esc;
+            pendingEsc.compare_exchange_strong(expected, 0);
+        } else {
+            FlightConfig* edit = beginEdit();
+            if (edit != nullptr) {
+                edit->esc.calibrated = calibrated;
+                edit->esc.armed = armed;
+                publish();
+            }
+        }
+    }
+
+    if (dirty) {
+        if (Storage::write(CONFIG_STORAGE_KEY, &active(), sizeof(FlightConfig))) {
+            dirty = false;
+        }
+    }
+}
+
+void ConfigStore::print() const {
+    static const char* const LOAD_STATUS[] = {"NVS", "defaults (empty)", "defaults (version)",
+                                              "defaults (CRC)", "defaults (invalid)", "defaults (airframe)"};
+    const FlightConfig& config = active();
+
+    console.printf("⚙️  Config v%u, %u bytes, source: %s, load %lu us\n",
+                   (unsigned)FLIGHT_CONFIG_VERSION, (unsigned)sizeof(FlightConfig),
+                   LOAD_STATUS[loadStatus], (unsigned long)loadTimeUs);
+    for (uint8_t i = 0; i < FLIGHT_CONFIG_OUTPUTS; i++) {
+        const OutputConfig& output = config.outputs[i];
+        console.printf("  out %u: %d / %d / %d us%s\n", i, output.minUs, output.neutralUs, output.maxUs,
+                       output.reversed ? " (rev)" : "");
+    }
+    for (uint8_t i = 0; i < FLIGHT_CONFIG_AXES; i++) {
+        console.printf("  axis %u: deadzone %d, expo %u%%\n", i, config.axes[i].deadzone, config.axes[i].expoPercent);
+    }
+    console.printf("  rates: high %u%%, low %u%%\n", config.rateHighPercent, config.rateLowPercent);
+    if (config.failsafe.mode == FAILSAFE_MODE_STOP) {
+        console.printf("  failsafe: timeout %u ms, recovery %u ms, stop at once\n",
+                       config.failsafe.timeoutMs, config.failsafe.recoveryMs);
+    } else {
+        console.printf("  failsafe: timeout %u ms, recovery %u ms, hold %u ms, circle %d/%d/%d%%\n",
+                       config.failsafe.timeoutMs, config.failsafe.recoveryMs, config.failsafe.holdMs,
+                       config.failsafe.circleRoll, config.failsafe.circlePitch, config.failsafe.circleYaw);
+    }
+    for (uint8_t i = 0; i < FLIGHT_CONFIG_PID_AXES; i++) {
+        const PidConfig& pid = config.pid[i];
+        console.printf("  pid %u: P %u, I %u, D %u, FF %u (Q8), rate %u deg/s\n", i, pid.kp, pid.ki, pid.kd,
+                       pid.kff, pid.maxRateDps);
+    }
+    console.printf("  level: max angle %u deg, gain %u.%u\n", config.level.maxAngleDeg,
+                   config.level.gainTenths / 10, config.level.gainTenths % 10);
+    console.printf("  ESC: calibrated %s, armed %s\n",
+                   config.esc.calibrated ? "YES" : "NO", config.esc.armed ? "YES" : "NO");
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include "Core/FlightConfig.h"
+
+#define CONFIG_STORAGE_KEY  "config"
+
+enum ConfigLoadStatus {
+    CONFIG_LOADED = 0,          // Блок из NVS
+    CONFIG_DEFAULT_MISSING,     // В NVS ничего нет (первый запуск)
+    CONFIG_DEFAULT_VERSION,     // Другая версия или размер блока
+    CONFIG_DEFAULT_CRC,         // Блок поврежден
+    CONFIG_DEFAULT_INVALID,     // CRC верен, но значения вне допустимых
+    CONFIG_DEFAULT_AIRFRAME     // Настройки другого профиля аппарата (другие выходы)
+};
+
+// Хранилище настроек с двойной буферизацией.
+//
+// Читатель - задача управления: берет active() и применяет его, когда меняется
+// getGeneration(), после чего вызывает acknowledge(). Писатель - loop()/консоль:
+// правит неактивную копию и публикует ее одной атомарной сменой индекса,
+// поэтому тик никогда не видит наполовину измененный блок. Следующая правка
+// разрешена только после того, как читатель подтвердил предыдущую.
+//
+// В NVS блок пишет service() из loop(): запись flash не попадает в тик.
+class ConfigStore {
+public:
+    static ConfigStore& getInstance() {
+        static ConfigStore instance;
+        return instance;
+    }
+
+    // Одно чтение блока из NVS. При любой ошибке - значения по умолчанию
+    ConfigLoadStatus begin(const FlightConfig& defaults);
+
+    const FlightConfig& active() const { return buffers[activeIndex.load(std::memory_order_acquire)]; }
+    uint32_t getGeneration() const { return generation.load(std::memory_order_acquire); }
+    void acknowledge(uint32_t appliedGen) { appliedGeneration.store(appliedGen, std::memory_order_release); }
+
+    // Писатель: копия активного блока для правки или nullptr, если читатель
+    // еще не применил предыдущую версию
+    FlightConfig* beginEdit();
+    bool publish();     // false - значения недопустимы, правка отброшена
+
+    // Консоль: "out_min 0 1000" и т.п. (см. ConfigStore.cpp)
+    bool setField(const char* name, int index, int value);
+    bool resetToDefaults();
+
+    // Из любого контекста (тик управления): сохранить состояние ESC при следующем service()
+    void noteEscState(bool calibrated, bool armed);
+
+    // Из loop(): применить отложенные изменения и записать блок в NVS
+    void service();
+
+    void print() const;
+    ConfigLoadStatus getLoadStatus() const { return loadStatus; }
+    uint32_t getLoadTimeUs() const { return loadTimeUs; }
+
+    static bool isValid(const FlightConfig& config);
+
+private:
+    FlightConfig buffers[2] = {};
+    FlightConfig defaults = {};
+    std::atomic<uint8_t> activeIndex{0};
+    std::atomic<uint32_t> generation{0};
+    std::atomic<uint32_t> appliedGeneration{0};
+    std::atomic<uint8_t> pendingEsc{0};
+    bool dirty = false;
+    ConfigLoadStatus loadStatus = CONFIG_DEFAULT_MISSING;
+    uint32_t loadTimeUs = 0;
+
+    static uint16_t computeCrc(const FlightConfig& config);
+    static void seal(FlightConfig& config);
+
+    ConfigStore() = default;
+};
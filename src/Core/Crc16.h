@@ -0,0 +1,94 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Использовать crc16_le из ROM ESP32 вместо табличной реализации
+#ifndef CRC16_USE_ROM
+#define CRC16_USE_ROM false
+#endif
+
+#if defined(ARDUINO) && CRC16_USE_ROM
+#include <rom/crc.h>
+#endif
+
+#define CRC16_POLY_REFLECTED 0x8408
+
+struct Crc16Table {
+    uint16_t entries[256];
+};
+
+constexpr uint16_t crc16UpdateByte(uint16_t crc, uint8_t byte) {
+    crc ^= byte;
+    for (int bit = 0; bit < 8; bit++) {
+        crc = (crc & 1) ? (crc >> 1) ^ CRC16_POLY_REFLECTED : crc >> 1;
+    }
+    return crc;
+}
+
+constexpr Crc16Table crc16MakeTable() {
+    Crc16Table result = {};
+    for (int i = 0; i < 256; i++) {
+        result.entries[i] = crc16UpdateByte(0, (uint8_t)i);
+    }
+    return result;
+}
+
+static_assert(crc16MakeTable().entries[1] == 0x1189, "CRC-16 table mismatch");
+static_assert(crc16MakeTable().entries[128] == 0x8408, "CRC-16 table mismatch");
+
+// CRC-16/CCITT в варианте X-25 (полином 0x1021 отраженный, init 0xFFFF, xorout 0xFFFF).
+// Вариант выбран так, чтобы совпадать с crc16_le(0, ...) из ROM ESP32 -
+// приемник и передатчик могут считать его любым способом.
+//
+// Заголовочный файл без зависимостей - подключается и в прошивку пульта.
+class Crc16 {
+public:
+    static const uint16_t INIT = 0xFFFF;
+    static const uint16_t XOR_OUT = 0xFFFF;
+
+    // Основная функция - используется при приеме и передаче
+    static uint16_t compute(const uint8_t* data, size_t len) {
+#if defined(ARDUINO) && CRC16_USE_ROM
+        return computeRom(data, len);
+#else
+        return computeTable(data, len);
+#endif
+    }
+
+    // Табличная реализация: один lookup на байт
+    static uint16_t computeTable(const uint8_t* data, size_t len) {
+        uint16_t crc = INIT;
+        for (size_t i = 0; i < len; i++) {
+            crc = (crc >> 8) ^ table.entries[(crc ^ data[i]) & 0xFF];
+        }
+        return crc ^ XOR_OUT;
+    }
+
+    // Побитовая реализация (эталон для проверки и бенчмарка)
+    static uint16_t computeBitwise(const uint8_t* data, size_t len) {
+        uint16_t crc = INIT;
+        for (size_t i = 0; i < len; i++) {
+            crc = crc16UpdateByte(crc, data[i]);
+        }
+        return crc ^ XOR_OUT;
+    }
+
+#if defined(ARDUINO) && CRC16_USE_ROM
+    static uint16_t computeRom(const uint8_t* data, size_t len) {
+        return crc16_le(0, data, len);
+    }
+#endif
+
+    // Старая аддитивная сумма байтов (только для сравнения в бенчмарке)
+    static uint16_t legacySum(const uint8_t* data, size_t len) {
+        uint16_t sum = 0;
+        for (size_t i = 0; i < len; i++) {
+            sum += data[i];
+        }
+        return sum;
+    }
+
+private:
+    // Таблица строится компилятором и лежит во flash
+    static constexpr Crc16Table table = crc16MakeTable();
+};
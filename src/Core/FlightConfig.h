@@ -0,0 +1,92 @@
+#pragma once
+#include <cstdint>
+
+// ============================================================================
+// НАСТРОЙКИ, КОТОРЫЕ МЕНЯЮТСЯ БЕЗ ПЕРЕПРОШИВКИ
+// ============================================================================
+//
+// Один блок фиксированного размера: читается из NVS одним вызовом и сразу
+// используется как есть. Значения по умолчанию - ServoManager::makeDefaultConfig()
+// (из констант и #define в ServoManager.h / Failsafe.h).
+//
+// При любом изменении состава полей увеличьте FLIGHT_CONFIG_VERSION:
+// блок старой версии не загружается, вместо него берутся значения по умолчанию.
+
+#define FLIGHT_CONFIG_VERSION       4
+#define FLIGHT_CONFIG_MAGIC         0x47464346UL    // "FCFG"
+#define FLIGHT_CONFIG_OUTPUTS       10              // = MIXER_MAX_OUTPUTS
+#define FLIGHT_CONFIG_AXES          4               // Крен, тангаж, курс, газ (порядок MixerInput)
+#define FLIGHT_CONFIG_PID_AXES      3               // Крен, тангаж, курс
+#define FLIGHT_CONFIG_PID_GAIN_MAX  4095            // Коэффициент ПИД до 16.0 (Q8)
+#define FLIGHT_CONFIG_PID_RATE_MAX  1000            // °/с
+
+// Выход микшера: диапазон в микросекундах и реверс.
+// Для мотора neutralUs - холостой ход (первый импульс после мертвой зоны газа)
+struct OutputConfig {
+    int16_t minUs;
+    int16_t neutralUs;
+    int16_t maxUs;
+    uint8_t reversed;
+    uint8_t reserved;
+};
+
+// Ось пульта: параметры кривой
+struct AxisConfig {
+    int16_t deadzone;
+    uint8_t expoPercent;
+    uint8_t reserved;
+};
+
+struct FailsafeConfig {
+    uint16_t timeoutMs;
+    uint16_t recoveryMs;
+    uint16_t holdMs;        // Удержание до перехода к планированию
+    int8_t circleRoll;      // Планирование: команды в % хода
+    int8_t circlePitch;
+    int8_t circleYaw;
+    uint8_t mode;           // FailsafeMode (Control/Failsafe.h) - задает профиль аппарата
+};
+
+// ПИД угловой скорости одной оси (Control/Pid.h), коэффициенты в Q8
+struct PidConfig {
+    uint16_t kp;
+    uint16_t ki;
+    uint16_t kd;
+    uint16_t kff;
+    uint16_t maxRateDps;    // Заданная скорость на полном стике (режимы RATE и ANGLE)
+    uint16_t reserved;
+};
+
+// Режим ANGLE: угол на полном стике и жесткость возврата к нему
+struct LevelConfig {
+    uint8_t maxAngleDeg;
+    uint8_t gainTenths;     // Заданная скорость (°/с) на градус ошибки угла, x10
+    uint16_t reserved;
+};
+
+// Состояние ESC: нужно быстрой загрузке после сброса в полете
+struct EscConfig {
+    uint8_t calibrated;     // Калибровка диапазона газа выполнена
+    uint8_t armed;          // ESC был вооружен на момент последнего сохранения
+    uint16_t reserved;
+};
+
+struct FlightConfig {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;
+
+    OutputConfig outputs[FLIGHT_CONFIG_OUTPUTS];
+    AxisConfig axes[FLIGHT_CONFIG_AXES];
+    uint8_t rateHighPercent;
+    uint8_t rateLowPercent;
+    uint8_t airframe;       // AIRFRAME_PROFILE: блок другого аппарата не загружается
+    uint8_t reserved;
+    FailsafeConfig failsafe;
+    EscConfig esc;
+    PidConfig pid[FLIGHT_CONFIG_PID_AXES];
+    LevelConfig level;
+
+    uint16_t crc;           // CRC-16/X-25 всего блока до этого поля
+    uint16_t padding;
+};
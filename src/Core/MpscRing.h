@@ -0,0 +1,73 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Lock-free кольцевой буфер для нескольких писателей и одного читателя
+// (ограниченная очередь с номером последовательности в каждой ячейке).
+// Писатель никогда не ждет: если буфер полон, запись отбрасывается и считается.
+//
+// Писатели - callback ESP-NOW, задача управления, loop(); читатель - фоновая задача.
+template <typename T, uint32_t Capacity>
+class MpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    MpscRing() {
+        for (uint32_t i = 0; i < Capacity; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // Из любого контекста. Возвращает false, если буфер полон
+    bool push(const T& value) {
+        uint32_t position = head.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[position & MASK];
+            const uint32_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const int32_t diff = (int32_t)(sequence - position);
+
+            if (diff == 0) {
+                // Ячейка свободна - занимаем позицию
+                if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                position = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Только читатель. Возвращает false, если готовых записей нет
+    bool pop(T& out) {
+        Cell& cell = cells[tail & MASK];
+        const uint32_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != tail + 1) {
+            return false;
+        }
+        out = cell.value;
+        cell.sequence.store(tail + Capacity, std::memory_order_release);
+        tail++;
+        return true;
+    }
+
+    // Сколько записей отброшено из-за переполнения (сбрасывается при чтении)
+    uint32_t takeDropped() { return dropped.exchange(0, std::memory_order_relaxed); }
+
+private:
+    static const uint32_t MASK = Capacity - 1;
+
+    struct Cell {
+        std::atomic<uint32_t> sequence;
+        T value;
+    };
+
+    Cell cells[Capacity];
+    std::atomic<uint32_t> head{0};
+    uint32_t tail = 0;
+    std::atomic<uint32_t> dropped{0};
+};
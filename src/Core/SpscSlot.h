@@ -0,0 +1,48 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Lock-free слот "последнего значения" для одного писателя и одного читателя
+// (тройной буфер). Писатель никогда не ждет читателя: если читатель не успел
+// забрать значение, оно просто заменяется более свежим.
+//
+// Писатель - callback ESP-NOW (WiFi task), читатель - задача управления.
+template <typename T>
+class SpscSlot {
+public:
+    // Вызывается только писателем
+    void publish(const T& value) {
+        buffers[writeIndex] = value;
+        uint8_t previous = middle.exchange(writeIndex | FRESH_FLAG, std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+        if (previous & FRESH_FLAG) {
+            overwritten.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Вызывается только читателем. Возвращает false, если нового значения нет
+    bool consume(T& out) {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH_FLAG)) {
+            return false;
+        }
+        uint8_t previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+        out = buffers[readIndex];
+        return true;
+    }
+
+    bool hasFresh() const { return middle.load(std::memory_order_relaxed) & FRESH_FLAG; }
+
+    // Сколько значений было заменено до того, как читатель их забрал
+    uint32_t getOverwrittenCount() const { return overwritten.load(std::memory_order_relaxed); }
+
+private:
+    static const uint8_t INDEX_MASK = 0x03;
+    static const uint8_t FRESH_FLAG = 0x04;
+
+    T buffers[3];
+    std::atomic<uint8_t> middle{1};
+    std::atomic<uint32_t> overwritten{0};
+    uint8_t writeIndex = 0;   // Принадлежит писателю
+    uint8_t readIndex = 2;    // Принадлежит читателю
+};
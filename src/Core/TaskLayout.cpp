@@ -0,0 +1,51 @@
+#include "TaskLayout.h"
+#include "HAL/Hal.h"
+
+#if defined(ARDUINO)
+
+static TaskHandle_t taskHandles[TASK_COUNT] = {};
+static int8_t taskCores[TASK_COUNT] = {};
+
+bool startTask(TaskId id, TaskFunction_t entry, void* arg, TaskHandle_t* handle, int8_t core) {
+    const TaskSpec& spec = TASK_LAYOUT[id];
+    const int8_t targetCore = core < 0 ? (int8_t)spec.core : core;
+    TaskHandle_t created = nullptr;
+    if (xTaskCreatePinnedToCore(entry, spec.name, spec.stackSize, arg, spec.priority,
+                                &created, targetCore) != pdPASS) {
+        console.printf("❌ Task %s: не удалось создать\n", spec.name);
+        return false;
+    }
+    taskHandles[id] = created;
+    taskCores[id] = targetCore;
+    if (handle != nullptr) {
+        *handle = created;
+    }
+    return true;
+}
+
+void endTask(TaskId id) {
+    taskHandles[id] = nullptr;
+    vTaskDelete(nullptr);
+}
+
+void printTaskLayout() {
+    console.println("  Task        core  prio  stack  free");
+    for (uint8_t i = 0; i < TASK_COUNT; i++) {
+        const TaskSpec& spec = TASK_LAYOUT[i];
+        if (taskHandles[i] == nullptr) {
+            console.printf("  %-10s     %u  %4u  %5u     -\n", spec.name, spec.core, spec.priority, spec.stackSize);
+            continue;
+        }
+        // Свободный минимум стека за все время работы задачи
+        console.printf("  %-10s     %d  %4u  %5u  %4u\n", spec.name, taskCores[i], spec.priority, spec.stackSize,
+                       (unsigned)uxTaskGetStackHighWaterMark(taskHandles[i]));
+    }
+}
+
+#else
+
+void printTaskLayout() {
+    console.println("  Task layout: host build runs everything in one thread");
+}
+
+#endif
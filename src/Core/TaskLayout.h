@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+
+// ============================================================================
+// РАСКЛАДКА ЗАДАЧ ПО ЯДРАМ
+// ============================================================================
+//
+// Ядро 0 (протокольное): WiFi/ESP-NOW и callback приема, esp_timer, журнал,
+// консоль и телеметрия. Ядро 1 (прикладное): только задача управления -
+// ее тик не делит ядро с прерываниями WiFi и выводом в UART.
+//
+// Задачи WiFi (приоритет 23) и esp_timer (22) создает ESP-IDF на ядре 0
+// (CONFIG_ESP32_WIFI_TASK_CORE_ID, CONFIG_ESP_TIMER_TASK_AFFINITY), здесь они не
+// настраиваются. Arduino loop() после setup() удаляет себя.
+
+#define PROTOCOL_CORE       0
+#define APPLICATION_CORE    1
+
+enum TaskId : uint8_t {
+    TASK_CONTROL = 0,
+    TASK_EVENT_LOG,
+    TASK_CONSOLE,
+    TASK_LOAD_TEST,
+    TASK_COUNT
+};
+
+struct TaskSpec {
+    const char* name;
+    uint8_t core;
+    uint8_t priority;
+    uint16_t stackSize;     // Байт
+};
+
+// Единственное место, где задаются ядро, приоритет и стек задач
+static constexpr TaskSpec TASK_LAYOUT[TASK_COUNT] = {
+    //  имя          ядро              приор.  стек
+    {"control",  APPLICATION_CORE,    20,   4096},  // Тик управления от esp_timer
+    {"eventlog", PROTOCOL_CORE,        1,   3072},  // Вывод журнала событий
+    {"console",  PROTOCOL_CORE,        2,   8192},  // Команды Serial, статистика связи, запись NVS (бывший loop())
+    {"load",     PROTOCOL_CORE,        1,   3072},  // Нагрузка теста джиттера (ядро задает тест)
+};
+
+static_assert(TASK_LAYOUT[TASK_CONTROL].core != PROTOCOL_CORE, "Control must not share the core with WiFi");
+static_assert(TASK_LAYOUT[TASK_CONTROL].priority > TASK_LAYOUT[TASK_CONSOLE].priority,
+              "Control must preempt console work");
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+
+// Создать задачу по таблице. core < 0 - ядро из таблицы
+bool startTask(TaskId id, TaskFunction_t entry, void* arg, TaskHandle_t* handle = nullptr, int8_t core = -1);
+
+// Завершить текущую задачу (вызывается из нее самой)
+void endTask(TaskId id);
+#endif
+
+// Таблица и свободный стек запущенных задач
+void printTaskLayout();
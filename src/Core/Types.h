@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdint>
 
+// Команда управления после разбора кадра (см. Communication/ControlFrame.h)
 struct ControlData {
     int16_t xAxis1;     // Ось X первого джойстика (-512 до +512) - РУЛЬ НАПРАВЛЕНИЯ
     int16_t yAxis1;     // Ось Y первого джойстика (-512 до +512) - РУЛЬ ВЫСОТЫ
@@ -9,19 +10,16 @@ struct ControlData {
     bool button1;       // Кнопка первого джойстика
     bool button2;       // Кнопка второго джойстика
     uint8_t buttons;    // Дополнительные кнопки (битовая маска)
-    uint16_t crc;       // Контрольная сумма
+    uint8_t version;    // Версия формата кадра (0 - старый формат)
+    uint16_t sequence;      // Номер пакета (0 в старом формате)
+    uint16_t senderTimeMs;  // Время отправки по часам пульта, мс по модулю 2^14
+    uint32_t receivedAtUs;  // Момент приема кадра (Clock::micros)
 };
 
+// Пины платы. Пины выходов (сервоприводы, ESC) - в профиле аппарата
+// (Actuators/AirframeProfile.h), там же проверка, что они не пересекаются с этими
 struct HardwareConfig {
-    // Основные пины для самолета
-    static const uint8_t L_ELEVATOR_PIN = 13;
-    static const uint8_t R_ELEVATOR_PIN = 32;       // Сервопривод руля высоты
-    static const uint8_t L_RUDDER_PIN = 14;         // Сервопривод руля направления
-    static const uint8_t R_RUDDER_PIN = 16;
-    static const uint8_t L_AILERON_PIN = 27;        // Левый элерон
-    static const uint8_t R_AILERON_PIN = 26;        // Правый элерон
-    static const uint8_t L_FLAPS_PIN = 33;          // Закрылки (дополнительный сервопривод)
-    static const uint8_t R_FLAPS_PIN = 25;          // НОВЫЙ сервопривод на пине 25
-    static const uint8_t MOTOR_PIN = 17;            // Двигатель (PWM)
     static const uint8_t LED_PIN = 2;               // Индикация состояния связи
+    static const uint8_t IMU_SDA_PIN = 21;          // I2C датчика (MPU6050)
+    static const uint8_t IMU_SCL_PIN = 22;
 };
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include "EventLog.h"
+#include "HAL/Hal.h"
+#include "Core/TaskLayout.h"
+
+// Формат вывода каждого события. hasText: первым аргументом идет строка записи
+struct LogEventFormat {
+    const char* format;
+    bool hasText;
+};
+
+static const LogEventFormat EVENT_FORMATS[LOG_EVENT_COUNT] = {
+    /* LOG_TEXT              */ {"%s\n", true},
+    /* LOG_FRAME_BAD_LENGTH  */ {"❌ Неверный пакет: %ld байт\n", false},
+    /* LOG_FRAME_BAD_VERSION */ {"❌ Неизвестная версия кадра: %ld\n", false},
+    /* LOG_LINK_UP           */ {"📶 Связь с пультом УСТАНОВЛЕНА\n", false},
+    /* LOG_LINK_DOWN         */ {"📶 Связь с пультом ПОТЕРЯНА\n", false},
+    /* LOG_LINK_STATS        */ {"📡 ESP-NOW: %ld packets/30sec, lost %ld, CRC %ld | jitter %ld us | RSSI: %ld\n", false},
+    /* LOG_MOTOR_OUTPUT      */ {"🎮 Motor: %ldμs (%ld%%), Joy: %ld\n", false},
+    /* LOG_MOTOR_SAFETY_STOP */ {"🛡️ First motor update - SAFETY STOP\n", false},
+    /* LOG_MOTOR_NOT_ARMED   */ {"⚠️  Motor NOT armed! Send 'c' to calibrate or wait for BLHeli activation\n", false},
+    /* LOG_BLHELI_START      */ {"\n⚡ BLHeli ACTIVATION: Starting in update()\n   Sending 2000μs for 1 second...\n", false},
+    /* LOG_BLHELI_ARMED      */ {"   Sending 1000μs (armed)...\n", false},
+    /* LOG_BLHELI_COMPLETE   */ {"✅ BLHeli activation COMPLETE in update()\n   ESC ready for normal operation!\n", false},
+    /* LOG_BLHELI_PROGRESS   */ {"⏳ BLHeli activation: step %ld/2, time: %ld ms\n", false},
+    /* LOG_SERVO_POSITIONS   */ {"🎮 SERVO %s: %ldμs\n", true},
+    /* LOG_AUTO_TEST         */ {"🧪 AUTO-TEST triggered by button combo!\n", false},
+    /* LOG_SEQUENCE_MOTOR    */ {"   Motor: %ldμs\n", false},
+    /* LOG_SEQUENCE_BUSY     */ {"⚠️  Busy: %s is running (send 'x' to abort)\n", true},
+    /* LOG_SEQUENCE_ABORTED  */ {"%s - sequence aborted, motor STOPPED\n", true},
+    /* LOG_FAILSAFE_STAGE    */ {"🛟 FAILSAFE: %s (нет пакетов %ld мс)\n", true},
+    /* LOG_FAILSAFE_RECOVERED*/ {"✅ FAILSAFE снят: связь восстановлена через %ld мс\n", false},
+    /* LOG_FIRST_COMMAND     */ {"🎮 Первая команда пульта на выходах: %ld мс после загрузки\n", false},
+    /* LOG_IMU_MISSING       */ {"⚠️ Датчик IMU не найден: стабилизация недоступна (только MANUAL)\n", false},
+    /* LOG_IMU_LOST          */ {"❌ Датчик IMU не отвечает (ошибок чтения: %ld): режим MANUAL\n", false},
+    /* LOG_FLIGHT_MODE       */ {"🧭 Режим полета: %s\n", true},
+};
+
+void EventLog::writeText(uint16_t event, const char* text, int32_t a0, int32_t a1, int32_t a2,
+                         int32_t a3, int32_t a4) {
+    LogRecord record;
+    record.timestampUs = Clock::micros();
+    record.event = event;
+    record.text = text;
+    record.args[0] = a0;
+    record.args[1] = a1;
+    record.args[2] = a2;
+    record.args[3] = a3;
+    record.args[4] = a4;
+    ring.push(record);
+}
+
+uint16_t EventLog::drain(uint16_t maxRecords) {
+    uint32_t dropped = ring.takeDropped();
+    if (dropped > 0) {
+        droppedTotal += dropped;
+        console.printf("⚠️  Журнал: потеряно %lu записей\n", (unsigned long)dropped);
+    }
+
+    uint16_t printed = 0;
+    LogRecord record;
+    while (printed < maxRecords && ring.pop(record)) {
+        if (record.event >= LOG_EVENT_COUNT) {
+            continue;
+        }
+        const LogEventFormat& format = EVENT_FORMATS[record.event];
+        if (record.event == LOG_TEXT) {
+            // Длинные сообщения последовательностей - без буфера printf
+            console.println(record.text != nullptr ? record.text : "");
+        } else if (format.hasText) {
+            console.printf(format.format, record.text != nullptr ? record.text : "",
+                           (long)record.args[0], (long)record.args[1], (long)record.args[2],
+                           (long)record.args[3], (long)record.args[4]);
+        } else {
+            console.printf(format.format,
+                           (long)record.args[0], (long)record.args[1], (long)record.args[2],
+                           (long)record.args[3], (long)record.args[4]);
+        }
+        printed++;
+    }
+    return printed;
+}
+
+#if defined(ARDUINO)
+
+static void eventLogTask(void* arg) {
+    (void)arg;
+    for (;;) {
+        EventLog::getInstance().drain();
+        vTaskDelay(pdMS_TO_TICKS(EVENT_LOG_DRAIN_MS));
+    }
+}
+
+bool EventLog::begin() {
+    // Ядро и приоритет - Core/TaskLayout.h (ниже задачи управления и WiFi)
+    return startTask(TASK_EVENT_LOG, eventLogTask, nullptr);
+}
+
+#else
+
+bool EventLog::begin() {
+    return true;
+}
+
+#endif
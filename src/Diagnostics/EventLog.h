@@ -0,0 +1,119 @@
+#pragma once
+#include <cstdint>
+#include "Core/MpscRing.h"
+
+// ============================================================================
+// НАСТРОЙКИ ЖУРНАЛА СОБЫТИЙ
+// ============================================================================
+
+#define LOG_LEVEL_ERROR  0
+#define LOG_LEVEL_WARN   1
+#define LOG_LEVEL_INFO   2
+#define LOG_LEVEL_DEBUG  3
+
+// События выше этого уровня выбрасываются при компиляции (аргументы не вычисляются)
+#define LOG_LEVEL  LOG_LEVEL_INFO
+
+#define EVENT_LOG_CAPACITY       128    // Записей в кольце (степень двойки)
+#define EVENT_LOG_DRAIN_MS       20
+
+// Журнал событий: горячий путь пишет только двоичную запись фиксированного
+// размера (id события, время, аргументы) в lock-free кольцо. Текст форматирует
+// и выводит в UART фоновая задача, поэтому Serial не задерживает ни callback
+// ESP-NOW, ни тик управления. При переполнении записи теряются, а не ждут.
+//
+// На хосте задачи нет: drain() вызывает хост-программа.
+
+enum LogEvent : uint16_t {
+    LOG_TEXT = 0,               // Готовая строка (только литералы: хранится указатель)
+    LOG_FRAME_BAD_LENGTH,
+    LOG_FRAME_BAD_VERSION,
+    LOG_LINK_UP,
+    LOG_LINK_DOWN,
+    LOG_LINK_STATS,
+    LOG_MOTOR_OUTPUT,
+    LOG_MOTOR_SAFETY_STOP,
+    LOG_MOTOR_NOT_ARMED,
+    LOG_BLHELI_START,
+    LOG_BLHELI_ARMED,
+    LOG_BLHELI_COMPLETE,
+    LOG_BLHELI_PROGRESS,
+    LOG_SERVO_POSITIONS,
+    LOG_AUTO_TEST,
+    LOG_SEQUENCE_MOTOR,
+    LOG_SEQUENCE_BUSY,
+    LOG_SEQUENCE_ABORTED,
+    LOG_FAILSAFE_STAGE,
+    LOG_FAILSAFE_RECOVERED,
+    LOG_FIRST_COMMAND,
+    LOG_IMU_MISSING,
+    LOG_IMU_LOST,
+    LOG_FLIGHT_MODE,
+    LOG_EVENT_COUNT
+};
+
+// Уровень события известен при компиляции - по нему работает фильтр LOG_EVENT
+constexpr uint8_t logEventLevel(uint16_t event) {
+    switch (event) {
+        case LOG_FRAME_BAD_LENGTH:
+        case LOG_FRAME_BAD_VERSION:
+        case LOG_IMU_LOST:
+            return LOG_LEVEL_ERROR;
+        case LOG_LINK_DOWN:
+        case LOG_MOTOR_NOT_ARMED:
+        case LOG_SEQUENCE_BUSY:
+        case LOG_SEQUENCE_ABORTED:
+        case LOG_FAILSAFE_STAGE:
+        case LOG_FAILSAFE_RECOVERED:
+        case LOG_IMU_MISSING:
+            return LOG_LEVEL_WARN;
+        case LOG_SEQUENCE_MOTOR:
+            return LOG_LEVEL_DEBUG;
+        default:
+            return LOG_LEVEL_INFO;
+    }
+}
+
+#define LOG_RECORD_ARGS  5
+
+struct LogRecord {
+    uint32_t timestampUs;
+    uint16_t event;
+    const char* text;
+    int32_t args[LOG_RECORD_ARGS];
+};
+
+class EventLog {
+public:
+    static EventLog& getInstance() {
+        static EventLog instance;
+        return instance;
+    }
+
+    // ESP32: запустить фоновую задачу вывода
+    bool begin();
+
+    // Из любого контекста: только копирование записи в кольцо
+    void write(uint16_t event, int32_t a0 = 0, int32_t a1 = 0, int32_t a2 = 0, int32_t a3 = 0, int32_t a4 = 0) {
+        writeText(event, nullptr, a0, a1, a2, a3, a4);
+    }
+    void writeText(uint16_t event, const char* text, int32_t a0 = 0, int32_t a1 = 0, int32_t a2 = 0,
+                   int32_t a3 = 0, int32_t a4 = 0);
+
+    // Отформатировать и вывести накопленные записи. Возвращает число выведенных
+    uint16_t drain(uint16_t maxRecords = 0xFFFF);
+
+    uint32_t getDroppedTotal() const { return droppedTotal; }
+
+private:
+    MpscRing<LogRecord, EVENT_LOG_CAPACITY> ring;
+    uint32_t droppedTotal = 0;
+
+    EventLog() = default;
+};
+
+#define LOG_EVENT(event, ...) \
+    do { if (logEventLevel(event) <= LOG_LEVEL) EventLog::getInstance().write(event, ##__VA_ARGS__); } while (0)
+
+#define LOG_EVENT_TEXT(event, text, ...) \
+    do { if (logEventLevel(event) <= LOG_LEVEL) EventLog::getInstance().writeText(event, text, ##__VA_ARGS__); } while (0)
@@ -0,0 +1,90 @@
+#include "FlightRecorder.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "HAL/Hal.h"
+
+void FlightRecorder::record(const uint8_t* data, int len, int8_t rssi, uint32_t arrivalUs) {
+    if (paused.load(std::memory_order_acquire)) {
+        return;
+    }
+    const uint32_t index = written.load(std::memory_order_relaxed);
+    RecordedFrame& frame = frames[index % FLIGHT_RECORDER_FRAMES];
+    frame.arrivalUs = arrivalUs;
+    frame.rssi = rssi;
+    frame.length = (uint8_t)(len < 0 ? 0 : (len > FLIGHT_RECORD_FRAME_MAX ? FLIGHT_RECORD_FRAME_MAX : len));
+    memcpy(frame.data, data, frame.length);
+    written.store(index + 1, std::memory_order_release);
+}
+
+void FlightRecorder::dump() {
+    // Callback радио, уже начавший запись кадра, успевает ее закончить
+    paused.store(true, std::memory_order_release);
+    Clock::delay(2);
+
+    const uint32_t total = written.load(std::memory_order_acquire);
+    const uint32_t count = total < FLIGHT_RECORDER_FRAMES ? total : FLIGHT_RECORDER_FRAMES;
+    console.printf("# flightrec 1: %lu frames (%lu overwritten)\n",
+                   (unsigned long)count, (unsigned long)(total - count));
+
+    char line[FLIGHT_RECORD_LINE_MAX];
+    for (uint32_t i = total - count; i != total; i++) {
+        if (formatLine(frames[i % FLIGHT_RECORDER_FRAMES], line, sizeof(line)) > 0) {
+            console.println(line);
+        }
+    }
+    console.println("# end");
+
+    written.store(0, std::memory_order_release);
+    paused.store(false, std::memory_order_release);
+}
+
+size_t FlightRecorder::formatLine(const RecordedFrame& frame, char* line, size_t size) {
+    int length = snprintf(line, size, "@ %lu %d ", (unsigned long)frame.arrivalUs, frame.rssi);
+    if (length < 0 || (size_t)length + frame.length * 2 + 1 > size) {
+        return 0;
+    }
+    static const char HEX_DIGITS[] = "0123456789ABCDEF";
+    for (uint8_t i = 0; i < frame.length; i++) {
+        line[length++] = HEX_DIGITS[frame.data[i] >> 4];
+        line[length++] = HEX_DIGITS[frame.data[i] & 0x0F];
+    }
+    line[length] = '\0';
+    return (size_t)length;
+}
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+bool FlightRecorder::parseLine(const char* line, RecordedFrame& frame) {
+    if (line[0] != '@' || line[1] != ' ') {
+        return false;
+    }
+    char* end = nullptr;
+    frame.arrivalUs = (uint32_t)strtoul(line + 2, &end, 10);
+    if (end == line + 2) {
+        return false;
+    }
+    const char* cursor = end;
+    frame.rssi = (int8_t)strtol(cursor, &end, 10);
+    if (end == cursor || *end != ' ') {
+        return false;
+    }
+    cursor = end + 1;
+
+    frame.length = 0;
+    while (frame.length < FLIGHT_RECORD_FRAME_MAX) {
+        const int high = hexValue(cursor[0]);
+        const int low = high < 0 ? -1 : hexValue(cursor[1]);
+        if (low < 0) {
+            break;
+        }
+        frame.data[frame.length++] = (uint8_t)(high << 4 | low);
+        cursor += 2;
+    }
+    return frame.length > 0;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// ============================================================================
+// ЗАПИСЬ ПОЛЕТА: СЫРЫЕ КАДРЫ ESP-NOW С ВРЕМЕНЕМ ПРИЕМА
+// ============================================================================
+//
+// Кадры пишутся как пришли из радио (до проверки CRC), поэтому воспроизведение
+// на хосте (src/Host/Replay) проходит тот же путь: разбор кадра, задача
+// управления, failsafe, фильтры, кривые, микшер, выходы PWM.
+//
+// Текстовый формат - одна строка на кадр, остальные строки игнорируются,
+// так что годится сырой лог монитора порта:
+//   @ <время приема, мкс> <RSSI, dBm> <байты кадра в hex>
+//   @ 15204311 -52 01A30F...
+
+#define FLIGHT_RECORDER_ENABLED     true
+#define FLIGHT_RECORDER_FRAMES      1024    // ~20 с при 50 пакетах/с
+#define FLIGHT_RECORD_FRAME_MAX     16      // Байт кадра (версия 1 - 13, версия 0 - 14)
+#define FLIGHT_RECORD_LINE_MAX      (24 + FLIGHT_RECORD_FRAME_MAX * 2)
+
+struct RecordedFrame {
+    uint32_t arrivalUs;
+    int8_t rssi;
+    uint8_t length;
+    uint8_t data[FLIGHT_RECORD_FRAME_MAX];
+};
+
+class FlightRecorder {
+public:
+    static FlightRecorder& getInstance() {
+        static FlightRecorder instance;
+        return instance;
+    }
+
+    // Из callback радио. Кольцо: хранятся последние FLIGHT_RECORDER_FRAMES кадров
+    void record(const uint8_t* data, int len, int8_t rssi, uint32_t arrivalUs);
+
+    // Вывести запись в консоль (команда 'r') и начать новую
+    void dump();
+    uint32_t getCount() const { return written.load(std::memory_order_acquire); }
+
+    // Строка формата записи. Возвращает длину строки / false для чужих строк
+    static size_t formatLine(const RecordedFrame& frame, char* line, size_t size);
+    static bool parseLine(const char* line, RecordedFrame& frame);
+
+private:
+    RecordedFrame frames[FLIGHT_RECORDER_FRAMES];
+    std::atomic<uint32_t> written{0};
+    std::atomic<bool> paused{false};
+
+    FlightRecorder() = default;
+};
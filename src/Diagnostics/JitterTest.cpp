@@ -0,0 +1,123 @@
+#include "JitterTest.h"
+#include "Control/ControlTask.h"
+#include "Core/TaskLayout.h"
+#include "Diagnostics/EventLog.h"
+#include "HAL/Hal.h"
+
+#if defined(ARDUINO)
+
+static const uint8_t BROADCAST_MAC[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+bool JitterTest::start(ControlTask& task) {
+    if (isRunning()) {
+        console.println("⚠️  Jitter test is already running");
+        return false;
+    }
+    controlTask = &task;
+    Radio::addPeer(BROADCAST_MAC);      // Уже добавлен - не ошибка
+    console.printf("⏱️  Jitter test: %u phases x %u ms, control tick %u Hz...\n",
+                   (unsigned)PHASE_COUNT, (unsigned)JITTER_TEST_PHASE_MS, controlTask->getRateHz());
+    beginPhase(PHASE_IDLE);
+    return true;
+}
+
+void JitterTest::service() {
+    if (!isRunning() || Clock::millis() - phaseStartMs < JITTER_TEST_PHASE_MS) {
+        return;
+    }
+
+    stopLoad();
+    const LatencyHistogram& histogram = controlTask->getJitterHistogram();
+    Result& result = results[phase];
+    result.ticks = histogram.getCount();
+    result.p50 = histogram.percentile(50);
+    result.p99 = histogram.percentile(99);
+    result.max = histogram.getMax();
+    result.execMax = controlTask->getMaxExecUs();
+    result.overruns = controlTask->getOverruns();
+
+    if (phase + 1 < PHASE_COUNT) {
+        beginPhase(phase + 1);
+    } else {
+        phase = -1;
+        printReport();
+    }
+}
+
+void JitterTest::beginPhase(int8_t next) {
+    phase = next;
+    if (phase == PHASE_LOAD_CONTROL_CORE) {
+        startLoad(TASK_LAYOUT[TASK_CONTROL].core);
+    } else if (phase == PHASE_LOAD_PROTOCOL_CORE) {
+        startLoad(TASK_LAYOUT[TASK_LOAD_TEST].core);
+    }
+    controlTask->requestJitterReset();
+    phaseStartMs = Clock::millis();
+}
+
+void JitterTest::startLoad(uint8_t core) {
+    loadRequested = true;
+    loadActive = true;
+    if (!startTask(TASK_LOAD_TEST, loadTask, this, nullptr, (int8_t)core)) {
+        loadRequested = false;
+        loadActive = false;
+    }
+}
+
+void JitterTest::stopLoad() {
+    loadRequested = false;
+    while (loadActive) {
+        Clock::delay(1);
+    }
+}
+
+void JitterTest::loadTask(void* arg) {
+    JitterTest* self = static_cast<JitterTest*>(arg);
+    uint8_t frame[JITTER_TEST_FRAME_SIZE] = {};
+
+    while (self->loadRequested) {
+        for (uint8_t i = 0; i < JITTER_TEST_LOG_BURST; i++) {
+            LOG_EVENT_TEXT(LOG_TEXT, "⏱️  jitter test: log load");
+        }
+        frame[0]++;
+        if (Radio::send(BROADCAST_MAC, frame, sizeof(frame))) {
+            self->framesSent++;
+        }
+        vTaskDelay(1);      // Не голодает idle-задача (сторожевой таймер)
+    }
+
+    self->loadActive = false;
+    endTask(TASK_LOAD_TEST);
+}
+
+void JitterTest::printReport() const {
+    static const char* const PHASE_NAMES[PHASE_COUNT] = {
+        "idle", "load on control core", "load on protocol core"};
+    static const char* const PHASE_CORES[PHASE_COUNT] = {
+        "-", TASK_LAYOUT[TASK_CONTROL].core == 0 ? "0" : "1", TASK_LAYOUT[TASK_LOAD_TEST].core == 0 ? "0" : "1"};
+
+    console.printf("⏱️  Control tick jitter, %u ms per phase (us), period %lu us:\n",
+                   (unsigned)JITTER_TEST_PHASE_MS, (unsigned long)(1000000UL / controlTask->getRateHz()));
+    console.println("    phase                     core   ticks    p50    p99    max   wcet  overruns");
+    for (uint8_t i = 0; i < PHASE_COUNT; i++) {
+        const Result& result = results[i];
+        console.printf("    %-24s  %4s  %6lu  %5lu  %5lu  %5lu  %5lu  %8lu\n", PHASE_NAMES[i], PHASE_CORES[i],
+                       (unsigned long)result.ticks, (unsigned long)result.p50,
+                       (unsigned long)result.p99, (unsigned long)result.max,
+                       (unsigned long)result.execMax, (unsigned long)result.overruns);
+    }
+    console.printf("    load: %lu ESP-NOW frames sent, log records dropped: %lu\n",
+                   (unsigned long)framesSent, (unsigned long)EventLog::getInstance().getDroppedTotal());
+}
+
+#else
+
+bool JitterTest::start(ControlTask& task) {
+    (void)task;
+    console.println("⚠️  Jitter test needs ESP32 tasks (not available on host)");
+    return false;
+}
+
+void JitterTest::service() {}
+
+#endif
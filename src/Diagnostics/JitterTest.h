@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+
+#define JITTER_TEST_PHASE_MS    5000    // Длительность каждой фазы
+#define JITTER_TEST_LOG_BURST   4       // Записей журнала за проход нагрузки (проход - 1 мс)
+#define JITTER_TEST_FRAME_SIZE  200     // Broadcast-кадр ESP-NOW за проход
+
+class ControlTask;
+
+// Тест джиттера тика управления (команда 'j').
+//
+// Три фазы подряд: без нагрузки; нагрузка на ядре управления (так было, пока
+// консоль и телеметрия жили в loop() рядом с управлением); нагрузка на
+// протокольном ядре (раскладка Core/TaskLayout.h). Нагрузка - поток
+// broadcast-кадров ESP-NOW и спам журнала событий, который уходит в UART.
+// Для каждой фазы печатаются p50/p99/max отклонения периода тика
+// и худшее время выполнения тика (WCET) - запас до периода цикла стабилизации.
+//
+// Только ESP32: на хосте задач и настоящего джиттера нет.
+class JitterTest {
+public:
+    static JitterTest& getInstance() {
+        static JitterTest instance;
+        return instance;
+    }
+
+    bool start(ControlTask& controlTask);
+    void service();         // Из задачи консоли: смена фаз и итоговый отчет
+    bool isRunning() const { return phase >= 0; }
+
+private:
+    enum Phase {
+        PHASE_IDLE = 0,
+        PHASE_LOAD_CONTROL_CORE,
+        PHASE_LOAD_PROTOCOL_CORE,
+        PHASE_COUNT
+    };
+
+    struct Result {
+        uint32_t ticks;
+        uint32_t p50;
+        uint32_t p99;
+        uint32_t max;
+        uint32_t execMax;
+        uint32_t overruns;
+    };
+
+    ControlTask* controlTask = nullptr;
+    int8_t phase = -1;      // -1 - тест не идет
+    uint32_t phaseStartMs = 0;
+    Result results[PHASE_COUNT] = {};
+
+    volatile bool loadRequested = false;
+    volatile bool loadActive = false;
+    uint32_t framesSent = 0;
+
+    void beginPhase(int8_t next);
+    void startLoad(uint8_t core);
+    void stopLoad();
+    void printReport() const;
+
+    static void loadTask(void* arg);
+
+    JitterTest() = default;
+};
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+
+#define LATENCY_HISTOGRAM_BUCKETS 32
+
+// Гистограмма задержек с логарифмическими (log2) корзинами.
+// Корзина i содержит значения [2^(i-1), 2^i), корзина 0 - только ноль.
+// Фиксированный размер, запись без выделения памяти - безопасна на горячем пути.
+// Писатель один; чтение из другой задачи дает приблизительную, но согласованную картину.
+class LatencyHistogram {
+public:
+    void record(uint32_t valueUs) {
+        buckets[bucketFor(valueUs)]++;
+        count++;
+        if (valueUs > maxUs) {
+            maxUs = valueUs;
+        }
+    }
+
+    // Верхняя граница корзины, в которую попадает percent% значений (не больше max)
+    uint32_t percentile(uint8_t percent) const {
+        if (count == 0) {
+            return 0;
+        }
+        uint32_t threshold = (uint32_t)(((uint64_t)count * percent + 99) / 100);
+        uint32_t cumulative = 0;
+        for (uint8_t i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+            cumulative += buckets[i];
+            if (cumulative >= threshold) {
+                uint32_t upper = i == 0 ? 0 : (1UL << i) - 1;
+                return upper < maxUs ? upper : maxUs;
+            }
+        }
+        return maxUs;
+    }
+
+    uint32_t getCount() const { return count; }
+    uint32_t getMax() const { return maxUs; }
+    uint32_t getBucket(uint8_t index) const { return buckets[index]; }
+
+    void reset() {
+        for (uint8_t i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+            buckets[i] = 0;
+        }
+        count = 0;
+        maxUs = 0;
+    }
+
+private:
+    volatile uint32_t buckets[LATENCY_HISTOGRAM_BUCKETS] = {};
+    volatile uint32_t count = 0;
+    volatile uint32_t maxUs = 0;
+
+    static uint8_t bucketFor(uint32_t value) {
+        if (value == 0) {
+            return 0;
+        }
+        uint8_t bucket = 32 - __builtin_clz(value);
+        return bucket < LATENCY_HISTOGRAM_BUCKETS ? bucket : LATENCY_HISTOGRAM_BUCKETS - 1;
+    }
+};
@@ -0,0 +1,25 @@
+#include "LatencyMonitor.h"
+#include "HAL/Console.h"
+
+const char* LatencyMonitor::getStageName(LatencyStage stage) {
+    switch (stage) {
+        case LATENCY_DECODED:  return "rx -> crc ok";
+        case LATENCY_DEQUEUED: return "rx -> control tick";
+        case LATENCY_MIXED:    return "rx -> mix done";
+        case LATENCY_OUTPUT:   return "rx -> pwm written";
+        default:               return "?";
+    }
+}
+
+void LatencyMonitor::printReport() const {
+    console.println("  Latency (us)            count      p50      p99      max");
+    for (uint8_t i = 0; i < LATENCY_STAGE_COUNT; i++) {
+        const LatencyHistogram& histogram = histograms[i];
+        console.printf("    %-20s %8lu %8lu %8lu %8lu\n",
+                       getStageName((LatencyStage)i),
+                       (unsigned long)histogram.getCount(),
+                       (unsigned long)histogram.percentile(50),
+                       (unsigned long)histogram.percentile(99),
+                       (unsigned long)histogram.getMax());
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include "HAL/Clock.h"
+#include "LatencyHistogram.h"
+
+// Этапы пути "кадр ESP-NOW -> импульс PWM".
+// Все задержки отсчитываются от момента входа в callback приема
+enum LatencyStage {
+    LATENCY_DECODED = 0,    // Разбор кадра и проверка CRC завершены
+    LATENCY_DEQUEUED,       // Задача управления забрала пакет из слота
+    LATENCY_MIXED,          // Углы/импульсы всех каналов рассчитаны
+    LATENCY_OUTPUT,         // Импульсы записаны в выходы PWM
+    LATENCY_STAGE_COUNT
+};
+
+// Сбор задержек управления по этапам
+class LatencyMonitor {
+public:
+    static LatencyMonitor& getInstance() {
+        static LatencyMonitor instance;
+        return instance;
+    }
+
+    // Зафиксировать этап для пакета, принятого в receivedAtUs
+    void mark(LatencyStage stage, uint32_t receivedAtUs) {
+        const uint8_t bit = (uint8_t)(1 << stage);
+        if (pendingReset.load(std::memory_order_relaxed) & bit) {
+            pendingReset.fetch_and((uint8_t)~bit, std::memory_order_acquire);
+            histograms[stage].reset();
+        }
+        histograms[stage].record(Clock::micros() - receivedAtUs);
+    }
+
+    const LatencyHistogram& getHistogram(LatencyStage stage) const { return histograms[stage]; }
+    static const char* getStageName(LatencyStage stage);
+
+    void printReport() const;
+    // Этапы пишут разные задачи (callback приема и задача управления):
+    // каждую гистограмму обнуляет ее писатель в следующем mark()
+    void requestReset() {
+        pendingReset.fetch_or((uint8_t)((1 << LATENCY_STAGE_COUNT) - 1), std::memory_order_release);
+    }
+
+private:
+    LatencyHistogram histograms[LATENCY_STAGE_COUNT];
+    std::atomic<uint8_t> pendingReset{0};   // Бит на этап
+
+    LatencyMonitor() = default;
+};
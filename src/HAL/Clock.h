@@ -0,0 +1,12 @@
+#pragma once
+#include <cstdint>
+
+// Время и задержки.
+// ESP32: millis()/delay() Arduino, micros() - esp_timer_get_time().
+// Хост: виртуальное время, которое двигает HostClock (delay() выполняется мгновенно)
+class Clock {
+public:
+    static uint32_t millis();
+    static uint32_t micros();
+    static void delay(uint32_t ms);
+};
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#define CONSOLE_DEC 10
+#define CONSOLE_HEX 16
+
+// Текстовая консоль (Serial на ESP32, stdout/stdin на хосте).
+// Повторяет подмножество API Arduino Print, которое использует проект
+class Console {
+public:
+    void begin(unsigned long baud);
+
+    size_t print(const char* text);
+    size_t print(char c);
+    size_t print(int value, int base = CONSOLE_DEC);
+    size_t print(unsigned int value, int base = CONSOLE_DEC);
+    size_t print(long value, int base = CONSOLE_DEC);
+    size_t print(unsigned long value, int base = CONSOLE_DEC);
+    size_t print(double value, int digits = 2);
+
+    size_t println();
+    size_t println(const char* text);
+    size_t println(char c);
+    size_t println(int value, int base = CONSOLE_DEC);
+    size_t println(unsigned int value, int base = CONSOLE_DEC);
+    size_t println(long value, int base = CONSOLE_DEC);
+    size_t println(unsigned long value, int base = CONSOLE_DEC);
+    size_t println(double value, int digits = 2);
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    int available();
+    int read();
+};
+
+extern Console console;
@@ -0,0 +1,152 @@
+#pragma once
+#include <cstdint>
+
+// ============================================================================
+// DSHOT: КАДР, КОНТРОЛЬНАЯ СУММА, СИМВОЛЫ RMT
+// ============================================================================
+//
+// Кадр - 16 бит, старшим битом вперед: 11 бит значения (0 - стоп, 1-47 - команды
+// ESC, 48-2047 - газ), бит запроса телеметрии и 4 бита контрольной суммы (XOR
+// полубайтов). Каждый бит - импульс фиксированного периода: единица - высокий
+// уровень 3/4 периода, ноль - 3/8.
+//
+// Символ - слово RMT (rmt_item32_t в IDF 4, rmt_symbol_word_t в IDF 5):
+// длительность и уровень первой половины в битах 0-15, второй - в битах 16-31.
+// Символы всех 16 полубайтов считаются при компиляции, поэтому кодирование
+// кадра - четыре копирования по 4 слова без разбора битов.
+//
+// Файл не зависит от платформы: поток символов проверяется на хосте
+// (dshotDecode, static_assert ниже, HostDshot).
+
+// Скорость, кбит/с
+#define DSHOT150  150
+#define DSHOT300  300
+#define DSHOT600  600
+
+#define DSHOT_TICK_HZ           40000000UL  // Такт RMT: APB 80 МГц / 2
+#define DSHOT_FRAME_BITS        16
+#define DSHOT_FRAME_RATE_HZ     2000        // Кадров в секунду: последнее значение повторяется
+#define DSHOT_FRAME_PERIOD_US   (1000000 / DSHOT_FRAME_RATE_HZ)
+
+// Значения кадра
+#define DSHOT_CMD_MOTOR_STOP        0
+#define DSHOT_CMD_BEEP1             1       // BEEP1-BEEP5 - тоны по возрастанию
+#define DSHOT_CMD_BEEP5             5
+#define DSHOT_CMD_ESC_INFO          6
+#define DSHOT_CMD_SPIN_DIRECTION_1  7
+#define DSHOT_CMD_SPIN_DIRECTION_2  8
+#define DSHOT_CMD_3D_MODE_OFF       9
+#define DSHOT_CMD_3D_MODE_ON        10
+#define DSHOT_CMD_SAVE_SETTINGS     12
+#define DSHOT_THROTTLE_MIN          48
+#define DSHOT_THROTTLE_MAX          2047
+#define DSHOT_3D_REVERSE_MAX        1047    // 3D: 48-1047 - назад, 1049-2047 - вперед
+#define DSHOT_3D_FORWARD_MIN        1049
+
+#define DSHOT_SETTING_REPEAT        6       // Команды настроек ESC принимает после 6 кадров подряд
+#define DSHOT_BEEP_GAP_MS           260     // Пауза после звуковой команды (BLHeli)
+
+struct DshotSymbols {
+    uint32_t symbols[DSHOT_FRAME_BITS];
+};
+
+struct DshotNibbleTable {
+    uint32_t symbols[16][4];
+};
+
+constexpr uint16_t dshotFrame(uint16_t value, bool telemetry) {
+    const uint16_t packet = (uint16_t)(((value & 0x07FF) << 1) | (telemetry ? 1 : 0));
+    return (uint16_t)((packet << 4) | ((packet ^ (packet >> 4) ^ (packet >> 8)) & 0x0F));
+}
+
+constexpr uint16_t dshotValue(uint16_t frame) { return frame >> 5; }
+constexpr bool dshotTelemetry(uint16_t frame) { return (frame >> 4) & 1; }
+
+// Период бита в тактах RMT: 267 / 133 / 67 для DShot150/300/600
+constexpr uint32_t dshotBitTicks(uint16_t speedKbps) {
+    return (DSHOT_TICK_HZ / 1000 + speedKbps / 2) / speedKbps;
+}
+
+// Высокий уровень highTicks, затем низкий до конца периода бита
+constexpr uint32_t dshotSymbol(uint32_t highTicks, uint32_t lowTicks) {
+    return highTicks | (1UL << 15) | (lowTicks << 16);
+}
+
+constexpr uint32_t dshotBitSymbol(bool one, uint16_t speedKbps) {
+    const uint32_t bit = dshotBitTicks(speedKbps);
+    const uint32_t high = one ? bit * 3 / 4 : bit * 3 / 8;
+    return dshotSymbol(high, bit - high);
+}
+
+constexpr DshotNibbleTable dshotMakeNibbles(uint16_t speedKbps) {
+    DshotNibbleTable table = {};
+    for (uint8_t nibble = 0; nibble < 16; nibble++) {
+        for (uint8_t bit = 0; bit < 4; bit++) {
+            table.symbols[nibble][bit] = dshotBitSymbol((nibble >> (3 - bit)) & 1, speedKbps);
+        }
+    }
+    return table;
+}
+
+constexpr DshotSymbols dshotEncode(uint16_t frame, const DshotNibbleTable& table) {
+    DshotSymbols out = {};
+    for (uint8_t n = 0; n < 4; n++) {
+        const uint8_t nibble = (frame >> (12 - 4 * n)) & 0x0F;
+        for (uint8_t bit = 0; bit < 4; bit++) {
+            out.symbols[4 * n + bit] = table.symbols[nibble][bit];
+        }
+    }
+    return out;
+}
+
+// Обратно из символов в кадр. -1 - период или уровни не DShot этой скорости,
+// либо не сошлась контрольная сумма
+constexpr int32_t dshotDecode(const DshotSymbols& frame, uint16_t speedKbps) {
+    const uint32_t bit = dshotBitTicks(speedKbps);
+    uint16_t value = 0;
+    for (uint8_t i = 0; i < DSHOT_FRAME_BITS; i++) {
+        const uint32_t symbol = frame.symbols[i];
+        const uint32_t high = symbol & 0x7FFF;
+        const uint32_t low = (symbol >> 16) & 0x7FFF;
+        if (!(symbol & (1UL << 15)) || (symbol & (1UL << 31)) || high + low != bit) {
+            return -1;
+        }
+        // Порог между 3/8 и 3/4 периода
+        value = (uint16_t)((value << 1) | (high * 16 > bit * 9 ? 1 : 0));
+    }
+    return dshotFrame(dshotValue(value), dshotTelemetry(value)) == value ? value : -1;
+}
+
+// Импульс ESC (мкс) -> значение газа DShot. stopUs == minUs - однонаправленный ESC:
+// стоп или 48-2047. Иначе 3D: stopUs - стоп, выше - вперед, ниже - назад
+constexpr uint16_t dshotFromPulse(int pulseUs, int minUs, int stopUs, int maxUs) {
+    if (stopUs <= minUs) {
+        return pulseUs <= minUs ? DSHOT_CMD_MOTOR_STOP
+            : (uint16_t)(DSHOT_THROTTLE_MIN + (pulseUs - minUs) * (DSHOT_THROTTLE_MAX - DSHOT_THROTTLE_MIN) / (maxUs - minUs));
+    }
+    if (pulseUs > stopUs) {
+        return (uint16_t)(DSHOT_3D_FORWARD_MIN + (pulseUs - stopUs) * (DSHOT_THROTTLE_MAX - DSHOT_3D_FORWARD_MIN) / (maxUs - stopUs));
+    }
+    if (pulseUs < stopUs) {
+        return (uint16_t)(DSHOT_THROTTLE_MIN + (stopUs - pulseUs) * (DSHOT_3D_REVERSE_MAX - DSHOT_THROTTLE_MIN) / (stopUs - minUs));
+    }
+    return DSHOT_CMD_MOTOR_STOP;
+}
+
+// Контрольные значения: пример кадра из описания протокола и круговое кодирование
+static_assert(dshotFrame(1046, false) == 0x82C6, "DShot checksum mismatch");
+static_assert(dshotFrame(DSHOT_CMD_BEEP1, true) == 0x0033, "DShot checksum mismatch");
+static_assert(dshotBitSymbol(true, DSHOT600) == dshotSymbol(50, 17), "DShot600 bit timing");
+static_assert(dshotBitSymbol(false, DSHOT150) == dshotSymbol(100, 167), "DShot150 bit timing");
+static_assert(dshotDecode(dshotEncode(0x82C6, dshotMakeNibbles(DSHOT150)), DSHOT150) == 0x82C6, "DShot150 symbol stream");
+static_assert(dshotDecode(dshotEncode(0x82C6, dshotMakeNibbles(DSHOT300)), DSHOT300) == 0x82C6, "DShot300 symbol stream");
+static_assert(dshotDecode(dshotEncode(0x82C6, dshotMakeNibbles(DSHOT600)), DSHOT600) == 0x82C6, "DShot600 symbol stream");
+static_assert(dshotDecode(dshotEncode(0x82C7, dshotMakeNibbles(DSHOT600)), DSHOT600) == -1, "DShot bad checksum accepted");
+static_assert(dshotDecode(dshotEncode(0x82C6, dshotMakeNibbles(DSHOT600)), DSHOT300) == -1, "DShot wrong speed accepted");
+static_assert(dshotFromPulse(1000, 1000, 1000, 2000) == DSHOT_CMD_MOTOR_STOP &&
+              dshotFromPulse(2000, 1000, 1000, 2000) == DSHOT_THROTTLE_MAX, "DShot throttle range");
+static_assert(dshotFromPulse(1500, 1000, 1500, 2000) == DSHOT_CMD_MOTOR_STOP &&
+              dshotFromPulse(2000, 1000, 1500, 2000) == DSHOT_THROTTLE_MAX &&
+              dshotFromPulse(1000, 1000, 1500, 2000) == DSHOT_3D_REVERSE_MAX, "DShot 3D range");
+static_assert(DSHOT_FRAME_BITS * dshotBitTicks(DSHOT150) < DSHOT_TICK_HZ / DSHOT_FRAME_RATE_HZ,
+              "DShot150 frame does not fit the frame period");
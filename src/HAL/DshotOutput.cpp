@@ -0,0 +1,86 @@
+#include "DshotOutput.h"
+
+// Символы полубайтов для каждой скорости - во flash
+static constexpr DshotNibbleTable DSHOT_NIBBLES_150 = dshotMakeNibbles(DSHOT150);
+static constexpr DshotNibbleTable DSHOT_NIBBLES_300 = dshotMakeNibbles(DSHOT300);
+static constexpr DshotNibbleTable DSHOT_NIBBLES_600 = dshotMakeNibbles(DSHOT600);
+
+SpscSlot<DshotOutput::Frame> DshotOutput::pending[DSHOT_MAX_OUTPUTS];
+DshotSymbols DshotOutput::current[DSHOT_MAX_OUTPUTS] = {};
+uint8_t DshotOutput::repeatLeft[DSHOT_MAX_OUTPUTS] = {};
+const DshotNibbleTable* DshotOutput::tables[DSHOT_MAX_OUTPUTS] = {};
+uint8_t DshotOutput::pins[DSHOT_MAX_OUTPUTS] = {};
+uint16_t DshotOutput::speeds[DSHOT_MAX_OUTPUTS] = {};
+uint16_t DshotOutput::values[DSHOT_MAX_OUTPUTS] = {};
+uint8_t DshotOutput::attachedMask = 0;
+
+int8_t DshotOutput::attach(uint8_t pin, uint16_t speedKbps) {
+    const DshotNibbleTable* table = speedKbps == DSHOT150 ? &DSHOT_NIBBLES_150
+        : speedKbps == DSHOT300 ? &DSHOT_NIBBLES_300
+        : speedKbps == DSHOT600 ? &DSHOT_NIBBLES_600 : nullptr;
+    if (table == nullptr) {
+        return -1;
+    }
+
+    for (uint8_t output = 0; output < DSHOT_MAX_OUTPUTS; output++) {
+        if (attachedMask & (1u << output)) {
+            continue;
+        }
+        // Первый кадр таймера - стоп, даже если write() еще не вызывался
+        tables[output] = table;
+        current[output] = dshotEncode(dshotFrame(DSHOT_CMD_MOTOR_STOP, false), *table);
+        repeatLeft[output] = 0;
+        pins[output] = pin;
+        speeds[output] = speedKbps;
+        values[output] = DSHOT_CMD_MOTOR_STOP;
+        if (!hwAttach(output, pin, speedKbps)) {
+            return -1;
+        }
+        attachedMask |= (1u << output);
+        return (int8_t)output;
+    }
+    return -1;
+}
+
+void DshotOutput::detach(int8_t output) {
+    if (!isAttached(output)) {
+        return;
+    }
+    hwDetach(output, pins[output]);
+    attachedMask &= ~(1u << output);
+}
+
+void DshotOutput::write(int8_t output, uint16_t value) {
+    if (!isAttached(output)) {
+        return;
+    }
+    values[output] = value;
+    publish(output, dshotFrame(value, false), 0);
+}
+
+void DshotOutput::command(int8_t output, uint8_t command, uint8_t repeat) {
+    if (!isAttached(output) || command >= DSHOT_THROTTLE_MIN) {
+        return;
+    }
+    values[output] = DSHOT_CMD_MOTOR_STOP;
+    publish(output, dshotFrame(command, true), repeat > 0 ? repeat : 1);
+}
+
+void DshotOutput::publish(int8_t output, uint16_t frame, uint8_t repeat) {
+    Frame next;
+    next.symbols = dshotEncode(frame, *tables[output]);
+    next.repeat = repeat;
+    pending[output].publish(next);
+}
+
+const DshotSymbols& DshotOutput::nextFrame(uint8_t output) {
+    Frame fresh;
+    if (pending[output].consume(fresh)) {
+        current[output] = fresh.symbols;
+        repeatLeft[output] = fresh.repeat;
+    } else if (repeatLeft[output] > 0 && --repeatLeft[output] == 0) {
+        // Команда отправлена нужное число раз - дальше стоп до следующего write()
+        current[output] = dshotEncode(dshotFrame(DSHOT_CMD_MOTOR_STOP, false), *tables[output]);
+    }
+    return current[output];
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include "HAL/Dshot.h"
+#include "Core/SpscSlot.h"
+
+// ============================================================================
+// ВЫХОДЫ DSHOT: кадры для ESC каждые DSHOT_FRAME_PERIOD_US
+// ============================================================================
+//
+// write()/command() кодируют кадр сразу (задача управления) и публикуют его
+// через SpscSlot. Таймер кадров платформы каждый период забирает свежий кадр
+// через nextFrame() или повторяет предыдущий: новое значение уходит в ESC не
+// позже чем через период, а не через 20 мс, как импульс 50 Гц.
+//
+// ESP32: канал RMT на выход, один esp_timer на все выходы.
+// Хост: кадры передаются по виртуальному времени при чтении HostDshot.
+
+#define DSHOT_MAX_OUTPUTS  4
+
+class DshotOutput {
+public:
+    // Занять канал RMT. Возвращает номер выхода или -1
+    static int8_t attach(uint8_t pin, uint16_t speedKbps);
+    static void detach(int8_t output);
+
+    // Газ 0 / 48-2047: передается, пока не придет новое значение
+    static void write(int8_t output, uint16_t value);
+
+    // Команда ESC (DSHOT_CMD_*): repeat кадров подряд с битом телеметрии, затем стоп
+    static void command(int8_t output, uint8_t command, uint8_t repeat);
+
+    // Для таймера кадров платформы: символы кадра этого периода
+    static const DshotSymbols& nextFrame(uint8_t output);
+
+    static bool isAttached(int8_t output) { return output >= 0 && output < DSHOT_MAX_OUTPUTS && (attachedMask & (1u << output)); }
+    static uint16_t getSpeed(int8_t output) { return isAttached(output) ? speeds[output] : 0; }
+    static uint16_t getValue(int8_t output) { return isAttached(output) ? values[output] : 0; }
+
+private:
+    // Кадр на публикацию: repeat = 0 - повторять до следующего
+    struct Frame {
+        DshotSymbols symbols;
+        uint8_t repeat;
+    };
+
+    // Платформенная часть: Esp32Hal.cpp / HostHal.cpp
+    static bool hwAttach(uint8_t output, uint8_t pin, uint16_t speedKbps);
+    static void hwDetach(uint8_t output, uint8_t pin);
+
+    static void publish(int8_t output, uint16_t frame, uint8_t repeat);
+
+    static SpscSlot<Frame> pending[DSHOT_MAX_OUTPUTS];
+    static DshotSymbols current[DSHOT_MAX_OUTPUTS];     // Принадлежат таймеру кадров
+    static uint8_t repeatLeft[DSHOT_MAX_OUTPUTS];
+    static const DshotNibbleTable* tables[DSHOT_MAX_OUTPUTS];
+    static uint8_t pins[DSHOT_MAX_OUTPUTS];
+    static uint16_t speeds[DSHOT_MAX_OUTPUTS];
+    static uint16_t values[DSHOT_MAX_OUTPUTS];
+    static uint8_t attachedMask;
+};
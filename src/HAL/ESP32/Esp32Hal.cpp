@@ -0,0 +1,505 @@
+#include <Arduino.h>
+#include <esp_now.h>
+#include <esp_timer.h>
+#include <esp_system.h>
+#include <driver/ledc.h>
+#include <WiFi.h>
+#include <Wire.h>
+#include <esp_wifi.h>
+#include <esp_idf_version.h>
+#if ESP_IDF_VERSION_MAJOR >= 5
+#include <driver/rmt_tx.h>
+#else
+#include <driver/rmt.h>
+#endif
+#include <nvs_flash.h>
+#include <nvs.h>
+#include <stdarg.h>
+#include "HAL/Hal.h"
+#include "Core/TaskLayout.h"
+#include "Core/Types.h"
+
+// ============================================================================
+// Clock
+// ============================================================================
+
+uint32_t Clock::millis() {
+    return ::millis();
+}
+
+uint32_t Clock::micros() {
+    return (uint32_t)esp_timer_get_time();
+}
+
+void Clock::delay(uint32_t ms) {
+    ::delay(ms);
+}
+
+// ============================================================================
+// Console
+// ============================================================================
+
+Console console;
+
+void Console::begin(unsigned long baud) { Serial.begin(baud); }
+
+size_t Console::print(const char* text) { return Serial.print(text); }
+size_t Console::print(char c) { return Serial.print(c); }
+size_t Console::print(int value, int base) { return Serial.print(value, base); }
+size_t Console::print(unsigned int value, int base) { return Serial.print(value, base); }
+size_t Console::print(long value, int base) { return Serial.print(value, base); }
+size_t Console::print(unsigned long value, int base) { return Serial.print(value, base); }
+size_t Console::print(double value, int digits) { return Serial.print(value, digits); }
+
+size_t Console::println() { return Serial.println(); }
+size_t Console::println(const char* text) { return Serial.println(text); }
+size_t Console::println(char c) { return Serial.println(c); }
+size_t Console::println(int value, int base) { return Serial.println(value, base); }
+size_t Console::println(unsigned int value, int base) { return Serial.println(value, base); }
+size_t Console::println(long value, int base) { return Serial.println(value, base); }
+size_t Console::println(unsigned long value, int base) { return Serial.println(value, base); }
+size_t Console::println(double value, int digits) { return Serial.println(value, digits); }
+
+size_t Console::printf(const char* format, ...) {
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (len <= 0) {
+        return 0;
+    }
+    return Serial.write((const uint8_t*)buffer, min((size_t)len, sizeof(buffer) - 1));
+}
+
+int Console::available() { return Serial.available(); }
+int Console::read() { return Serial.read(); }
+
+// ============================================================================
+// Gpio
+// ============================================================================
+
+void Gpio::setOutput(uint8_t pin) {
+    pinMode(pin, OUTPUT);
+}
+
+void Gpio::write(uint8_t pin, bool level) {
+    digitalWrite(pin, level ? HIGH : LOW);
+}
+
+// ============================================================================
+// PwmBank (LEDC)
+// ============================================================================
+
+// 16 бит на периоде 20 мс: шаг ~0.3 мкс
+#define PWM_LEDC_RESOLUTION     LEDC_TIMER_16_BIT
+#define PWM_LEDC_DUTY_STEPS     65536UL
+#define PWM_LEDC_HS_CHANNELS    8
+
+static bool ledcTimersReady = false;
+
+static ledc_mode_t ledcMode(uint8_t channel) {
+    return channel < PWM_LEDC_HS_CHANNELS ? LEDC_HIGH_SPEED_MODE : LEDC_LOW_SPEED_MODE;
+}
+
+static ledc_channel_t ledcChannel(uint8_t channel) {
+    return (ledc_channel_t)(channel % PWM_LEDC_HS_CHANNELS);
+}
+
+static bool ledcBeginTimers() {
+    ledc_timer_config_t timer = {};
+    timer.duty_resolution = PWM_LEDC_RESOLUTION;
+    timer.timer_num = LEDC_TIMER_0;
+    timer.freq_hz = PWM_BANK_FREQUENCY_HZ;
+    timer.clk_cfg = LEDC_USE_APB_CLK;
+
+    timer.speed_mode = LEDC_HIGH_SPEED_MODE;
+    if (ledc_timer_config(&timer) != ESP_OK) {
+        return false;
+    }
+    timer.speed_mode = LEDC_LOW_SPEED_MODE;
+    if (ledc_timer_config(&timer) != ESP_OK) {
+        return false;
+    }
+
+    // Сброс счетчиков подряд: периоды обоих таймеров начинаются вместе
+    ledc_timer_rst(LEDC_HIGH_SPEED_MODE, LEDC_TIMER_0);
+    ledc_timer_rst(LEDC_LOW_SPEED_MODE, LEDC_TIMER_0);
+    return true;
+}
+
+bool PwmBank::hwAttach(uint8_t channel, uint8_t pin) {
+    if (!ledcTimersReady) {
+        ledcTimersReady = ledcBeginTimers();
+        if (!ledcTimersReady) {
+            return false;
+        }
+    }
+
+    ledc_channel_config_t config = {};
+    config.gpio_num = pin;
+    config.speed_mode = ledcMode(channel);
+    config.channel = ledcChannel(channel);
+    config.timer_sel = LEDC_TIMER_0;
+    config.duty = 0;
+    config.hpoint = 0;      // Передний фронт у всех каналов в начале периода
+    return ledc_channel_config(&config) == ESP_OK;
+}
+
+void PwmBank::hwDetach(uint8_t channel, uint8_t pin) {
+    ledc_stop(ledcMode(channel), ledcChannel(channel), 0);
+    pinMode(pin, INPUT);
+}
+
+void PwmBank::hwWrite(uint8_t channel, uint8_t pin, int pulseUs) {
+    (void)pin;
+    const uint32_t duty = (uint32_t)pulseUs * PWM_LEDC_DUTY_STEPS / PWM_BANK_PERIOD_US;
+    ledc_set_duty(ledcMode(channel), ledcChannel(channel), duty);
+}
+
+void PwmBank::hwLatch(uint16_t channelMask) {
+    // Новая скважность вступает в силу с начала следующего периода
+    for (uint8_t channel = 0; channel < PWM_BANK_MAX_CHANNELS; channel++) {
+        if (channelMask & (1u << channel)) {
+            ledc_update_duty(ledcMode(channel), ledcChannel(channel));
+        }
+    }
+}
+
+// ============================================================================
+// DshotOutput (RMT)
+// ============================================================================
+
+// Один периодический таймер на все выходы: каждый период - по кадру на каждый
+// канал RMT. Кадр 16 символов помещается в блок памяти канала, передача идет
+// аппаратно, callback только запускает ее
+#define DSHOT_RMT_CLK_DIV  2    // APB 80 МГц -> DSHOT_TICK_HZ
+
+static esp_timer_handle_t dshotTimer = nullptr;
+static volatile uint8_t dshotActiveMask = 0;
+
+#if ESP_IDF_VERSION_MAJOR >= 5
+
+static rmt_channel_handle_t dshotChannels[DSHOT_MAX_OUTPUTS] = {};
+static rmt_encoder_handle_t dshotEncoders[DSHOT_MAX_OUTPUTS] = {};
+
+static void dshotTransmit(uint8_t output, const DshotSymbols& frame) {
+    // Символы копируются во время передачи: буфер живет до следующего периода
+    rmt_transmit_config_t config = {};
+    rmt_transmit(dshotChannels[output], dshotEncoders[output], frame.symbols, sizeof(frame.symbols), &config);
+}
+
+static bool dshotChannelBegin(uint8_t output, uint8_t pin) {
+    rmt_tx_channel_config_t config = {};
+    config.gpio_num = (gpio_num_t)pin;
+    config.clk_src = RMT_CLK_SRC_DEFAULT;
+    config.resolution_hz = DSHOT_TICK_HZ;
+    config.mem_block_symbols = 64;
+    config.trans_queue_depth = 2;
+    rmt_copy_encoder_config_t encoderConfig = {};
+    return rmt_new_tx_channel(&config, &dshotChannels[output]) == ESP_OK &&
+           rmt_new_copy_encoder(&encoderConfig, &dshotEncoders[output]) == ESP_OK &&
+           rmt_enable(dshotChannels[output]) == ESP_OK;
+}
+
+static void dshotChannelEnd(uint8_t output) {
+    rmt_disable(dshotChannels[output]);
+    rmt_del_channel(dshotChannels[output]);
+    rmt_del_encoder(dshotEncoders[output]);
+    dshotChannels[output] = nullptr;
+    dshotEncoders[output] = nullptr;
+}
+
+#else
+
+static void dshotTransmit(uint8_t output, const DshotSymbols& frame) {
+    // Без ожидания: символы копируются в память канала до возврата
+    rmt_write_items((rmt_channel_t)output, (const rmt_item32_t*)frame.symbols, DSHOT_FRAME_BITS, false);
+}
+
+static bool dshotChannelBegin(uint8_t output, uint8_t pin) {
+    rmt_config_t config = RMT_DEFAULT_CONFIG_TX((gpio_num_t)pin, (rmt_channel_t)output);
+    config.clk_div = DSHOT_RMT_CLK_DIV;
+    config.tx_config.idle_output_en = true;
+    config.tx_config.idle_level = RMT_IDLE_LEVEL_LOW;
+    return rmt_config(&config) == ESP_OK && rmt_driver_install(config.channel, 0, 0) == ESP_OK;
+}
+
+static void dshotChannelEnd(uint8_t output) {
+    rmt_driver_uninstall((rmt_channel_t)output);
+}
+
+#endif
+
+static void onDshotFrame(void* arg) {
+    (void)arg;
+    const uint8_t mask = dshotActiveMask;
+    for (uint8_t output = 0; output < DSHOT_MAX_OUTPUTS; output++) {
+        if (mask & (1u << output)) {
+            dshotTransmit(output, DshotOutput::nextFrame(output));
+        }
+    }
+}
+
+bool DshotOutput::hwAttach(uint8_t output, uint8_t pin, uint16_t speedKbps) {
+    (void)speedKbps;    // Скорость - в длительностях символов, такт RMT общий
+    if (!dshotChannelBegin(output, pin)) {
+        return false;
+    }
+    if (dshotTimer == nullptr) {
+        esp_timer_create_args_t timerArgs = {};
+        timerArgs.callback = onDshotFrame;
+        timerArgs.name = "dshot_frame";
+        if (esp_timer_create(&timerArgs, &dshotTimer) != ESP_OK ||
+            esp_timer_start_periodic(dshotTimer, DSHOT_FRAME_PERIOD_US) != ESP_OK) {
+            dshotChannelEnd(output);
+            return false;
+        }
+    }
+    dshotActiveMask = dshotActiveMask | (1u << output);
+    return true;
+}
+
+void DshotOutput::hwDetach(uint8_t output, uint8_t pin) {
+    dshotActiveMask = dshotActiveMask & ~(1u << output);
+    if (dshotActiveMask == 0 && dshotTimer != nullptr) {
+        esp_timer_stop(dshotTimer);
+        esp_timer_delete(dshotTimer);
+        dshotTimer = nullptr;
+    }
+    dshotChannelEnd(output);
+    pinMode(pin, INPUT);
+}
+
+// ============================================================================
+// Radio
+// ============================================================================
+
+// Callback приема выполняется в задаче WiFi - она должна жить на протокольном ядре
+#if defined(CONFIG_ESP32_WIFI_TASK_CORE_ID)
+static_assert(CONFIG_ESP32_WIFI_TASK_CORE_ID == PROTOCOL_CORE, "WiFi task must run on PROTOCOL_CORE (TaskLayout.h)");
+#endif
+
+static Radio::ReceiveCallback radioCallback = nullptr;
+static volatile int8_t lastFrameRssi = 0;
+
+#if ESP_IDF_VERSION_MAJOR >= 5
+
+// IDF 5: RSSI приходит вместе с кадром
+static void onEspNowReceive(const esp_now_recv_info_t* info, const uint8_t* data, int len) {
+    const int8_t rssi = info->rx_ctrl != nullptr ? info->rx_ctrl->rssi : 0;
+    lastFrameRssi = rssi;
+    if (radioCallback != nullptr) {
+        radioCallback(info->src_addr, data, len, rssi);
+    }
+}
+
+#else
+
+// IDF 4 (Arduino core 2.x): в callback ESP-NOW нет rx_ctrl. Кадр ESP-NOW -
+// action-кадр (0xD0), его RSSI берем из promiscuous callback, который
+// вызывается для того же кадра непосредственно перед callback ESP-NOW
+#define WIFI_FRAME_ACTION 0xD0
+
+static void onPromiscuousFrame(void* buffer, wifi_promiscuous_pkt_type_t type) {
+    if (type != WIFI_PKT_MGMT) {
+        return;
+    }
+    const wifi_promiscuous_pkt_t* packet = (const wifi_promiscuous_pkt_t*)buffer;
+    if (packet->payload[0] == WIFI_FRAME_ACTION) {
+        lastFrameRssi = packet->rx_ctrl.rssi;
+    }
+}
+
+static void onEspNowReceive(const uint8_t* mac, const uint8_t* data, int len) {
+    if (radioCallback != nullptr) {
+        radioCallback(mac, data, len, lastFrameRssi);
+    }
+}
+
+#endif
+
+bool Radio::begin() {
+    WiFi.mode(WIFI_STA);
+    if (esp_now_init() != ESP_OK) {
+        return false;
+    }
+#if ESP_IDF_VERSION_MAJOR < 5
+    wifi_promiscuous_filter_t filter = {};
+    filter.filter_mask = WIFI_PROMIS_FILTER_MASK_MGMT;
+    esp_wifi_set_promiscuous_filter(&filter);
+    esp_wifi_set_promiscuous_rx_cb(onPromiscuousFrame);
+    esp_wifi_set_promiscuous(true);
+#endif
+    return true;
+}
+
+bool Radio::addPeer(const uint8_t mac[6]) {
+    esp_now_peer_info_t peerInfo = {};
+    memcpy(peerInfo.peer_addr, mac, 6);
+    peerInfo.channel = 0;
+    peerInfo.encrypt = false;
+    return esp_now_add_peer(&peerInfo) == ESP_OK;
+}
+
+void Radio::onReceive(ReceiveCallback callback) {
+    radioCallback = callback;
+    esp_now_register_recv_cb(onEspNowReceive);
+}
+
+void Radio::getMacAddress(uint8_t mac[6]) {
+    WiFi.macAddress(mac);
+}
+
+int Radio::getRssi() {
+    return lastFrameRssi;
+}
+
+bool Radio::send(const uint8_t mac[6], const uint8_t* data, int len) {
+    return esp_now_send(mac, data, len) == ESP_OK;
+}
+
+// ============================================================================
+// Imu (MPU6050 и совместимые по карте регистров: MPU6500/9250, ICM-20602/20689)
+// ============================================================================
+
+#define IMU_I2C_ADDRESS     0x68
+#define IMU_I2C_HZ          400000
+#define IMU_I2C_TIMEOUT_MS  2       // Зависшая шина не держит тик управления дольше
+
+#define MPU_REG_SMPLRT_DIV    0x19
+#define MPU_REG_CONFIG        0x1A
+#define MPU_REG_GYRO_CONFIG   0x1B
+#define MPU_REG_ACCEL_CONFIG  0x1C
+#define MPU_REG_ACCEL_XOUT_H  0x3B
+#define MPU_REG_PWR_MGMT_1    0x6B
+#define MPU_REG_WHO_AM_I      0x75
+
+static bool imuWrite(uint8_t reg, uint8_t value) {
+    Wire.beginTransmission(IMU_I2C_ADDRESS);
+    Wire.write(reg);
+    Wire.write(value);
+    return Wire.endTransmission() == 0;
+}
+
+static bool imuReadBytes(uint8_t reg, uint8_t* data, uint8_t count) {
+    Wire.beginTransmission(IMU_I2C_ADDRESS);
+    Wire.write(reg);
+    if (Wire.endTransmission(false) != 0 || Wire.requestFrom((uint8_t)IMU_I2C_ADDRESS, count) != count) {
+        return false;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        data[i] = (uint8_t)Wire.read();
+    }
+    return true;
+}
+
+bool Imu::begin() {
+    if (!Wire.begin(HardwareConfig::IMU_SDA_PIN, HardwareConfig::IMU_SCL_PIN, IMU_I2C_HZ)) {
+        return false;
+    }
+    Wire.setTimeOut(IMU_I2C_TIMEOUT_MS);
+
+    uint8_t id = 0;
+    if (!imuReadBytes(MPU_REG_WHO_AM_I, &id, 1)) {
+        return false;
+    }
+    if (id != 0x68 && id != 0x70 && id != 0x71 && id != 0x12 && id != 0x98) {
+        console.printf("⚠️  IMU: unknown WHO_AM_I 0x%02X\n", id);
+        return false;
+    }
+
+    imuWrite(MPU_REG_PWR_MGMT_1, 0x80);     // Сброс
+    Clock::delay(100);
+    // Тактирование от PLL гироскопа X, DLPF ~98 Гц, выборка 1 кГц, ±2000 °/с, ±8 g
+    return imuWrite(MPU_REG_PWR_MGMT_1, 0x01) && imuWrite(MPU_REG_CONFIG, 0x02) &&
+           imuWrite(MPU_REG_SMPLRT_DIV, 0x00) && imuWrite(MPU_REG_GYRO_CONFIG, 0x18) &&
+           imuWrite(MPU_REG_ACCEL_CONFIG, 0x10);
+}
+
+bool Imu::read(ImuSample& sample) {
+    // Одна транзакция: ускорения, температура, угловые скорости (~0.4 мс на 400 кГц)
+    uint8_t raw[14];
+    if (!imuReadBytes(MPU_REG_ACCEL_XOUT_H, raw, sizeof(raw))) {
+        return false;
+    }
+    int16_t value[7];
+    for (uint8_t i = 0; i < 7; i++) {
+        value[i] = (int16_t)((raw[2 * i] << 8) | raw[2 * i + 1]);
+    }
+
+    // Микросхема лицом вверх, x по полету: y и z связанных осей направлены противоположно
+    static const int8_t AXIS_SIGN[3] = {1, -1, -1};
+    for (uint8_t i = 0; i < 3; i++) {
+        sample.accel[i] = (int16_t)(AXIS_SIGN[i] * value[i]);                       // 4096 LSB/g
+        sample.gyro[i] = (int16_t)(AXIS_SIGN[i] * (int32_t)value[4 + i] * 40 / 41);   // 16.4 LSB/(°/с) -> 16
+    }
+    sample.timestampUs = Clock::micros();
+    return true;
+}
+
+// ============================================================================
+// Storage (NVS)
+// ============================================================================
+
+static nvs_handle_t storageHandle = 0;
+static bool storageOpen = false;
+
+bool Storage::begin() {
+    if (storageOpen) {
+        return true;
+    }
+    esp_err_t status = nvs_flash_init();
+    if (status == ESP_ERR_NVS_NO_FREE_PAGES || status == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+        // Раздел NVS поврежден или другого формата - стираем, настройки вернутся к умолчаниям
+        nvs_flash_erase();
+        status = nvs_flash_init();
+    }
+    if (status != ESP_OK) {
+        return false;
+    }
+    storageOpen = nvs_open(STORAGE_NAMESPACE, NVS_READWRITE, &storageHandle) == ESP_OK;
+    return storageOpen;
+}
+
+bool Storage::read(const char* key, void* data, size_t size) {
+    if (!storageOpen) {
+        return false;
+    }
+    size_t length = size;
+    return nvs_get_blob(storageHandle, key, data, &length) == ESP_OK && length == size;
+}
+
+bool Storage::write(const char* key, const void* data, size_t size) {
+    if (!storageOpen) {
+        return false;
+    }
+    return nvs_set_blob(storageHandle, key, data, size) == ESP_OK &&
+           nvs_commit(storageHandle) == ESP_OK;
+}
+
+bool Storage::erase(const char* key) {
+    if (!storageOpen) {
+        return false;
+    }
+    const esp_err_t status = nvs_erase_key(storageHandle, key);
+    return (status == ESP_OK || status == ESP_ERR_NVS_NOT_FOUND) && nvs_commit(storageHandle) == ESP_OK;
+}
+
+// ============================================================================
+// System
+// ============================================================================
+
+ResetReason System::getResetReason() {
+    switch (esp_reset_reason()) {
+        case ESP_RST_POWERON:   return RESET_POWER_ON;
+        case ESP_RST_EXT:       return RESET_EXTERNAL;
+        case ESP_RST_SW:        return RESET_SOFTWARE;
+        case ESP_RST_PANIC:     return RESET_PANIC;
+        case ESP_RST_INT_WDT:
+        case ESP_RST_TASK_WDT:
+        case ESP_RST_WDT:       return RESET_WATCHDOG;
+        case ESP_RST_BROWNOUT:  return RESET_BROWNOUT;
+        default:                return RESET_OTHER;
+    }
+}
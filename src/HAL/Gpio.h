@@ -0,0 +1,9 @@
+#pragma once
+#include <cstdint>
+
+// Цифровые выходы (светодиод связи и т.п.)
+class Gpio {
+public:
+    static void setOutput(uint8_t pin);
+    static void write(uint8_t pin, bool level);
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+// Тонкий слой абстракции оборудования.
+// Логика управления использует только эти интерфейсы, поэтому одни и те же
+// ServoManager/ESPNowManager собираются и для ESP32, и для хоста ([env:native]).
+//
+//   Clock      - время и задержки
+//   Console    - текстовая консоль
+//   PwmOutput  - выходы сервоприводов/ESC
+//   PwmBank    - общий период и пакетная запись всех выходов PWM
+//   DshotOutput - кадры DShot для ESC (RMT)
+//   Radio      - ESP-NOW
+//   Gpio       - цифровые выходы
+//   Imu        - гироскоп и акселерометр
+//   Storage    - энергонезависимые настройки (NVS)
+//   System     - причина сброса
+
+#include "HAL/Clock.h"
+#include "HAL/Console.h"
+#include "HAL/DshotOutput.h"
+#include "HAL/Gpio.h"
+#include "HAL/Imu.h"
+#include "HAL/PwmBank.h"
+#include "HAL/PwmOutput.h"
+#include "HAL/Radio.h"
+#include "HAL/Storage.h"
+#include "HAL/System.h"
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#else
+#include "HAL/Host/ArduinoCompat.h"
+#endif
@@ -0,0 +1,405 @@
+#include "HAL/Hal.h"
+#include "HostHal.h"
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// Clock (виртуальное время)
+// ============================================================================
+
+static uint64_t virtualTimeUs = 0;
+
+uint32_t Clock::millis() {
+    return (uint32_t)(virtualTimeUs / 1000);
+}
+
+uint32_t Clock::micros() {
+    return (uint32_t)virtualTimeUs;
+}
+
+void Clock::delay(uint32_t ms) {
+    virtualTimeUs += (uint64_t)ms * 1000;
+}
+
+uint64_t HostClock::nowUs() { return virtualTimeUs; }
+void HostClock::setUs(uint64_t us) { virtualTimeUs = us; }
+void HostClock::advanceUs(uint64_t us) { virtualTimeUs += us; }
+
+// ============================================================================
+// Console (stdout / подставной ввод)
+// ============================================================================
+
+Console console;
+
+static bool consoleQuiet = false;
+static std::deque<char> consoleInput;
+
+static size_t consoleWrite(const char* format, ...) __attribute__((format(printf, 1, 2)));
+
+static size_t consoleWrite(const char* format, ...) {
+    if (consoleQuiet) {
+        return 0;
+    }
+    va_list args;
+    va_start(args, format);
+    int len = vprintf(format, args);
+    va_end(args);
+    return len > 0 ? (size_t)len : 0;
+}
+
+static size_t consoleWriteNumber(long long value, int base, bool isUnsigned) {
+    if (base == CONSOLE_HEX) {
+        return consoleWrite("%llX", (unsigned long long)value);
+    }
+    return isUnsigned ? consoleWrite("%llu", (unsigned long long)value) : consoleWrite("%lld", value);
+}
+
+void Console::begin(unsigned long baud) { (void)baud; }
+
+size_t Console::print(const char* text) { return consoleWrite("%s", text); }
+size_t Console::print(char c) { return consoleWrite("%c", c); }
+size_t Console::print(int value, int base) { return consoleWriteNumber(value, base, false); }
+size_t Console::print(unsigned int value, int base) { return consoleWriteNumber(value, base, true); }
+size_t Console::print(long value, int base) { return consoleWriteNumber(value, base, false); }
+size_t Console::print(unsigned long value, int base) { return consoleWriteNumber(value, base, true); }
+size_t Console::print(double value, int digits) { return consoleWrite("%.*f", digits, value); }
+
+size_t Console::println() { return consoleWrite("\n"); }
+size_t Console::println(const char* text) { return print(text) + println(); }
+size_t Console::println(char c) { return print(c) + println(); }
+size_t Console::println(int value, int base) { return print(value, base) + println(); }
+size_t Console::println(unsigned int value, int base) { return print(value, base) + println(); }
+size_t Console::println(long value, int base) { return print(value, base) + println(); }
+size_t Console::println(unsigned long value, int base) { return print(value, base) + println(); }
+size_t Console::println(double value, int digits) { return print(value, digits) + println(); }
+
+size_t Console::printf(const char* format, ...) {
+    if (consoleQuiet) {
+        return 0;
+    }
+    va_list args;
+    va_start(args, format);
+    int len = vprintf(format, args);
+    va_end(args);
+    return len > 0 ? (size_t)len : 0;
+}
+
+int Console::available() { return (int)consoleInput.size(); }
+
+int Console::read() {
+    if (consoleInput.empty()) {
+        return -1;
+    }
+    char c = consoleInput.front();
+    consoleInput.pop_front();
+    return c;
+}
+
+void HostConsole::feedInput(const char* text) {
+    while (*text) {
+        consoleInput.push_back(*text++);
+    }
+}
+
+void HostConsole::setQuiet(bool quiet) { consoleQuiet = quiet; }
+
+// ============================================================================
+// Gpio
+// ============================================================================
+
+static bool gpioLevels[HOST_PWM_MAX_PINS] = {};
+
+void Gpio::setOutput(uint8_t pin) { (void)pin; }
+
+void Gpio::write(uint8_t pin, bool level) {
+    if (pin < HOST_PWM_MAX_PINS) {
+        gpioLevels[pin] = level;
+    }
+}
+
+bool HostGpio::getLevel(uint8_t pin) {
+    return pin < HOST_PWM_MAX_PINS ? gpioLevels[pin] : false;
+}
+
+// ============================================================================
+// Imu (показания задает HostImu)
+// ============================================================================
+
+static bool imuPresent = true;
+static bool imuFailing = false;
+static float imuRates[3] = {};
+static float imuAccel[3] = {0.0f, 0.0f, -1.0f};
+static float imuNoiseDps = 0.0f;
+static float imuBiasDps[3] = {};
+static uint32_t imuRng = 1;
+static uint32_t imuReads = 0;
+
+// Равномерный шум -1..1 (LCG): воспроизводимый, без зависимости от <random>
+static float imuNoise() {
+    imuRng = imuRng * 1664525UL + 1013904223UL;
+    return (float)(imuRng >> 8) / (float)(1UL << 23) - 1.0f;
+}
+
+static int16_t imuCounts(float value, float scale) {
+    const long counts = lroundf(value * scale);
+    return (int16_t)(counts > 32767 ? 32767 : (counts < -32768 ? -32768 : counts));
+}
+
+bool Imu::begin() { return imuPresent; }
+
+bool Imu::read(ImuSample& sample) {
+    if (!imuPresent || imuFailing) {
+        return false;
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+        sample.gyro[i] = imuCounts(imuRates[i] + imuBiasDps[i] + imuNoiseDps * imuNoise(), IMU_GYRO_SCALE);
+        sample.accel[i] = imuCounts(imuAccel[i], IMU_ACCEL_SCALE);
+    }
+    sample.timestampUs = Clock::micros();
+    imuReads++;
+    return true;
+}
+
+void HostImu::setPresent(bool present) { imuPresent = present; }
+void HostImu::setFailing(bool failing) { imuFailing = failing; }
+
+void HostImu::setRates(float pDps, float qDps, float rDps) {
+    imuRates[0] = pDps;
+    imuRates[1] = qDps;
+    imuRates[2] = rDps;
+}
+
+void HostImu::setAccel(float xG, float yG, float zG) {
+    imuAccel[0] = xG;
+    imuAccel[1] = yG;
+    imuAccel[2] = zG;
+}
+
+void HostImu::setGyroNoise(float noiseDps, float biasDps, uint32_t seed) {
+    imuNoiseDps = noiseDps;
+    imuRng = seed != 0 ? seed : 1;
+    // Смещение нуля свое у каждой оси, в пределах ±biasDps
+    for (uint8_t i = 0; i < 3; i++) {
+        imuBiasDps[i] = biasDps * imuNoise();
+    }
+}
+
+uint32_t HostImu::getReadCount() { return imuReads; }
+
+// ============================================================================
+// PwmBank
+// ============================================================================
+
+static int pwmPulses[HOST_PWM_MAX_PINS] = {};
+static uint32_t pwmWrites[HOST_PWM_MAX_PINS] = {};
+static bool pwmAttached[HOST_PWM_MAX_PINS] = {};
+static HostPwm::WriteObserver pwmObserver = nullptr;
+
+bool PwmBank::hwAttach(uint8_t channel, uint8_t pin) {
+    (void)channel;
+    if (pin >= HOST_PWM_MAX_PINS) {
+        return false;
+    }
+    pwmAttached[pin] = true;
+    return true;
+}
+
+void PwmBank::hwDetach(uint8_t channel, uint8_t pin) {
+    (void)channel;
+    if (pin < HOST_PWM_MAX_PINS) {
+        pwmAttached[pin] = false;
+    }
+}
+
+void PwmBank::hwWrite(uint8_t channel, uint8_t pin, int pulseUs) {
+    (void)channel;
+    if (pin >= HOST_PWM_MAX_PINS) {
+        return;
+    }
+    pwmPulses[pin] = pulseUs;
+    pwmWrites[pin]++;
+    if (pwmObserver != nullptr) {
+        pwmObserver(pin, pulseUs);
+    }
+}
+
+void PwmBank::hwLatch(uint16_t channelMask) {
+    (void)channelMask;
+}
+
+int HostPwm::getPulseUs(uint8_t pin) { return pin < HOST_PWM_MAX_PINS ? pwmPulses[pin] : 0; }
+uint32_t HostPwm::getWriteCount(uint8_t pin) { return pin < HOST_PWM_MAX_PINS ? pwmWrites[pin] : 0; }
+bool HostPwm::isAttached(uint8_t pin) { return pin < HOST_PWM_MAX_PINS && pwmAttached[pin]; }
+void HostPwm::setObserver(WriteObserver observer) { pwmObserver = observer; }
+
+// ============================================================================
+// DshotOutput
+// ============================================================================
+
+struct HostDshotOutput {
+    bool attached;
+    uint8_t pin;
+    uint16_t speedKbps;
+    uint64_t lastFrameUs;
+    int value;
+    int lastCommand;
+    uint32_t frames;
+};
+
+static HostDshotOutput dshotOutputs[DSHOT_MAX_OUTPUTS] = {};
+static uint32_t dshotBadFrames = 0;
+
+bool DshotOutput::hwAttach(uint8_t output, uint8_t pin, uint16_t speedKbps) {
+    if (pin >= HOST_PWM_MAX_PINS) {
+        return false;
+    }
+    HostDshotOutput& state = dshotOutputs[output];
+    state = HostDshotOutput();
+    state.attached = true;
+    state.pin = pin;
+    state.speedKbps = speedKbps;
+    state.lastFrameUs = virtualTimeUs;
+    state.value = -1;
+    state.lastCommand = -1;
+    return true;
+}
+
+void DshotOutput::hwDetach(uint8_t output, uint8_t pin) {
+    (void)pin;
+    dshotOutputs[output].attached = false;
+}
+
+// Кадры, которые таймер отправил бы с прошлого чтения
+static HostDshotOutput* hostDshotTransmit(uint8_t pin) {
+    for (uint8_t output = 0; output < DSHOT_MAX_OUTPUTS; output++) {
+        HostDshotOutput& state = dshotOutputs[output];
+        if (!state.attached || state.pin != pin) {
+            continue;
+        }
+        const uint64_t periods = (virtualTimeUs - state.lastFrameUs) / DSHOT_FRAME_PERIOD_US;
+        state.lastFrameUs += periods * DSHOT_FRAME_PERIOD_US;
+        for (uint64_t i = 0; i < periods; i++) {
+            const int32_t frame = dshotDecode(DshotOutput::nextFrame(output), state.speedKbps);
+            state.frames++;
+            if (frame < 0) {
+                dshotBadFrames++;
+                continue;
+            }
+            state.value = dshotValue((uint16_t)frame);
+            if (state.value > DSHOT_CMD_MOTOR_STOP && state.value < DSHOT_THROTTLE_MIN) {
+                state.lastCommand = state.value;
+            }
+        }
+        return &state;
+    }
+    return nullptr;
+}
+
+bool HostDshot::isAttached(uint8_t pin) { return hostDshotTransmit(pin) != nullptr; }
+
+int HostDshot::getValue(uint8_t pin) {
+    const HostDshotOutput* state = hostDshotTransmit(pin);
+    return state != nullptr ? state->value : -1;
+}
+
+int HostDshot::getLastCommand(uint8_t pin) {
+    const HostDshotOutput* state = hostDshotTransmit(pin);
+    return state != nullptr ? state->lastCommand : -1;
+}
+
+uint32_t HostDshot::getFrameCount(uint8_t pin) {
+    const HostDshotOutput* state = hostDshotTransmit(pin);
+    return state != nullptr ? state->frames : 0;
+}
+
+uint32_t HostDshot::getBadFrames() { return dshotBadFrames; }
+
+// ============================================================================
+// Radio
+// ============================================================================
+
+static const uint8_t HOST_MAC[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+static Radio::ReceiveCallback radioCallback = nullptr;
+static bool radioStarted = false;
+static int radioRssi = -50;
+static uint32_t radioSent = 0;
+
+bool Radio::begin() {
+    radioStarted = true;
+    return true;
+}
+
+bool Radio::addPeer(const uint8_t mac[6]) {
+    (void)mac;
+    return radioStarted;
+}
+
+void Radio::onReceive(ReceiveCallback callback) { radioCallback = callback; }
+void Radio::getMacAddress(uint8_t mac[6]) { memcpy(mac, HOST_MAC, 6); }
+int Radio::getRssi() { return radioRssi; }
+bool Radio::send(const uint8_t mac[6], const uint8_t* data, int len) {
+    (void)mac;
+    (void)data;
+    (void)len;
+    radioSent++;
+    return radioStarted;
+}
+
+bool HostRadio::deliver(const uint8_t mac[6], const uint8_t* data, int len) {
+    if (!radioStarted || radioCallback == nullptr) {
+        return false;
+    }
+    radioCallback(mac, data, len, (int8_t)radioRssi);
+    return true;
+}
+
+void HostRadio::setRssi(int rssi) { radioRssi = rssi; }
+bool HostRadio::isStarted() { return radioStarted; }
+uint32_t HostRadio::getSentCount() { return radioSent; }
+
+// ============================================================================
+// Storage (память процесса)
+// ============================================================================
+
+static std::map<std::string, std::vector<uint8_t>> storageBlobs;
+static uint32_t storageWrites = 0;
+
+bool Storage::begin() { return true; }
+
+bool Storage::read(const char* key, void* data, size_t size) {
+    auto it = storageBlobs.find(key);
+    if (it == storageBlobs.end() || it->second.size() != size) {
+        return false;
+    }
+    memcpy(data, it->second.data(), size);
+    return true;
+}
+
+bool Storage::write(const char* key, const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    storageBlobs[key].assign(bytes, bytes + size);
+    storageWrites++;
+    return true;
+}
+
+bool Storage::erase(const char* key) {
+    storageBlobs.erase(key);
+    return true;
+}
+
+void HostStorage::clear() { storageBlobs.clear(); }
+uint32_t HostStorage::getWriteCount() { return storageWrites; }
+
+// ============================================================================
+// System
+// ============================================================================
+
+static ResetReason resetReason = RESET_POWER_ON;
+
+ResetReason System::getResetReason() { return resetReason; }
+void HostSystem::setResetReason(ResetReason reason) { resetReason = reason; }
@@ -0,0 +1,85 @@
+#pragma once
+#include <cstdint>
+#include "HAL/System.h"
+
+// Управление фейковым оборудованием хост-сборки.
+// Используется хост-программами (src/Host/*), на ESP32 не собирается
+
+#define HOST_PWM_MAX_PINS 40
+
+// Виртуальное время. Clock::delay() сдвигает его мгновенно
+class HostClock {
+public:
+    static uint64_t nowUs();
+    static void setUs(uint64_t us);
+    static void advanceUs(uint64_t us);
+};
+
+// Доставка кадров в зарегистрированный callback ESP-NOW
+class HostRadio {
+public:
+    static bool deliver(const uint8_t mac[6], const uint8_t* data, int len);
+    static void setRssi(int rssi);
+    static bool isStarted();
+    static uint32_t getSentCount();    // Кадров через Radio::send()
+};
+
+// Наблюдение за выходами PWM
+class HostPwm {
+public:
+    typedef void (*WriteObserver)(uint8_t pin, int pulseUs);
+
+    static int getPulseUs(uint8_t pin);
+    static uint32_t getWriteCount(uint8_t pin);
+    static bool isAttached(uint8_t pin);
+    static void setObserver(WriteObserver observer);
+};
+
+// Наблюдение за выходами DShot. Таймер кадров идет по виртуальному времени:
+// перед чтением передаются все кадры, которые он отправил бы к этому моменту,
+// и каждый декодируется обратно из символов RMT (dshotDecode)
+class HostDshot {
+public:
+    static bool isAttached(uint8_t pin);
+    static int getValue(uint8_t pin);           // Значение последнего кадра 0-2047, -1 - кадров не было
+    static int getLastCommand(uint8_t pin);     // Последняя команда 1-47, -1 - не было
+    static uint32_t getFrameCount(uint8_t pin);
+    static uint32_t getBadFrames();             // Символы, не декодируемые в кадр DShot
+};
+
+// Консоль: подмена ввода и отключение вывода
+class HostConsole {
+public:
+    static void feedInput(const char* text);
+    static void setQuiet(bool quiet);
+};
+
+// Содержимое "NVS" живет до конца процесса
+class HostStorage {
+public:
+    static void clear();
+    static uint32_t getWriteCount();
+};
+
+class HostGpio {
+public:
+    static bool getLevel(uint8_t pin);
+};
+
+// Датчик для хост-сборки: программа задает истинные угловые скорости и удельную
+// силу, Imu::read() отдает их с шумом и смещением нуля гироскопа, как MPU6050
+class HostImu {
+public:
+    static void setPresent(bool present);                       // false - Imu::begin() не найдет датчик
+    static void setFailing(bool failing);                       // true - Imu::read() возвращает ошибку шины
+    static void setRates(float pDps, float qDps, float rDps);   // Связанные оси, °/с
+    static void setAccel(float xG, float yG, float zG);         // Удельная сила, g
+    static void setGyroNoise(float noiseDps, float biasDps, uint32_t seed);
+    static uint32_t getReadCount();
+};
+
+// Причина сброса, которую увидит System::getResetReason()
+class HostSystem {
+public:
+    static void setResetReason(ResetReason reason);
+};
@@ -0,0 +1,181 @@
+#include "LinkSimulator.h"
+#include <cmath>
+#include <cstring>
+#include "HostHal.h"
+
+static const uint8_t SIM_TRANSMITTER_MAC[6] = {0x14, 0x33, 0x5C, 0x37, 0x82, 0x58};
+
+void LinkSimulator::makeDefaultModel(LinkModel& model) {
+    model = {};
+    model.lossModel = LINK_LOSS_NONE;
+    model.latencyModel = LINK_LATENCY_FIXED;
+    model.latencyUs = 1000;
+    model.duplicateDelayUs = 300;
+    model.reorderDelayUs = 30000;
+    model.rssi = -50;
+    model.rssiBadDrop = 20;
+}
+
+LinkSimulator::LinkSimulator(const LinkModel& model, uint64_t seed)
+    : model(model), rngState(seed * 0x9E3779B97F4A7C15ULL + 1) {
+}
+
+void LinkSimulator::addOutage(uint64_t startUs, uint64_t durationUs) {
+    outages.push_back({startUs, startUs + durationUs});
+}
+
+// xorshift64*: быстрый, воспроизводимый, без глобального состояния
+double LinkSimulator::uniform() {
+    rngState ^= rngState >> 12;
+    rngState ^= rngState << 25;
+    rngState ^= rngState >> 27;
+    return (double)((rngState * 0x2545F4914F6CDD1DULL) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+bool LinkSimulator::chance(float probability) {
+    return probability > 0 && uniform() < probability;
+}
+
+uint32_t LinkSimulator::sampleLatencyUs() {
+    switch (model.latencyModel) {
+        case LINK_LATENCY_UNIFORM:
+            return model.latencyUs + (uint32_t)(uniform() * model.spreadUs);
+        case LINK_LATENCY_NORMAL: {
+            // Бокс-Мюллер; отрицательный хвост обрезается
+            const double u1 = 1.0 - uniform();
+            const double u2 = uniform();
+            const double value = model.latencyUs + model.spreadUs * sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+            return value > 0 ? (uint32_t)value : 0;
+        }
+        case LINK_LATENCY_EXPONENTIAL:
+            return model.latencyUs + (uint32_t)(-log(1.0 - uniform()) * model.spreadUs);
+        default:
+            return model.latencyUs;
+    }
+}
+
+bool LinkSimulator::isLost(uint64_t sentUs) {
+    for (const Outage& outage : outages) {
+        if (sentUs >= outage.startUs && sentUs < outage.endUs) {
+            stats.blackedOut++;
+            return true;
+        }
+    }
+
+    bool lost = false;
+    if (model.lossModel == LINK_LOSS_BERNOULLI) {
+        lost = chance(model.lossProbability);
+    } else if (model.lossModel == LINK_LOSS_GILBERT_ELLIOTT) {
+        // Сначала переход состояния, потом потеря в новом состоянии
+        badState = badState ? !chance(model.badToGood) : chance(model.goodToBad);
+        lost = chance(badState ? model.lossInBad : model.lossInGood);
+    }
+    if (lost) {
+        stats.lost++;
+    }
+    return lost;
+}
+
+bool LinkSimulator::send(const uint8_t* data, int len, uint64_t sentUs) {
+    if (len <= 0 || len > LINK_SIM_FRAME_MAX) {
+        return false;
+    }
+    const uint32_t sendIndex = stats.sent++;
+    if (isLost(sentUs)) {
+        return true;
+    }
+
+    AirFrame frame;
+    frame.sentUs = sentUs;
+    frame.arrivalUs = sentUs + sampleLatencyUs();
+    frame.sendIndex = sendIndex;
+    frame.corrupted = false;
+    frame.duplicate = false;
+    frame.rssi = (int8_t)(model.rssi - (badState ? model.rssiBadDrop : 0));
+    frame.length = (uint8_t)len;
+    memcpy(frame.data, data, len);
+
+    if (chance(model.reorderProbability)) {
+        frame.arrivalUs += model.reorderDelayUs;
+    }
+    if (chance(model.corruptProbability)) {
+        // Разные биты: повторный переворот того же бита вернул бы кадр к исходному
+        const int flips = 1 + (int)(uniform() * 3);
+        uint32_t flipped[3];
+        for (int i = 0; i < flips; i++) {
+            uint32_t bit;
+            bool repeat;
+            do {
+                bit = (uint32_t)(uniform() * len * 8);
+                repeat = false;
+                for (int j = 0; j < i; j++) {
+                    repeat |= flipped[j] == bit;
+                }
+            } while (repeat);
+            flipped[i] = bit;
+            frame.data[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+        }
+        frame.corrupted = true;
+        stats.corrupted++;
+    }
+
+    frame.order = orderCounter++;
+    air.push(frame);
+
+    if (chance(model.duplicateProbability)) {
+        // Повтор на уровне MAC: та же копия чуть позже
+        frame.arrivalUs += model.duplicateDelayUs;
+        frame.duplicate = true;
+        frame.order = orderCounter++;
+        air.push(frame);
+        stats.duplicated++;
+    }
+    return true;
+}
+
+uint64_t LinkSimulator::nextArrivalUs() const {
+    return air.empty() ? UINT64_MAX : air.top().arrivalUs;
+}
+
+bool LinkSimulator::deliverNext(LinkDelivery* delivery) {
+    if (air.empty()) {
+        return false;
+    }
+    const AirFrame frame = air.top();
+    air.pop();
+
+    // Время не идет назад: кадр, "пришедший" в прошлом, отдается сейчас
+    const uint64_t arrivalUs = frame.arrivalUs > HostClock::nowUs() ? frame.arrivalUs : HostClock::nowUs();
+    const bool reordered = haveDelivered && frame.sendIndex < highestDelivered;
+    if (reordered) {
+        stats.reordered++;
+    }
+    if (!haveDelivered || frame.sendIndex > highestDelivered) {
+        highestDelivered = frame.sendIndex;
+    }
+    haveDelivered = true;
+    stats.delivered++;
+
+    HostClock::setUs(arrivalUs);
+    HostRadio::setRssi(frame.rssi);
+    HostRadio::deliver(SIM_TRANSMITTER_MAC, frame.data, frame.length);
+
+    if (delivery != nullptr) {
+        delivery->sentUs = frame.sentUs;
+        delivery->arrivalUs = arrivalUs;
+        delivery->sendIndex = frame.sendIndex;
+        delivery->corrupted = frame.corrupted;
+        delivery->duplicate = frame.duplicate;
+        delivery->reordered = reordered;
+    }
+    return true;
+}
+
+uint32_t LinkSimulator::deliverUntil(uint64_t untilUs) {
+    uint32_t count = 0;
+    while (!air.empty() && air.top().arrivalUs <= untilUs) {
+        deliverNext();
+        count++;
+    }
+    return count;
+}
@@ -0,0 +1,139 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <vector>
+
+// ============================================================================
+// МОДЕЛЬ КАНАЛА ESP-NOW ДЛЯ ХОСТ-СБОРКИ
+// ============================================================================
+//
+// Кадры передатчика (send) проходят через модель эфира: потери (Бернулли или
+// Гилберт-Эллиотт), задержка по распределению, дубли, перестановки, битые биты
+// и окна полной потери связи. Затем в момент прихода они подаются в callback
+// радио (HostRadio::deliver) на виртуальном времени - так же, как на самолете.
+//
+// Случайные числа - свой генератор с seed: один seed = один и тот же сценарий.
+
+#define LINK_SIM_FRAME_MAX  32
+
+enum LinkLossModel : uint8_t {
+    LINK_LOSS_NONE = 0,
+    LINK_LOSS_BERNOULLI,        // Каждый кадр теряется независимо
+    LINK_LOSS_GILBERT_ELLIOTT   // Два состояния канала: потери пачками
+};
+
+enum LinkLatencyModel : uint8_t {
+    LINK_LATENCY_FIXED = 0,     // latencyUs
+    LINK_LATENCY_UNIFORM,       // latencyUs + [0, spreadUs)
+    LINK_LATENCY_NORMAL,        // Среднее latencyUs, сигма spreadUs (не меньше 0)
+    LINK_LATENCY_EXPONENTIAL    // latencyUs + хвост со средним spreadUs
+};
+
+struct LinkModel {
+    uint8_t lossModel;
+    float lossProbability;      // Бернулли
+    float goodToBad;            // Гилберт-Эллиотт: вероятность перехода на кадр
+    float badToGood;
+    float lossInGood;
+    float lossInBad;
+
+    uint8_t latencyModel;
+    uint32_t latencyUs;
+    uint32_t spreadUs;
+
+    float duplicateProbability; // Кадр приходит дважды (копия - через duplicateDelayUs)
+    uint32_t duplicateDelayUs;
+    float reorderProbability;   // Кадр задерживается на reorderDelayUs сверх обычной задержки
+    uint32_t reorderDelayUs;
+    float corruptProbability;   // В кадре переворачиваются 1-3 бита
+
+    int8_t rssi;                // Хорошее состояние канала, дБм
+    int8_t rssiBadDrop;         // Плохое состояние (Гилберт-Эллиотт): на столько ниже
+};
+
+// Что случилось с кадром: для проверки хост-программой
+struct LinkDelivery {
+    uint64_t sentUs;
+    uint64_t arrivalUs;
+    uint32_t sendIndex;         // Порядковый номер send()
+    bool corrupted;
+    bool duplicate;             // Вторая копия
+    bool reordered;             // Пришел после кадра, отправленного позже
+};
+
+struct LinkSimStats {
+    uint32_t sent;
+    uint32_t lost;              // Потеряны моделью потерь
+    uint32_t blackedOut;        // Потеряны в окне полной потери связи
+    uint32_t delivered;
+    uint32_t duplicated;
+    uint32_t reordered;
+    uint32_t corrupted;
+};
+
+class LinkSimulator {
+public:
+    // Идеальный канал: без потерь, задержка 1 мс
+    static void makeDefaultModel(LinkModel& model);
+
+    LinkSimulator(const LinkModel& model, uint64_t seed);
+
+    // Окно, в котором теряется все (пилот улетел за пределы дальности)
+    void addOutage(uint64_t startUs, uint64_t durationUs);
+
+    // Передатчик отправил кадр в момент sentUs. false - кадр длиннее LINK_SIM_FRAME_MAX
+    bool send(const uint8_t* data, int len, uint64_t sentUs);
+
+    // Время прихода ближайшего кадра (UINT64_MAX - в эфире пусто)
+    uint64_t nextArrivalUs() const;
+
+    // Доставить ближайший кадр: виртуальное время сдвигается на момент прихода
+    bool deliverNext(LinkDelivery* delivery = nullptr);
+
+    // Доставить все кадры, пришедшие не позже untilUs
+    uint32_t deliverUntil(uint64_t untilUs);
+
+    size_t getInFlight() const { return air.size(); }
+    const LinkSimStats& getStats() const { return stats; }
+    const LinkModel& getModel() const { return model; }
+
+private:
+    struct AirFrame {
+        uint64_t sentUs;
+        uint64_t arrivalUs;
+        uint32_t sendIndex;
+        uint32_t order;             // Равные времена прихода - в порядке постановки
+        bool corrupted;
+        bool duplicate;
+        int8_t rssi;
+        uint8_t length;
+        uint8_t data[LINK_SIM_FRAME_MAX];
+    };
+
+    struct LaterArrival {
+        bool operator()(const AirFrame& a, const AirFrame& b) const {
+            return a.arrivalUs != b.arrivalUs ? a.arrivalUs > b.arrivalUs : a.order > b.order;
+        }
+    };
+
+    struct Outage {
+        uint64_t startUs;
+        uint64_t endUs;
+    };
+
+    LinkModel model;
+    uint64_t rngState;
+    bool badState = false;
+    uint32_t orderCounter = 0;
+    bool haveDelivered = false;
+    uint32_t highestDelivered = 0;
+    std::priority_queue<AirFrame, std::vector<AirFrame>, LaterArrival> air;
+    std::vector<Outage> outages;
+    LinkSimStats stats = {};
+
+    double uniform();               // [0, 1)
+    bool chance(float probability);
+    uint32_t sampleLatencyUs();
+    bool isLost(uint64_t sentUs);
+};
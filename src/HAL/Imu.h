@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+
+// Инерциальный датчик: гироскоп и акселерометр в связанных осях самолета
+// (x - вперед, y - вправо, z - вниз; положительный крен - правым крылом вниз).
+// ESP32: MPU6050 по I2C, ось x микросхемы - по полету, лицом вверх.
+// Хост: показания задает HostImu (модель полета, шум и смещение нуля).
+//
+// Единицы одинаковые для любого датчика: драйвер пересчитывает свои отсчеты,
+// поэтому стабилизатор не зависит от диапазона и модели микросхемы.
+
+#define IMU_GYRO_SCALE    16        // Отсчетов на 1 °/с: ±2047 °/с в int16
+#define IMU_ACCEL_SCALE   4096      // Отсчетов на 1 g: ±8 g в int16
+
+struct ImuSample {
+    int16_t gyro[3];        // p, q, r
+    int16_t accel[3];       // Удельная сила: в горизонтальном полете z = -IMU_ACCEL_SCALE
+    uint32_t timestampUs;   // Clock::micros() момента чтения
+};
+
+class Imu {
+public:
+    // Поиск и настройка датчика. false - датчика нет
+    static bool begin();
+
+    // Последние показания. false - ошибка шины, sample не изменен
+    static bool read(ImuSample& sample);
+};
@@ -0,0 +1,132 @@
+#include "PwmBank.h"
+
+uint8_t PwmBank::pins[PWM_BANK_MAX_CHANNELS] = {};
+int16_t PwmBank::minPulses[PWM_BANK_MAX_CHANNELS] = {};
+int16_t PwmBank::maxPulses[PWM_BANK_MAX_CHANNELS] = {};
+int16_t PwmBank::pulses[PWM_BANK_MAX_CHANNELS] = {};
+int16_t PwmBank::stopPulses[PWM_BANK_MAX_CHANNELS] = {};
+int8_t PwmBank::dshotOutputs[PWM_BANK_MAX_CHANNELS] = {};
+uint16_t PwmBank::attachedMask = 0;
+uint16_t PwmBank::dshotMask = 0;
+uint16_t PwmBank::dirtyMask = 0;
+uint8_t PwmBank::channelCount = 0;
+uint32_t PwmBank::commitCount = 0;
+uint32_t PwmBank::channelWrites = 0;
+
+int8_t PwmBank::attach(uint8_t pin, int minPulseUs, int maxPulseUs) {
+    for (uint8_t channel = 0; channel < PWM_BANK_MAX_CHANNELS; channel++) {
+        if (attachedMask & (1u << channel)) {
+            continue;
+        }
+        if (!hwAttach(channel, pin)) {
+            return -1;
+        }
+        pins[channel] = pin;
+        minPulses[channel] = (int16_t)minPulseUs;
+        maxPulses[channel] = (int16_t)maxPulseUs;
+        pulses[channel] = 0;
+        attachedMask |= (1u << channel);
+        channelCount++;
+        return (int8_t)channel;
+    }
+    return -1;
+}
+
+int8_t PwmBank::attachDshot(uint8_t pin, int minPulseUs, int stopPulseUs, int maxPulseUs, uint16_t speedKbps) {
+    for (uint8_t channel = 0; channel < PWM_BANK_MAX_CHANNELS; channel++) {
+        if (attachedMask & (1u << channel)) {
+            continue;
+        }
+        const int8_t output = DshotOutput::attach(pin, speedKbps);
+        if (output < 0) {
+            return -1;
+        }
+        pins[channel] = pin;
+        minPulses[channel] = (int16_t)minPulseUs;
+        maxPulses[channel] = (int16_t)maxPulseUs;
+        stopPulses[channel] = (int16_t)stopPulseUs;
+        pulses[channel] = 0;
+        dshotOutputs[channel] = output;
+        attachedMask |= (1u << channel);
+        dshotMask |= (1u << channel);
+        channelCount++;
+        return (int8_t)channel;
+    }
+    return -1;
+}
+
+bool PwmBank::sendDshotCommand(int8_t channel, uint8_t command, uint8_t repeat) {
+    if (!isDshot(channel)) {
+        return false;
+    }
+    // После команды ESC получает стоп: повторный stage() стопа не перебьет команду
+    DshotOutput::command(dshotOutputs[channel], command, repeat);
+    pulses[channel] = stopPulses[channel];
+    dirtyMask &= ~(1u << channel);
+    return true;
+}
+
+void PwmBank::detach(int8_t channel) {
+    if (channel < 0 || channel >= PWM_BANK_MAX_CHANNELS || !(attachedMask & (1u << channel))) {
+        return;
+    }
+    if (dshotMask & (1u << channel)) {
+        DshotOutput::detach(dshotOutputs[channel]);
+    } else {
+        hwDetach(channel, pins[channel]);
+    }
+    attachedMask &= ~(1u << channel);
+    dshotMask &= ~(1u << channel);
+    dirtyMask &= ~(1u << channel);
+    channelCount--;
+}
+
+void PwmBank::stage(int8_t channel, int pulseUs) {
+    if (channel < 0 || channel >= PWM_BANK_MAX_CHANNELS) {
+        return;
+    }
+    if (pulseUs < minPulses[channel]) pulseUs = minPulses[channel];
+    if (pulseUs > maxPulses[channel]) pulseUs = maxPulses[channel];
+
+    // Неизменившийся канал в железо не пишется
+    if (pulses[channel] != pulseUs) {
+        pulses[channel] = (int16_t)pulseUs;
+        dirtyMask |= (1u << channel);
+    }
+}
+
+uint8_t PwmBank::commit() {
+    const uint16_t mask = dirtyMask & attachedMask;
+    dirtyMask = 0;
+    if (mask == 0) {
+        return 0;
+    }
+
+    // Сначала все регистры, потом одна защелка: каналы не расходятся по кадрам
+    uint8_t written = 0;
+    for (uint8_t channel = 0; channel < PWM_BANK_MAX_CHANNELS; channel++) {
+        if (!(mask & (1u << channel))) {
+            continue;
+        }
+        if (dshotMask & (1u << channel)) {
+            // Кадр уходит со следующего периода DShot, защелка LEDC не нужна
+            DshotOutput::write(dshotOutputs[channel], dshotFromPulse(pulses[channel], minPulses[channel],
+                                                                     stopPulses[channel], maxPulses[channel]));
+        } else {
+            hwWrite(channel, pins[channel], pulses[channel]);
+        }
+        written++;
+    }
+    hwLatch(mask & ~dshotMask);
+
+    commitCount++;
+    channelWrites += written;
+    return written;
+}
+
+int PwmBank::getPulseUs(int8_t channel) {
+    if (channel < 0 || channel >= PWM_BANK_MAX_CHANNELS) {
+        return 0;
+    }
+    return pulses[channel];
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include "HAL/DshotOutput.h"
+
+// ============================================================================
+// БАНК ВЫХОДОВ PWM: все каналы на одном периоде 50 Гц
+// ============================================================================
+//
+// Значения копятся через stage() (только в памяти), commit() передает в железо
+// лишь изменившиеся каналы. Новое значение защелкивается аппаратно на границе
+// периода, поэтому все поверхности меняются в одном и том же кадре.
+//
+// ESP32: драйвер LEDC напрямую. Каналы 0-7 - high-speed, 8-9 - low-speed;
+// оба таймера запускаются одновременно, так что передние фронты совпадают.
+// Хост: значения уходят в HostPwm.
+//
+// Канал DShot (attachDshot) принимает те же микросекунды, но commit() переводит
+// их в значение газа и отдает DshotOutput - кадры идут со своей частотой, без LEDC.
+
+#define PWM_BANK_MAX_CHANNELS  10
+#define PWM_BANK_FREQUENCY_HZ  50
+#define PWM_BANK_PERIOD_US     (1000000 / PWM_BANK_FREQUENCY_HZ)
+
+class PwmBank {
+public:
+    // Занять канал под вывод. Возвращает номер канала или -1, если каналы кончились
+    static int8_t attach(uint8_t pin, int minPulseUs, int maxPulseUs);
+    static void detach(int8_t channel);
+
+    // Занять канал под ESC DShot. stopPulseUs > minPulseUs - двунаправленный ESC (3D)
+    static int8_t attachDshot(uint8_t pin, int minPulseUs, int stopPulseUs, int maxPulseUs, uint16_t speedKbps);
+    static bool isDshot(int8_t channel) { return channel >= 0 && channel < PWM_BANK_MAX_CHANNELS && (dshotMask & (1u << channel)); }
+
+    // Команда ESC (DSHOT_CMD_*) мимо stage()/commit(). false - канал не DShot
+    static bool sendDshotCommand(int8_t channel, uint8_t command, uint8_t repeat);
+
+    // Запомнить новую ширину импульса (с ограничением диапазоном канала)
+    static void stage(int8_t channel, int pulseUs);
+
+    // Отправить все измененные каналы. Возвращает число записанных каналов
+    static uint8_t commit();
+
+    static int getPulseUs(int8_t channel);
+    static uint8_t getChannelCount() { return channelCount; }
+    static uint32_t getCommitCount() { return commitCount; }
+    static uint32_t getChannelWrites() { return channelWrites; }
+
+private:
+    // Платформенная часть: Esp32Hal.cpp / HostHal.cpp
+    static bool hwAttach(uint8_t channel, uint8_t pin);
+    static void hwDetach(uint8_t channel, uint8_t pin);
+    static void hwWrite(uint8_t channel, uint8_t pin, int pulseUs);   // Только регистр скважности
+    static void hwLatch(uint16_t channelMask);                        // Защелкнуть на границе периода
+
+    static uint8_t pins[PWM_BANK_MAX_CHANNELS];
+    static int16_t minPulses[PWM_BANK_MAX_CHANNELS];
+    static int16_t maxPulses[PWM_BANK_MAX_CHANNELS];
+    static int16_t pulses[PWM_BANK_MAX_CHANNELS];
+    static int16_t stopPulses[PWM_BANK_MAX_CHANNELS];     // Только DShot
+    static int8_t dshotOutputs[PWM_BANK_MAX_CHANNELS];
+    static uint16_t attachedMask;
+    static uint16_t dshotMask;
+    static uint16_t dirtyMask;
+    static uint8_t channelCount;
+    static uint32_t commitCount;
+    static uint32_t channelWrites;
+};
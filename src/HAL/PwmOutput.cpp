@@ -0,0 +1,41 @@
+#include "PwmOutput.h"
+
+bool PwmOutput::attach(uint8_t pin, int minPulse, int maxPulse) {
+    minPulseUs = minPulse;
+    maxPulseUs = maxPulse;
+    if (channel < 0) {
+        channel = PwmBank::attach(pin, minPulse, maxPulse);
+    }
+    return channel >= 0;
+}
+
+bool PwmOutput::attachDshot(uint8_t pin, int minPulse, int stopPulse, int maxPulse, uint16_t speedKbps) {
+    minPulseUs = minPulse;
+    maxPulseUs = maxPulse;
+    if (channel < 0) {
+        channel = PwmBank::attachDshot(pin, minPulse, stopPulse, maxPulse, speedKbps);
+    }
+    return channel >= 0;
+}
+
+void PwmOutput::detach() {
+    PwmBank::detach(channel);
+    channel = -1;
+}
+
+void PwmOutput::write(int angle) {
+    stage(angle);
+    PwmBank::commit();
+}
+
+void PwmOutput::stage(int angle) {
+    // Как ESP32Servo: угол 0-180° линейно в диапазон импульсов
+    if (angle < 0) angle = 0;
+    if (angle > 180) angle = 180;
+    stageMicroseconds(minPulseUs + (maxPulseUs - minPulseUs) * angle / 180);
+}
+
+void PwmOutput::writeMicroseconds(int us) {
+    PwmBank::stage(channel, us);
+    PwmBank::commit();
+}
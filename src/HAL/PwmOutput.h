@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+#include "HAL/PwmBank.h"
+
+// Один выход PWM для сервопривода/ESC (50 Гц, ширина импульса в микросекундах).
+// Канал PwmBank: write*() отправляют значение сразу, stageMicroseconds() только
+// запоминает его до общего PwmBank::commit() в конце тика управления
+class PwmOutput {
+public:
+    bool attach(uint8_t pin, int minPulseUs, int maxPulseUs);
+    // ESC по DShot: те же микросекунды, кадры вместо импульса (PwmBank::attachDshot)
+    bool attachDshot(uint8_t pin, int minPulseUs, int stopPulseUs, int maxPulseUs, uint16_t speedKbps);
+    bool sendCommand(uint8_t command, uint8_t repeat) { return PwmBank::sendDshotCommand(channel, command, repeat); }
+    void detach();
+    void write(int angle);              // 0-180°, пересчитывается в импульс
+    void writeMicroseconds(int us);
+    void stageMicroseconds(int us) { PwmBank::stage(channel, us); }
+    void stage(int angle);              // Угол до PwmBank::commit()
+    int readMicroseconds() const { return PwmBank::getPulseUs(channel); }
+    int8_t getChannel() const { return channel; }
+
+private:
+    int8_t channel = -1;
+    int minPulseUs = 544;
+    int maxPulseUs = 2400;
+};
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+
+// Радиоканал ESP-NOW.
+// ESP32: WiFi STA + esp_now. Хост: кадры доставляет HostRadio.
+// rssi - уровень сигнала именно этого кадра (WiFi.RSSI() у STA без точки доступа бессмыслен)
+class Radio {
+public:
+    typedef void (*ReceiveCallback)(const uint8_t* mac, const uint8_t* data, int len, int8_t rssi);
+
+    static bool begin();
+    static bool addPeer(const uint8_t mac[6]);
+    static void onReceive(ReceiveCallback callback);
+    static void getMacAddress(uint8_t mac[6]);
+    static int getRssi();   // RSSI последнего принятого кадра, dBm
+    static bool send(const uint8_t mac[6], const uint8_t* data, int len);   // Без ожидания подтверждения
+};
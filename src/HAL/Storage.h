@@ -0,0 +1,20 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Энергонезависимое хранилище блоков по ключу.
+// ESP32: NVS (пространство имен STORAGE_NAMESPACE). Хост: память процесса (HostStorage).
+// Запись во flash на ESP32 на время стирания останавливает кэш обоих ядер -
+// вызывать только из loop(), не из тика управления и не из callback.
+
+#define STORAGE_NAMESPACE  "flight"
+
+class Storage {
+public:
+    static bool begin();
+
+    // false - ключа нет или размер блока не совпадает
+    static bool read(const char* key, void* data, size_t size);
+    static bool write(const char* key, const void* data, size_t size);
+    static bool erase(const char* key);
+};
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+
+// Причина последнего сброса.
+// ESP32: esp_reset_reason(). Хост: задается HostSystem::setResetReason()
+enum ResetReason : uint8_t {
+    RESET_POWER_ON = 0,     // Подано питание
+    RESET_EXTERNAL,         // Вывод EN (кнопка, автосброс при открытии монитора порта)
+    RESET_SOFTWARE,         // esp_restart()
+    RESET_PANIC,            // Исключение / abort()
+    RESET_WATCHDOG,         // Любой сторожевой таймер
+    RESET_BROWNOUT,         // Просадка питания
+    RESET_OTHER
+};
+
+class System {
+public:
+    static ResetReason getResetReason();
+
+    // Теплый сброс - перезапуск без участия оператора (например, в полете):
+    // питание ESC, скорее всего, не пропадало
+    static bool isWarmReset() {
+        const ResetReason reason = getResetReason();
+        return reason == RESET_SOFTWARE || reason == RESET_PANIC ||
+               reason == RESET_WATCHDOG || reason == RESET_BROWNOUT;
+    }
+
+    static const char* getResetReasonName(ResetReason reason) {
+        static const char* const NAMES[] = {"POWER ON", "EXTERNAL", "SOFTWARE", "PANIC",
+                                            "WATCHDOG", "BROWNOUT", "OTHER"};
+        return reason <= RESET_OTHER ? NAMES[reason] : NAMES[RESET_OTHER];
+    }
+};
@@ -0,0 +1,175 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC 1
+#else
+#define BENCH_HAS_TSC 0
+#endif
+
+// Минимальный харнесс микро-бенчмарков для хост-сборки:
+// прогрев, несколько повторов, медиана, разброс и минимум времени на одну операцию.
+// Все результаты копятся в benchResults() - из них строится JSON (--json).
+
+#define BENCH_DEFAULT_ITERATIONS 200000
+#define BENCH_REPEATS            15
+
+// Приемник результатов, чтобы компилятор не выбросил измеряемый код
+extern volatile uint32_t benchSink;
+
+struct BenchResult {
+    const char* group;
+    const char* name;
+    double medianNs;
+    double minNs;
+    double maxNs;
+    double meanNs;
+    double stddevNs;
+    double tscPerOp;        // Тики TSC на операцию (медиана), 0 - счетчика нет
+    uint32_t iterations;
+};
+
+inline std::vector<BenchResult>& benchResults() {
+    static std::vector<BenchResult> results;
+    return results;
+}
+
+inline const char*& benchCurrentGroup() {
+    static const char* group = "";
+    return group;
+}
+
+// Начало группы: короткий id для JSON и заголовок для человека
+inline void beginBenchGroup(const char* id, const char* title) {
+    benchCurrentGroup() = id;
+    printf("%s\n", title);
+}
+
+inline uint64_t benchTsc() {
+#if BENCH_HAS_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+template <typename Fn>
+BenchResult runBenchmark(const char* name, Fn fn, uint32_t iterations = BENCH_DEFAULT_ITERATIONS) {
+    typedef std::chrono::steady_clock BenchClock;
+
+    // Прогрев: кэши, предсказатель переходов
+    for (uint32_t i = 0; i < iterations / 10; i++) {
+        fn(i);
+    }
+
+    double samples[BENCH_REPEATS];
+    double ticks[BENCH_REPEATS];
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        BenchClock::time_point start = BenchClock::now();
+        const uint64_t tscStart = benchTsc();
+        for (uint32_t i = 0; i < iterations; i++) {
+            fn(i);
+        }
+        const uint64_t tscEnd = benchTsc();
+        BenchClock::time_point end = BenchClock::now();
+        samples[r] = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+        ticks[r] = (double)(tscEnd - tscStart) / iterations;
+    }
+
+    double sum = 0;
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        sum += samples[r];
+    }
+    const double mean = sum / BENCH_REPEATS;
+    double variance = 0;
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        variance += (samples[r] - mean) * (samples[r] - mean);
+    }
+
+    std::sort(samples, samples + BENCH_REPEATS);
+    std::sort(ticks, ticks + BENCH_REPEATS);
+
+    BenchResult result;
+    result.group = benchCurrentGroup();
+    result.name = name;
+    result.medianNs = samples[BENCH_REPEATS / 2];
+    result.minNs = samples[0];
+    result.maxNs = samples[BENCH_REPEATS - 1];
+    result.meanNs = mean;
+    result.stddevNs = std::sqrt(variance / (BENCH_REPEATS - 1));
+    result.tscPerOp = ticks[BENCH_REPEATS / 2];
+    result.iterations = iterations;
+    return result;
+}
+
+inline void printBenchResult(const BenchResult& result) {
+    benchResults().push_back(result);
+    printf("  %-28s %9.2f ns/op  (min %.2f, max %.2f, sd %.2f)\n",
+           result.name, result.medianNs, result.minNs, result.maxNs, result.stddevNs);
+}
+
+// Одна строка на результат: файл читается и jq, и построчно (--baseline)
+inline bool writeBenchJson(const char* path, const char* label) {
+    FILE* file = fopen(path, "w");
+    if (file == nullptr) {
+        return false;
+    }
+    const std::vector<BenchResult>& results = benchResults();
+    fprintf(file, "{\n  \"suite\": \"hot-path\",\n  \"label\": \"%s\",\n  \"unit\": \"ns/op\",\n"
+                  "  \"repeats\": %d,\n  \"tsc\": %s,\n  \"results\": [\n",
+            label, BENCH_REPEATS, BENCH_HAS_TSC ? "true" : "false");
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        fprintf(file, "    {\"group\": \"%s\", \"name\": \"%s\", \"median_ns\": %.3f, \"min_ns\": %.3f, "
+                      "\"max_ns\": %.3f, \"mean_ns\": %.3f, \"stddev_ns\": %.3f, \"tsc_per_op\": %.1f, "
+                      "\"iterations\": %lu}%s\n",
+                r.group, r.name, r.medianNs, r.minNs, r.maxNs, r.meanNs, r.stddevNs, r.tscPerOp,
+                (unsigned long)r.iterations, i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+    return true;
+}
+
+// Сравнение с прошлым прогоном (файл writeBenchJson). Сравниваются минимумы:
+// на общей машине медиана гуляет от шума соседей, минимум - почти нет.
+// Возвращает число результатов, ставших медленнее больше чем на thresholdPercent
+inline int compareBenchBaseline(const char* path, double thresholdPercent) {
+    FILE* file = fopen(path, "r");
+    if (file == nullptr) {
+        printf("❌ %s: cannot read baseline\n", path);
+        return -1;
+    }
+
+    printf("Against baseline %s (min ns/op, threshold +%.0f%%)\n", path, thresholdPercent);
+    int regressions = 0;
+    char line[512];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        char group[64];
+        char name[64];
+        double median = 0;
+        double minimum = 0;
+        if (sscanf(line, " {\"group\": \"%63[^\"]\", \"name\": \"%63[^\"]\", \"median_ns\": %lf, \"min_ns\": %lf",
+                   group, name, &median, &minimum) != 4) {
+            continue;
+        }
+        for (const BenchResult& r : benchResults()) {
+            if (strcmp(r.group, group) != 0 || strcmp(r.name, name) != 0) {
+                continue;
+            }
+            const double change = minimum > 0 ? (r.minNs - minimum) * 100.0 / minimum : 0;
+            const bool regressed = change > thresholdPercent;
+            regressions += regressed;
+            printf("  %-12s %-28s %9.2f -> %9.2f ns  %+6.1f%%%s\n", group, name, minimum, r.minNs,
+                   change, regressed ? "  ❌ REGRESSION" : "");
+        }
+    }
+    fclose(file);
+    return regressions;
+}
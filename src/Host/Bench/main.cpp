@@ -0,0 +1,439 @@
+// Хост-бенчмарки ([env:native_bench]).
+// pio run -e native_bench && .pio/build/native_bench/program [--json <файл>] [--label <коммит>]
+//                                                             [--baseline <файл> [--threshold <%>]]
+//
+// --json     результаты в JSON (медиана, разброс, тики TSC на операцию) для сравнения между коммитами
+// --baseline сравнить с прошлым JSON; код возврата 1, если что-то стало медленнее порога
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "Bench.h"
+#include "HAL/Hal.h"
+#include "HAL/Host/HostHal.h"
+#include "Core/Crc16.h"
+#include "Core/Types.h"
+#include "Communication/ControlFrame.h"
+#include "Control/StickCurve.h"
+#include "Control/Mixer.h"
+#include "Control/InputFilter.h"
+#include "Control/Stabilizer.h"
+#include "Actuators/ServoManager.h"
+#include "Communication/LinkStats.h"
+#include "Communication/ESPNowManager.h"
+#include "Core/ConfigStore.h"
+
+volatile uint32_t benchSink = 0;
+
+#define BENCH_REGRESSION_THRESHOLD 15.0    // %, по умолчанию для --baseline
+
+#define BENCH_PACKET_COUNT 64
+
+static ControlData packets[BENCH_PACKET_COUNT];
+static uint8_t frames[BENCH_PACKET_COUNT][CONTROL_FRAME_SIZE];
+static uint8_t legacyFrames[BENCH_PACKET_COUNT][sizeof(LegacyControlData)];
+
+static void preparePackets() {
+    uint32_t seed = 12345;
+    for (int i = 0; i < BENCH_PACKET_COUNT; i++) {
+        seed = seed * 1103515245 + 12345;
+        packets[i].xAxis1 = (int16_t)((seed >> 8) % 1024) - 512;
+        seed = seed * 1103515245 + 12345;
+        packets[i].yAxis1 = (int16_t)((seed >> 8) % 1024) - 512;
+        seed = seed * 1103515245 + 12345;
+        packets[i].xAxis2 = (int16_t)((seed >> 8) % 1024) - 512;
+        seed = seed * 1103515245 + 12345;
+        packets[i].yAxis2 = (int16_t)((seed >> 8) % 1024) - 512;
+        packets[i].button1 = seed & 1;
+        packets[i].button2 = (seed >> 1) & 1;
+        packets[i].buttons = (uint8_t)(seed >> 16);
+        packets[i].sequence = (uint16_t)i;
+        packets[i].senderTimeMs = (uint16_t)(i * 20);
+        ControlFrame::encode(packets[i], frames[i]);
+        ControlFrame::encodeLegacy(packets[i], legacyFrames[i]);
+    }
+}
+
+static const uint8_t* packetBytes(uint32_t i) {
+    return frames[i % BENCH_PACKET_COUNT];
+}
+
+// Сколько искажений каждого вида НЕ обнаруживает контрольная сумма
+template <typename Checksum>
+static void countUndetected(const char* name, Checksum checksum) {
+    const size_t len = CONTROL_FRAME_SIZE - 2;
+    uint32_t swaps = 0, swapTotal = 0;
+    uint32_t doubleFlips = 0, doubleFlipTotal = 0;
+
+    for (int p = 0; p < BENCH_PACKET_COUNT; p++) {
+        const uint8_t* original = frames[p];
+        uint16_t reference = checksum(original, len);
+
+        // Перестановка соседних байтов
+        for (size_t i = 0; i + 1 < len; i++) {
+            if (original[i] == original[i + 1]) continue;
+            uint8_t corrupted[CONTROL_FRAME_SIZE];
+            memcpy(corrupted, original, sizeof(corrupted));
+            corrupted[i] = original[i + 1];
+            corrupted[i + 1] = original[i];
+            swapTotal++;
+            if (checksum(corrupted, len) == reference) swaps++;
+        }
+
+        // Два перевернутых бита
+        for (size_t a = 0; a < len * 8; a += 3) {
+            for (size_t b = a + 1; b < len * 8; b += 5) {
+                uint8_t corrupted[CONTROL_FRAME_SIZE];
+                memcpy(corrupted, original, sizeof(corrupted));
+                corrupted[a / 8] ^= (uint8_t)(1 << (a % 8));
+                corrupted[b / 8] ^= (uint8_t)(1 << (b % 8));
+                doubleFlipTotal++;
+                if (checksum(corrupted, len) == reference) doubleFlips++;
+            }
+        }
+    }
+
+    printf("  %-28s byte swaps %lu/%lu, 2-bit flips %lu/%lu undetected\n", name,
+           (unsigned long)swaps, (unsigned long)swapTotal,
+           (unsigned long)doubleFlips, (unsigned long)doubleFlipTotal);
+}
+
+static void benchPacketIntegrity() {
+    const size_t len = CONTROL_FRAME_SIZE - 2;
+
+    char title[64];
+    snprintf(title, sizeof(title), "Packet integrity (%u bytes covered by CRC)", (unsigned)len);
+    beginBenchGroup("integrity", title);
+    printBenchResult(runBenchmark("legacy additive sum", [&](uint32_t i) {
+        benchSink += Crc16::legacySum(packetBytes(i), len);
+    }));
+    printBenchResult(runBenchmark("crc16 bitwise", [&](uint32_t i) {
+        benchSink += Crc16::computeBitwise(packetBytes(i), len);
+    }));
+    printBenchResult(runBenchmark("crc16 table", [&](uint32_t i) {
+        benchSink += Crc16::computeTable(packetBytes(i), len);
+    }));
+
+    printf("Error detection\n");
+    countUndetected("legacy additive sum", Crc16::legacySum);
+    countUndetected("crc16", Crc16::computeTable);
+}
+
+static void benchWireFormat() {
+    char title[64];
+    snprintf(title, sizeof(title), "Wire format (v1 %u bytes, legacy %u bytes)",
+             (unsigned)CONTROL_FRAME_SIZE, (unsigned)sizeof(LegacyControlData));
+    beginBenchGroup("wire", title);
+    printBenchResult(runBenchmark("encode v1", [&](uint32_t i) {
+        uint8_t frame[CONTROL_FRAME_SIZE];
+        ControlFrame::encode(packets[i % BENCH_PACKET_COUNT], frame);
+        benchSink += frame[CONTROL_FRAME_SIZE - 1];
+    }));
+    printBenchResult(runBenchmark("decode v1", [&](uint32_t i) {
+        ControlData data = {};
+        benchSink += ControlFrame::decode(frames[i % BENCH_PACKET_COUNT], CONTROL_FRAME_SIZE, data);
+        benchSink += data.xAxis1;
+    }));
+    printBenchResult(runBenchmark("decode legacy", [&](uint32_t i) {
+        ControlData data = {};
+        benchSink += ControlFrame::decode(legacyFrames[i % BENCH_PACKET_COUNT],
+                                          sizeof(LegacyControlData), data);
+        benchSink += data.xAxis1;
+    }));
+}
+
+static long arduinoMap(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+static void benchStickMapping() {
+    static constexpr CurveTable curve = buildCurveTable({20, 30, 100, false});
+
+    beginBenchGroup("mapping", "Stick mapping (one axis -> two surfaces)");
+    printBenchResult(runBenchmark("deadzone + map()", [&](uint32_t i) {
+        int16_t axis = packets[i % BENCH_PACKET_COUNT].yAxis1;
+        if (axis > -20 && axis < 20) axis = 0;
+        benchSink += arduinoMap(axis, -512, 512, 0, 180);
+        benchSink += arduinoMap(axis, -512, 512, 180, 0);
+    }));
+    printBenchResult(runBenchmark("curve lookup + scale", [&](uint32_t i) {
+        int16_t normalized = curve.lookup(packets[i % BENCH_PACKET_COUNT].yAxis1);
+        benchSink += scaleToRange(normalized, 0, 90, 180);
+        benchSink += scaleToRange(-normalized, 0, 90, 180);
+    }));
+}
+
+static void benchMixer() {
+    static const MixRule rules[] = {
+        {0, MIX_IN_PITCH, 100}, {1, MIX_IN_PITCH, 100},
+        {2, MIX_IN_YAW, 100}, {3, MIX_IN_YAW, 100},
+        {4, MIX_IN_ROLL, 100}, {5, MIX_IN_ROLL, 100},
+        {6, MIX_IN_FLAPS, 70}, {6, MIX_IN_ROLL, -50},
+        {7, MIX_IN_FLAPS, 70}, {7, MIX_IN_ROLL, 50},
+        {8, MIX_IN_THROTTLE, 100},
+    };
+    Mixer mixer;
+    for (uint8_t o = 0; o < 8; o++) {
+        mixer.configureOutput(o, 0, 90, 180, (o & 1) != 0);
+    }
+    mixer.configureOutput(8, 1000, 1100, 2000, false, true);
+    mixer.loadRules(rules, sizeof(rules) / sizeof(rules[0]));
+
+    beginBenchGroup("mixer", "Mixer (5 inputs -> 9 outputs)");
+    printBenchResult(runBenchmark("mixer evaluate", [&](uint32_t i) {
+        const ControlData& p = packets[i % BENCH_PACKET_COUNT];
+        int16_t inputs[MIXER_INPUT_COUNT] = {
+            (int16_t)(p.xAxis2 * 2), (int16_t)(p.yAxis1 * 2), (int16_t)(p.xAxis1 * 2),
+            (int16_t)(p.yAxis2 * 2), (int16_t)(p.button1 ? CURVE_SCALE : 0)
+        };
+        int16_t outputs[MIXER_MAX_OUTPUTS];
+        mixer.evaluate(inputs, outputs);
+        benchSink += outputs[0] + outputs[7] + outputs[8];
+    }));
+}
+
+static void benchInputFilter() {
+    StickFilter roll, pitch, yaw;
+    ThrottleFilter throttle;
+    AxisPipeline<Median3, Butterworth8Hz50Hz, Deadzone<20>, SlewLimit<64>> full;
+    Deadzone<DEADZONE_XAXIS1> deadzoneX1;
+    Deadzone<DEADZONE_YAXIS1> deadzoneY1;
+    Deadzone<DEADZONE_XAXIS2> deadzoneX2;
+    Deadzone<DEADZONE_YAXIS2> deadzoneY2;
+
+    beginBenchGroup("filter", "Input conditioning (per packet)");
+    printBenchResult(runBenchmark("configured filters x4 axes", [&](uint32_t i) {
+        const ControlData& p = packets[i % BENCH_PACKET_COUNT];
+        benchSink += roll.process(p.xAxis2) + pitch.process(p.yAxis1) +
+                     yaw.process(p.xAxis1) + throttle.process(p.yAxis2);
+    }));
+    printBenchResult(runBenchmark("all stages (biquad) x1 axis", [&](uint32_t i) {
+        benchSink += full.process(packets[i % BENCH_PACKET_COUNT].yAxis1);
+    }));
+    printBenchResult(runBenchmark("deadzone x4 axes", [&](uint32_t i) {
+        const ControlData& p = packets[i % BENCH_PACKET_COUNT];
+        benchSink += deadzoneX1.process(p.xAxis1) + deadzoneY1.process(p.yAxis1) +
+                     deadzoneX2.process(p.xAxis2) + deadzoneY2.process(p.yAxis2);
+    }));
+}
+
+static void benchStabilizer() {
+    FlightConfig config;
+    ServoManager::makeDefaultConfig(config);
+
+    // Калибровка нуля по неподвижному датчику, затем "полет" с меняющимися скоростями
+    HostImu::setRates(0, 0, 0);
+    HostImu::setAccel(0, 0, -1);
+    HostImu::setGyroNoise(0.2f, 1.0f, 777);
+    Stabilizer stabilizer;
+    stabilizer.begin();
+    stabilizer.applyConfig(config);
+    for (uint16_t i = 0; i < IMU_CALIBRATION_SAMPLES; i++) {
+        HostClock::advanceUs(2000);
+        stabilizer.sample();
+    }
+    FixedPid<PID_GAIN_SHIFT, PID_DTERM_LPF_SHIFT> pids[3];
+    for (uint8_t a = 0; a < 3; a++) {
+        pids[a].setGains({PID_PITCH_KP, PID_PITCH_KI, PID_PITCH_KD, PID_PITCH_KFF});
+        pids[a].setOutputLimit(CURVE_SCALE);
+    }
+
+    beginBenchGroup("stabilizer", "Stabilization (per control tick, 3 axes)");
+    printBenchResult(runBenchmark("PID update x3", [&](uint32_t i) {
+        const ControlData& p = packets[i % BENCH_PACKET_COUNT];
+        benchSink += pids[0].update(p.xAxis2 * 16, p.yAxis1 * 8, 2000) +
+                     pids[1].update(p.yAxis1 * 16, p.xAxis1 * 8, 2000) +
+                     pids[2].update(p.xAxis1 * 16, p.xAxis2 * 8, 2000);
+    }));
+    for (uint8_t mode = FLIGHT_MODE_RATE; mode <= FLIGHT_MODE_ANGLE; mode++) {
+        char name[40];
+        snprintf(name, sizeof(name), "sample + apply %s", Stabilizer::getModeName(mode));
+        printBenchResult(runBenchmark(name, [&](uint32_t i) {
+            const ControlData& p = packets[i % BENCH_PACKET_COUNT];
+            HostClock::advanceUs(2000);
+            HostImu::setRates(p.xAxis1 / 4.0f, p.yAxis1 / 8.0f, p.xAxis2 / 16.0f);
+            stabilizer.sample();
+            int16_t inputs[MIXER_INPUT_COUNT] = {
+                (int16_t)(p.xAxis2 * 2), (int16_t)(p.yAxis1 * 2), (int16_t)(p.xAxis1 * 2), 0, 0
+            };
+            stabilizer.apply(inputs, mode);
+            benchSink += inputs[MIX_IN_ROLL] + inputs[MIX_IN_PITCH] + inputs[MIX_IN_YAW];
+        }));
+    }
+    HostImu::setGyroNoise(0, 0, 0);
+}
+
+static void benchLinkStats() {
+    LinkStats stats;
+
+    // Каждый 50-й пакет потерян, каждый 200-й пришел дважды
+    beginBenchGroup("linkstats", "Link statistics");
+    printBenchResult(runBenchmark("link stats onFrame", [&](uint32_t i) {
+        const uint16_t sequence = (uint16_t)(i + i / 50);
+        const uint32_t arrivalUs = i * 20000 + (i * 7919) % 800;
+        stats.onFrame(sequence, true, arrivalUs, (int8_t)(-60 - (int8_t)(i & 15)));
+        if (i % 200 == 0) {
+            stats.onFrame(sequence, true, arrivalUs + 50, -60);
+        }
+    }));
+    benchSink += stats.getSnapshot().received;
+}
+
+// ============================================================================
+// ГОРЯЧИЙ ПУТЬ ЦЕЛИКОМ: настоящие ESPNowManager / ServoManager на фейковом HAL
+// ============================================================================
+
+static const uint8_t TRANSMITTER_MAC[6] = {0x14, 0x33, 0x5C, 0x37, 0x82, 0x58};
+static const uint32_t PACKET_PERIOD_US = 20000;
+
+static ServoManager servoManager;
+static uint8_t corruptFrames[BENCH_PACKET_COUNT][CONTROL_FRAME_SIZE];
+
+static void onBenchPacket(const ControlData& data) {
+    benchSink += data.xAxis1;
+}
+
+// Инициализация с delay() проходит мгновенно на виртуальном времени
+static void prepareHotPath() {
+    HostConsole::setQuiet(true);
+    FlightConfig defaults;
+    ServoManager::makeDefaultConfig(defaults);
+    ConfigStore::getInstance().begin(defaults);
+    servoManager.begin();
+
+    ESPNowManager& espNowManager = ESPNowManager::getInstance();
+    espNowManager.begin();
+    espNowManager.registerCallback(onBenchPacket);
+    HostConsole::setQuiet(false);
+
+    for (int i = 0; i < BENCH_PACKET_COUNT; i++) {
+        memcpy(corruptFrames[i], frames[i], CONTROL_FRAME_SIZE);
+        corruptFrames[i][2 + i % (CONTROL_FRAME_SIZE - 4)] ^= 0x10;
+    }
+}
+
+static void benchReceive() {
+    beginBenchGroup("receive", "Receive path (ESPNowManager::onDataReceived, callback is a no-op)");
+    printBenchResult(runBenchmark("valid frame", [&](uint32_t i) {
+        HostClock::advanceUs(PACKET_PERIOD_US);
+        HostRadio::deliver(TRANSMITTER_MAC, frames[i % BENCH_PACKET_COUNT], CONTROL_FRAME_SIZE);
+    }));
+    printBenchResult(runBenchmark("CRC error frame", [&](uint32_t i) {
+        HostClock::advanceUs(PACKET_PERIOD_US);
+        HostRadio::deliver(TRANSMITTER_MAC, corruptFrames[i % BENCH_PACKET_COUNT], CONTROL_FRAME_SIZE);
+    }));
+}
+
+static void benchServoUpdate() {
+    beginBenchGroup("update", "ServoManager end to end (filters, curves, mixer, PWM commit)");
+    printBenchResult(runBenchmark("update (new packet)", [&](uint32_t i) {
+        HostClock::advanceUs(PACKET_PERIOD_US);
+        servoManager.update(packets[i % BENCH_PACKET_COUNT]);
+    }));
+    printBenchResult(runBenchmark("updateEstimate (between)", [&](uint32_t) {
+        HostClock::advanceUs(PACKET_PERIOD_US / 4);
+        servoManager.updateEstimate(Clock::micros());
+    }));
+}
+
+static void benchOutputBank() {
+    const uint8_t channels = PwmBank::getChannelCount();
+
+    char title[64];
+    snprintf(title, sizeof(title), "Output driver (PwmBank, %u channels)", (unsigned)channels);
+    beginBenchGroup("output", title);
+    printBenchResult(runBenchmark("stage all + commit", [&](uint32_t i) {
+        for (uint8_t c = 0; c < channels; c++) {
+            PwmBank::stage((int8_t)c, 1000 + (int)((i + c * 97) % 1000));
+        }
+        benchSink += PwmBank::commit();
+    }));
+    printBenchResult(runBenchmark("commit unchanged", [&](uint32_t) {
+        benchSink += PwmBank::commit();
+    }));
+}
+
+// Для сравнения с таблицей полубайтов: символ на каждый бит кадра
+static DshotSymbols dshotEncodeBitwise(uint16_t frame, uint16_t speedKbps) {
+    DshotSymbols out;
+    for (uint8_t bit = 0; bit < DSHOT_FRAME_BITS; bit++) {
+        out.symbols[bit] = dshotBitSymbol((frame >> (15 - bit)) & 1, speedKbps);
+    }
+    return out;
+}
+
+static void benchDshot() {
+    static constexpr DshotNibbleTable table = dshotMakeNibbles(DSHOT300);
+
+    beginBenchGroup("dshot", "DShot300 frame (throttle -> checksum -> 16 RMT symbols)");
+    printBenchResult(runBenchmark("per-bit symbols", [&](uint32_t i) {
+        const DshotSymbols frame = dshotEncodeBitwise(dshotFrame((uint16_t)(48 + i % 2000), false), DSHOT300);
+        benchSink += frame.symbols[i % DSHOT_FRAME_BITS];
+    }));
+    printBenchResult(runBenchmark("nibble table", [&](uint32_t i) {
+        const DshotSymbols frame = dshotEncode(dshotFrame((uint16_t)(48 + i % 2000), false), table);
+        benchSink += frame.symbols[i % DSHOT_FRAME_BITS];
+    }));
+}
+
+static void printUsage() {
+    printf("Usage: native_bench [--json <file>] [--label <commit>] [--baseline <file> [--threshold <%%>]]\n");
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = nullptr;
+    const char* label = "";
+    const char* baselinePath = nullptr;
+    double threshold = BENCH_REGRESSION_THRESHOLD;
+
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--json") == 0 && hasValue) {
+            jsonPath = argv[++i];
+        } else if (strcmp(argv[i], "--label") == 0 && hasValue) {
+            label = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && hasValue) {
+            baselinePath = argv[++i];
+        } else if (strcmp(argv[i], "--threshold") == 0 && hasValue) {
+            threshold = atof(argv[++i]);
+        } else {
+            printUsage();
+            return 2;
+        }
+    }
+
+    preparePackets();
+    prepareHotPath();
+    benchPacketIntegrity();
+    benchWireFormat();
+    benchReceive();
+    benchInputFilter();
+    benchStickMapping();
+    benchMixer();
+    benchStabilizer();
+    benchServoUpdate();
+    benchOutputBank();
+    benchDshot();
+    benchLinkStats();
+
+    if (jsonPath != nullptr) {
+        if (!writeBenchJson(jsonPath, label)) {
+            printf("❌ %s: cannot write\n", jsonPath);
+            return 2;
+        }
+        printf("📄 %u results -> %s\n", (unsigned)benchResults().size(), jsonPath);
+    }
+
+    if (baselinePath != nullptr) {
+        const int regressions = compareBenchBaseline(baselinePath, threshold);
+        if (regressions < 0) {
+            return 2;
+        }
+        if (regressions > 0) {
+            printf("❌ %d regression(s) over +%.0f%%\n", regressions, threshold);
+            return 1;
+        }
+        printf("✅ No regressions\n");
+    }
+    return 0;
+}
@@ -0,0 +1,220 @@
+#include "Airframe.h"
+#include <cmath>
+
+#define AIR_DENSITY  1.225
+#define GRAVITY      9.80665
+
+void Airframe::makeDefaultParams(AirframeParams& params) {
+    params.mass = 1.2f;
+    params.wingArea = 0.26f;
+    params.span = 1.3f;
+    params.chord = 0.2f;
+    params.ixx = 0.05f;
+    params.iyy = 0.06f;
+    params.izz = 0.10f;
+
+    params.cl0 = 0.25f;
+    params.clAlpha = 4.8f;
+    params.clQ = 5.0f;
+    params.clFlaps = 0.4f;
+    params.clMax = 1.2f;
+    params.cd0 = 0.035f;
+    params.cdInduced = 0.06f;
+    params.cdFlaps = 0.04f;
+    params.cyBeta = -0.35f;
+    params.cyRudder = 0.1f;
+    params.clBeta = -0.04f;
+    params.clP = -0.45f;
+    params.clR = 0.1f;
+    params.clAileron = 0.08f;
+    params.cm0 = 0.015f;            // Балансировка около 15 м/с без отклонения РВ
+    params.cmAlpha = -0.9f;
+    params.cmQ = -12.0f;
+    params.cmElevator = 0.35f;
+    params.cmFlaps = -0.05f;
+    params.cnBeta = 0.07f;
+    params.cnP = -0.03f;
+    params.cnR = -0.25f;
+    params.cnRudder = 0.05f;
+    params.cnAileron = -0.005f;
+
+    params.thrustMax = 10.0f;
+    params.thrustZeroSpeed = 35.0f;
+    params.motorTimeConstant = 0.05f;
+    params.surfaceRate = 5.0f;      // Полный ход (-1..+1) за 0.4 с: ~60° за 0.13 с
+}
+
+Airframe::Airframe(const AirframeParams& params) : params(params) {
+    reset(100.0, 15.0);
+}
+
+void Airframe::reset(double altitude, double speed) {
+    // Угол атаки, при котором подъемная сила равна весу
+    const double dynamicPressure = 0.5 * AIR_DENSITY * speed * speed;
+    const double clTrim = params.mass * GRAVITY / (dynamicPressure * params.wingArea);
+    const double alpha = (clTrim - params.cl0) / params.clAlpha;
+
+    state = {};
+    state.down = -altitude;
+    state.u = speed * cos(alpha);
+    state.w = speed * sin(alpha);
+    // Тангаж = угол атаки: траектория горизонтальна
+    state.q0 = cos(alpha / 2);
+    state.q2 = sin(alpha / 2);
+    actual = {};
+}
+
+double Airframe::getAirspeed() const {
+    return sqrt(state.u * state.u + state.v * state.v + state.w * state.w);
+}
+
+double Airframe::getAlphaRad() const {
+    return atan2(state.w, state.u);
+}
+
+void Airframe::getEulerRad(double& roll, double& pitch, double& yaw) const {
+    const AirframeState& s = state;
+    roll = atan2(2 * (s.q0 * s.q1 + s.q2 * s.q3), 1 - 2 * (s.q1 * s.q1 + s.q2 * s.q2));
+    const double sinPitch = 2 * (s.q0 * s.q2 - s.q3 * s.q1);
+    pitch = fabs(sinPitch) >= 1 ? copysign(M_PI / 2, sinPitch) : asin(sinPitch);
+    yaw = atan2(2 * (s.q0 * s.q3 + s.q1 * s.q2), 1 - 2 * (s.q2 * s.q2 + s.q3 * s.q3));
+}
+
+void Airframe::derivative(const AirframeState& s, AirframeState& d, double* force) const {
+    const AirframeParams& a = params;
+    const double speed = fmax(sqrt(s.u * s.u + s.v * s.v + s.w * s.w), 1.0);
+    const double alpha = atan2(s.w, s.u);
+    const double beta = asin(fmax(-1.0, fmin(1.0, s.v / speed)));
+    const double qS = 0.5 * AIR_DENSITY * speed * speed * a.wingArea;
+    const double pHat = s.p * a.span / (2 * speed);
+    const double qHat = s.q * a.chord / (2 * speed);
+    const double rHat = s.r * a.span / (2 * speed);
+
+    // Аэродинамические коэффициенты
+    double cl = a.cl0 + a.clAlpha * alpha + a.clQ * qHat + a.clFlaps * actual.flaps;
+    cl = fmax(-a.clMax, fmin(a.clMax, cl));
+    const double cd = a.cd0 + a.cdInduced * cl * cl + a.cdFlaps * fabs(actual.flaps);
+    const double cy = a.cyBeta * beta + a.cyRudder * actual.rudder;
+    const double cRoll = a.clBeta * beta + a.clP * pHat + a.clR * rHat + a.clAileron * actual.aileron;
+    const double cPitch = a.cm0 + a.cmAlpha * alpha + a.cmQ * qHat + a.cmElevator * actual.elevator +
+                          a.cmFlaps * actual.flaps;
+    const double cYaw = a.cnBeta * beta + a.cnP * pHat + a.cnR * rHat + a.cnRudder * actual.rudder +
+                        a.cnAileron * actual.aileron;
+
+    // Силы в связанных осях: аэродинамика (из скоростных осей), тяга, вес
+    const double thrust = a.thrustMax * actual.throttle * fmax(0.0, 1.0 - speed / a.thrustZeroSpeed);
+    const double gx = 2 * (s.q1 * s.q3 - s.q0 * s.q2) * GRAVITY;
+    const double gy = 2 * (s.q2 * s.q3 + s.q0 * s.q1) * GRAVITY;
+    const double gz = (s.q0 * s.q0 - s.q1 * s.q1 - s.q2 * s.q2 + s.q3 * s.q3) * GRAVITY;
+    const double fx = qS * (-cd * cos(alpha) + cl * sin(alpha)) + thrust;
+    const double fy = qS * cy;
+    const double fz = qS * (-cd * sin(alpha) - cl * cos(alpha));
+
+    if (force != nullptr) {
+        force[0] = fx / a.mass;
+        force[1] = fy / a.mass;
+        force[2] = fz / a.mass;
+    }
+
+    d.u = fx / a.mass + gx + s.r * s.v - s.q * s.w;
+    d.v = fy / a.mass + gy + s.p * s.w - s.r * s.u;
+    d.w = fz / a.mass + gz + s.q * s.u - s.p * s.v;
+
+    d.p = (qS * a.span * cRoll - (a.izz - a.iyy) * s.q * s.r) / a.ixx;
+    d.q = (qS * a.chord * cPitch - (a.ixx - a.izz) * s.p * s.r) / a.iyy;
+    d.r = (qS * a.span * cYaw - (a.iyy - a.ixx) * s.p * s.q) / a.izz;
+
+    d.q0 = 0.5 * (-s.q1 * s.p - s.q2 * s.q - s.q3 * s.r);
+    d.q1 = 0.5 * (s.q0 * s.p + s.q2 * s.r - s.q3 * s.q);
+    d.q2 = 0.5 * (s.q0 * s.q - s.q1 * s.r + s.q3 * s.p);
+    d.q3 = 0.5 * (s.q0 * s.r + s.q1 * s.q - s.q2 * s.p);
+
+    // Скорость в NED
+    d.north = (s.q0 * s.q0 + s.q1 * s.q1 - s.q2 * s.q2 - s.q3 * s.q3) * s.u +
+              2 * (s.q1 * s.q2 - s.q0 * s.q3) * s.v + 2 * (s.q1 * s.q3 + s.q0 * s.q2) * s.w;
+    d.east = 2 * (s.q1 * s.q2 + s.q0 * s.q3) * s.u +
+             (s.q0 * s.q0 - s.q1 * s.q1 + s.q2 * s.q2 - s.q3 * s.q3) * s.v +
+             2 * (s.q2 * s.q3 - s.q0 * s.q1) * s.w;
+    d.down = 2 * (s.q1 * s.q3 - s.q0 * s.q2) * s.u + 2 * (s.q2 * s.q3 + s.q0 * s.q1) * s.v +
+             (s.q0 * s.q0 - s.q1 * s.q1 - s.q2 * s.q2 + s.q3 * s.q3) * s.w;
+}
+
+static float approach(float current, float target, float maxStep) {
+    const float delta = target - current;
+    return delta > maxStep ? current + maxStep : (delta < -maxStep ? current - maxStep : target);
+}
+
+// s + d * h
+static void advance(const AirframeState& s, const AirframeState& d, double h, AirframeState& out) {
+    const double* src = &s.north;
+    const double* rate = &d.north;
+    double* dst = &out.north;
+    for (int i = 0; i < (int)(sizeof(AirframeState) / sizeof(double)); i++) {
+        dst[i] = src[i] + rate[i] * h;
+    }
+}
+
+void Airframe::step(const AirframeControls& command, double dt) {
+    // Сервоприводы: ограничение скорости, мотор: инерционное звено
+    const float maxStep = params.surfaceRate * 2.0f * (float)dt;
+    actual.aileron = approach(actual.aileron, command.aileron, maxStep);
+    actual.elevator = approach(actual.elevator, command.elevator, maxStep);
+    actual.rudder = approach(actual.rudder, command.rudder, maxStep);
+    actual.flaps = approach(actual.flaps, command.flaps, maxStep);
+    actual.throttle += (command.throttle - actual.throttle) * (float)(dt / (params.motorTimeConstant + dt));
+
+    AirframeState k1, k2, k3, k4, temp;
+    derivative(state, k1, specificForce);
+    advance(state, k1, dt / 2, temp);
+    derivative(temp, k2);
+    advance(state, k2, dt / 2, temp);
+    derivative(temp, k3);
+    advance(state, k3, dt, temp);
+    derivative(temp, k4);
+
+    double* x = &state.north;
+    const double* d1 = &k1.north;
+    const double* d2 = &k2.north;
+    const double* d3 = &k3.north;
+    const double* d4 = &k4.north;
+    for (int i = 0; i < (int)(sizeof(AirframeState) / sizeof(double)); i++) {
+        x[i] += dt / 6 * (d1[i] + 2 * d2[i] + 2 * d3[i] + d4[i]);
+    }
+
+    const double norm = sqrt(state.q0 * state.q0 + state.q1 * state.q1 + state.q2 * state.q2 + state.q3 * state.q3);
+    state.q0 /= norm;
+    state.q1 /= norm;
+    state.q2 /= norm;
+    state.q3 /= norm;
+}
+
+// ============================================================================
+// Эталонные установившиеся реакции (одна ось, без перекрестных связей)
+// ============================================================================
+
+double Airframe::steadyRollRate(double aileron, double speed) const {
+    // Момент элеронов уравновешен демпфированием крена
+    const double pHat = -params.clAileron * aileron / params.clP;
+    return pHat * 2 * speed / params.span;
+}
+
+double Airframe::steadyPitchRate(double elevator, double speed) const {
+    // Прирост угла атаки дает перегрузку, перегрузка - скорость тангажа q = dL / (m V);
+    // демпфирование Cmq уменьшает прирост
+    const double qS = 0.5 * AIR_DENSITY * speed * speed * params.wingArea;
+    const double rateGain = qS * params.clAlpha / (params.mass * speed);
+    const double dampingPerAlpha = params.cmQ * params.chord / (2 * speed) * rateGain;
+    const double deltaAlpha = -params.cmElevator * elevator / (params.cmAlpha + dampingPerAlpha);
+    return rateGain * deltaAlpha;
+}
+
+double Airframe::steadyYawRate(double rudder, double speed) const {
+    // Путевой момент: Cnβ·β + Cnr·r̂ + Cnδr·δr = 0; боковая сила разворачивает скорость: r = Y / (m V)
+    const double qS = 0.5 * AIR_DENSITY * speed * speed * params.wingArea;
+    const double k = qS / (params.mass * speed);
+    const double rHatPerR = params.span / (2 * speed);
+    // r = k (CYβ β + CYδr δr),  β = -(Cnr r̂ + Cnδr δr) / Cnβ
+    const double a = 1 + k * params.cyBeta * params.cnR * rHatPerR / params.cnBeta;
+    const double b = k * (params.cyRudder - params.cyBeta * params.cnRudder / params.cnBeta) * rudder;
+    return b / a;
+}
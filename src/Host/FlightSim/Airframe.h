@@ -0,0 +1,89 @@
+#pragma once
+#include <cstdint>
+
+// ============================================================================
+// МОДЕЛЬ ПЛАНЕРА: 6 степеней свободы, фиксированный шаг (хост-сборка)
+// ============================================================================
+//
+// Твердое тело с диагональным тензором инерции, линейная аэродинамика в
+// производных устойчивости (с ограничением CL на срыве), тяга винта падает
+// со скоростью. Интегрирование - Рунге-Кутта 4-го порядка.
+//
+// Оси: связанные x - вперед, y - вправо, z - вниз; земля - NED.
+// Отклонения поверхностей нормированы (-1..+1 = полный ход) и заданы в смысле
+// команды: +элероны - крен вправо, +РВ - кабрирование, +РН - нос вправо,
+// +закрылки - вниз. Скорость перекладки ограничена, мотор - инерционное звено.
+
+struct AirframeParams {
+    float mass;             // кг
+    float wingArea;         // S, м²
+    float span;             // b, м
+    float chord;            // c, м
+    float ixx, iyy, izz;    // кг·м²
+
+    float cl0, clAlpha, clQ, clFlaps, clMax;
+    float cd0, cdInduced, cdFlaps;
+    float cyBeta, cyRudder;
+    float clBeta, clP, clR, clAileron;      // Момент крена (Cl)
+    float cm0, cmAlpha, cmQ, cmElevator, cmFlaps;
+    float cnBeta, cnP, cnR, cnRudder, cnAileron;
+
+    float thrustMax;        // Статическая тяга, Н
+    float thrustZeroSpeed;  // Скорость, при которой тяга падает до нуля, м/с
+    float motorTimeConstant;
+    float surfaceRate;      // Скорость перекладки, полных ходов (0..1) в секунду
+};
+
+// Команды на выходах: из импульсов ServoManager
+struct AirframeControls {
+    float aileron;
+    float elevator;
+    float rudder;
+    float flaps;
+    float throttle;         // 0..1
+};
+
+struct AirframeState {
+    double north, east, down;           // м
+    double u, v, w;                     // Скорость в связанных осях, м/с
+    double q0, q1, q2, q3;              // Кватернион связанные -> NED
+    double p, q, r;                     // Угловые скорости, рад/с
+};
+
+class Airframe {
+public:
+    // Пенопластовый тренер размахом 1.3 м, ~1.2 кг
+    static void makeDefaultParams(AirframeParams& params);
+
+    explicit Airframe(const AirframeParams& params);
+
+    // Горизонтальный полет на высоте altitude со скоростью speed (угол атаки - балансировочный)
+    void reset(double altitude, double speed);
+
+    // Один шаг dt: поверхности и мотор догоняют команды, затем RK4
+    void step(const AirframeControls& command, double dt);
+
+    const AirframeState& getState() const { return state; }
+    const AirframeControls& getActual() const { return actual; }
+    double getAirspeed() const;
+    double getAltitude() const { return -state.down; }
+    double getAlphaRad() const;
+    void getEulerRad(double& roll, double& pitch, double& yaw) const;
+
+    // Удельная сила в связанных осях (показания акселерометра), м/с², на начало шага
+    const double* getSpecificForce() const { return specificForce; }
+
+    // Установившаяся угловая скорость одной изолированной оси на отклонение
+    // поверхности при скорости speed - эталон "линейный стик без задержек"
+    double steadyRollRate(double aileron, double speed) const;
+    double steadyPitchRate(double elevator, double speed) const;
+    double steadyYawRate(double rudder, double speed) const;
+
+private:
+    AirframeParams params;
+    AirframeState state;
+    AirframeControls actual;
+    double specificForce[3] = {};
+
+    void derivative(const AirframeState& s, AirframeState& d, double* force = nullptr) const;
+};
@@ -0,0 +1,705 @@
+// Полет в замкнутом контуре на хосте ([env:native_flightsim]).
+//
+// Стики (сценарий или запись полета) идут кадрами ESP-NOW через настоящие
+// ESPNowManager -> ControlTask -> ServoManager::update(); импульсы на выходах
+// переводятся в отклонения поверхностей и газ модели планера (Airframe.h).
+// Все на виртуальном времени, быстрее реального в сотни и тысячи раз.
+//
+// Отчет по каждой оси: ошибка слежения - СКО угловой скорости от эталона
+// "линейный стик без задержек" (установившаяся реакция оси на отклонение,
+// пропорциональное стику); для ступенек сценария - время установления (±10%)
+// и перерегулирование. Так сравниваются экспонента, расходы, микшер, фильтры
+// и оценка между пакетами.
+//
+// Датчик IMU (HostImu) получает угловые скорости и удельную силу модели, режим
+// полета задает --mode (биты кнопок пакета). В RATE эталон - заданная скорость
+// (стик x pid_rate), в ANGLE для крена и тангажа сравниваются углы, °: стик x level_angle.
+//
+//   program [--scenario level|steps|doublets|sweep|all] [--recording <файл>]
+//           [--mode manual|rate|angle] [--gyro-noise <°/с>[:<смещение °/с>]]
+//           [--set <поле>[:индекс]=<значение>]... [--sweep <поле>[:индекс]=<от>:<до>:<шаг>]
+//           [--csv <файл>]
+//
+// Поля - как в консольной команде '=' (ConfigStore::setField): expo, rate_high, pid_p, ...
+// Параметры сборки (MIXER_PRESET, INPUT_SLEW_LIMIT, ESTIMATOR_MODE) сравниваются
+// правкой #define и пересборкой.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+#include <vector>
+#include "HAL/Hal.h"
+#include "HAL/Host/HostHal.h"
+#include "Core/Types.h"
+#include "Core/ConfigStore.h"
+#include "Actuators/ServoManager.h"
+#include "Communication/ESPNowManager.h"
+#include "Communication/ControlFrame.h"
+#include "Control/ControlTask.h"
+#include "Diagnostics/EventLog.h"
+#include "Diagnostics/FlightRecorder.h"
+#include "Airframe.h"
+
+// Модель - самолет: выходы читаются по каналам профиля самолета
+#if AIRFRAME_PROFILE != AIRFRAME_PLANE
+#error "FlightSim models the plane profile only (AIRFRAME_PROFILE = AIRFRAME_PLANE)"
+#endif
+
+#define FLIGHTSIM_PHYSICS_HZ        1000    // Шаг модели
+#define FLIGHTSIM_PACKET_PERIOD_US  20000   // Пульт: 50 пакетов/с
+#define FLIGHTSIM_LEAD_IN_MS        3000    // Нейтраль до старта: вооружение ESC, фильтры
+#define FLIGHTSIM_START_ALTITUDE    150.0
+#define FLIGHTSIM_START_SPEED       15.0
+#define FLIGHTSIM_TRIM_THROTTLE     100     // Стик газа (рабочая половина 0..512) для горизонтального полета ~15 м/с
+#define FLIGHTSIM_SETTLE_BAND       0.10    // Полоса установления: ±10% ...
+#define FLIGHTSIM_SETTLE_FLOOR_DPS  3.0     // ... но не уже ±3 °/с
+#define FLIGHTSIM_MOTOR_STOP_US     1000    // Импульс ESC "стоп" и полный газ
+#define FLIGHTSIM_MOTOR_FULL_US     2000
+#define FLIGHTSIM_IMU_SEED          12345
+#define FLIGHTSIM_GRAVITY           9.80665 // м/с² на 1 g акселерометра
+
+ServoManager servoManager;
+static ControlTask* controlTask = nullptr;
+static uint8_t flightMode = FLIGHT_MODE_MANUAL;     // --mode: уходит в биты кнопок пакета
+
+static const uint8_t TRANSMITTER_MAC[6] = {0x14, 0x33, 0x5C, 0x37, 0x82, 0x58};
+
+static void onDataReceived(const ControlData& data) {
+    controlTask->submit(data);
+}
+
+// ============================================================================
+// Стики
+// ============================================================================
+
+enum SimAxis { AXIS_ROLL = 0, AXIS_PITCH, AXIS_YAW, AXIS_COUNT };
+
+static const char* const AXIS_NAMES[AXIS_COUNT] = {"roll", "pitch", "yaw"};
+
+// Стики в долях полного хода (-1..+1), газ - сырое значение оси
+struct Sticks {
+    float axis[AXIS_COUNT];
+    int16_t throttle;
+};
+
+// Ступенька сценария: на ней меряется установление
+struct StepEvent {
+    uint8_t axis;
+    float amplitude;
+    uint32_t startMs;
+    uint32_t durationMs;
+};
+
+struct Scenario {
+    const char* name;
+    uint32_t durationMs;
+    const StepEvent* steps;
+    uint8_t stepCount;
+    void (*sticksAt)(const Scenario& scenario, uint32_t ms, Sticks& sticks);
+};
+
+static void sticksFromSteps(const Scenario& scenario, uint32_t ms, Sticks& sticks) {
+    for (uint8_t i = 0; i < scenario.stepCount; i++) {
+        const StepEvent& step = scenario.steps[i];
+        if (ms >= step.startMs && ms < step.startMs + step.durationMs) {
+            sticks.axis[step.axis] = step.amplitude;
+        }
+    }
+}
+
+// Качание крена с нарастающей частотой 0.2 -> 3 Гц
+static void sticksSweep(const Scenario& scenario, uint32_t ms, Sticks& sticks) {
+    const double t = ms / 1000.0;
+    const double duration = scenario.durationMs / 1000.0;
+    const double f0 = 0.2;
+    const double f1 = 3.0;
+    const double phase = 2 * M_PI * (f0 * t + (f1 - f0) * t * t / (2 * duration));
+    sticks.axis[AXIS_ROLL] = (float)(0.3 * sin(phase));
+}
+
+// Каждая ступенька сразу отыгрывается обратной: самолет возвращается примерно в горизонт
+static const StepEvent STEP_EVENTS[] = {
+    {AXIS_ROLL, 0.3f, 1000, 1000}, {AXIS_ROLL, -0.3f, 2000, 1000},
+    {AXIS_PITCH, 0.1f, 6000, 800}, {AXIS_PITCH, -0.1f, 6800, 800},
+    {AXIS_YAW, 0.3f, 11000, 1500}, {AXIS_YAW, -0.3f, 12500, 1500},
+};
+
+static const StepEvent DOUBLET_EVENTS[] = {
+    {AXIS_ROLL, 0.6f, 1000, 300}, {AXIS_ROLL, -0.6f, 1300, 300},
+    {AXIS_PITCH, 0.25f, 4000, 300}, {AXIS_PITCH, -0.25f, 4300, 300},
+    {AXIS_YAW, 0.6f, 7000, 500}, {AXIS_YAW, -0.6f, 7500, 500},
+};
+
+static const Scenario SCENARIOS[] = {
+    {"level", 20000, nullptr, 0, sticksFromSteps},      // Стики в нейтрали: балансировка, уход
+    {"steps", 17000, STEP_EVENTS, sizeof(STEP_EVENTS) / sizeof(STEP_EVENTS[0]), sticksFromSteps},
+    {"doublets", 10000, DOUBLET_EVENTS, sizeof(DOUBLET_EVENTS) / sizeof(DOUBLET_EVENTS[0]), sticksFromSteps},
+    {"sweep", 15000, nullptr, 0, sticksSweep},
+};
+
+#define SCENARIO_COUNT (int)(sizeof(SCENARIOS) / sizeof(SCENARIOS[0]))
+
+// ============================================================================
+// Выходы ServoManager -> модель
+// ============================================================================
+
+// Импульс -> ход в смысле выхода микшера (-1..+1), с учетом реверса монтажа
+static float surfaceFromPulse(uint8_t channel, const FlightConfig& config) {
+    const OutputConfig& output = config.outputs[channel];
+    const int pulse = HostPwm::getPulseUs(ServoManager::OUTPUTS[channel].pin);
+    float value = pulse >= output.neutralUs
+        ? (float)(pulse - output.neutralUs) / (output.maxUs - output.neutralUs)
+        : (float)(pulse - output.neutralUs) / (output.neutralUs - output.minUs);
+    return output.reversed ? -value : value;
+}
+
+// Общий ход пары - основная функция, разность - вторая (флапероны, V-хвост, элевоны)
+static void readControls(AirframeControls& controls) {
+    const FlightConfig& config = ConfigStore::getInstance().active();
+    const float lElevator = surfaceFromPulse(ServoManager::CH_L_ELEVATOR, config);
+    const float rElevator = surfaceFromPulse(ServoManager::CH_R_ELEVATOR, config);
+    const float lRudder = surfaceFromPulse(ServoManager::CH_L_RUDDER, config);
+    const float rRudder = surfaceFromPulse(ServoManager::CH_R_RUDDER, config);
+    const float lAileron = surfaceFromPulse(ServoManager::CH_L_AILERON, config);
+    const float rAileron = surfaceFromPulse(ServoManager::CH_R_AILERON, config);
+    const float lFlap = surfaceFromPulse(ServoManager::CH_L_FLAPS, config);
+    const float rFlap = surfaceFromPulse(ServoManager::CH_R_FLAPS, config);
+
+    controls.aileron = (lAileron + rAileron) / 2 + (rFlap - lFlap) / 2;
+    controls.elevator = (lElevator + rElevator) / 2 + (rAileron - lAileron) / 2;
+    controls.rudder = (lRudder + rRudder) / 2 + (lElevator - rElevator) / 2;
+    controls.flaps = (lFlap + rFlap) / 2;
+
+    // ESC по DShot: газ из принятого кадра (0 и команды - стоп)
+    const uint8_t motorPin = ServoManager::OUTPUTS[ServoManager::CH_MOTOR].pin;
+    if (HostDshot::isAttached(motorPin)) {
+        const int value = HostDshot::getValue(motorPin);
+        controls.throttle = value < DSHOT_THROTTLE_MIN ? 0.0f
+            : (float)(value - DSHOT_THROTTLE_MIN) / (DSHOT_THROTTLE_MAX - DSHOT_THROTTLE_MIN);
+        return;
+    }
+    const int motor = HostPwm::getPulseUs(motorPin);
+    controls.throttle = motor <= FLIGHTSIM_MOTOR_STOP_US ? 0.0f
+        : (float)(motor - FLIGHTSIM_MOTOR_STOP_US) / (FLIGHTSIM_MOTOR_FULL_US - FLIGHTSIM_MOTOR_STOP_US);
+}
+
+// Показания датчика: угловые скорости и удельная сила модели
+static void feedImu(const Airframe& airframe) {
+    const AirframeState& state = airframe.getState();
+    const double* force = airframe.getSpecificForce();
+    HostImu::setRates((float)(state.p * 180 / M_PI), (float)(state.q * 180 / M_PI), (float)(state.r * 180 / M_PI));
+    HostImu::setAccel((float)(force[0] / FLIGHTSIM_GRAVITY), (float)(force[1] / FLIGHTSIM_GRAVITY), (float)(force[2] / FLIGHTSIM_GRAVITY));
+}
+
+// Эталон оси: MANUAL - установившаяся реакция на линейный стик при текущей скорости,
+// RATE - заданная скорость, ANGLE - заданный угол крена и тангажа (курс - как RATE)
+static void referenceFor(const Airframe& airframe, const Sticks& sticks, double reference[AXIS_COUNT]) {
+    const FlightConfig& config = ConfigStore::getInstance().active();
+    const double speed = airframe.getAirspeed();
+    if (flightMode == FLIGHT_MODE_MANUAL) {
+        reference[AXIS_ROLL] = airframe.steadyRollRate(sticks.axis[AXIS_ROLL], speed) * 180 / M_PI;
+        reference[AXIS_PITCH] = airframe.steadyPitchRate(sticks.axis[AXIS_PITCH], speed) * 180 / M_PI;
+        reference[AXIS_YAW] = airframe.steadyYawRate(sticks.axis[AXIS_YAW], speed) * 180 / M_PI;
+        return;
+    }
+    for (uint8_t a = 0; a < AXIS_COUNT; a++) {
+        reference[a] = sticks.axis[a] * config.pid[a].maxRateDps;
+    }
+    if (flightMode == FLIGHT_MODE_ANGLE) {
+        reference[AXIS_ROLL] = sticks.axis[AXIS_ROLL] * config.level.maxAngleDeg;
+        reference[AXIS_PITCH] = sticks.axis[AXIS_PITCH] * config.level.maxAngleDeg;
+    }
+}
+
+// ============================================================================
+// Прогон
+// ============================================================================
+
+struct AxisResult {
+    double squaredError;
+    uint32_t samples;
+    double worstSettleMs;       // Худшая ступенька; < 0 - не установилась
+    double worstOvershoot;      // Доля от установившегося значения
+};
+
+struct RunResult {
+    const char* name;
+    double simSeconds;
+    double wallMs;
+    double minAltitude;
+    double minSpeed;
+    double maxSpeed;
+    bool crashed;
+    AxisResult axes[AXIS_COUNT];
+};
+
+struct Sample {
+    uint32_t ms;
+    float rate[AXIS_COUNT];     // °/с
+};
+
+static void sendSticks(const Sticks& sticks) {
+    static uint16_t sequence = 0;
+    ControlData data = {};
+    data.xAxis2 = (int16_t)lroundf(sticks.axis[AXIS_ROLL] * 512);
+    data.yAxis1 = (int16_t)lroundf(sticks.axis[AXIS_PITCH] * 512);
+    data.xAxis1 = (int16_t)lroundf(sticks.axis[AXIS_YAW] * 512);
+    data.yAxis2 = sticks.throttle;
+    data.buttons = (uint8_t)(flightMode << FLIGHT_MODE_BUTTON_SHIFT);
+    data.sequence = sequence++;
+    data.senderTimeMs = (uint16_t)Clock::millis();
+
+    uint8_t frame[CONTROL_FRAME_SIZE];
+    const size_t len = ControlFrame::encode(data, frame);
+    HostRadio::deliver(TRANSMITTER_MAC, frame, (int)len);
+}
+
+// Стики из записи: последний кадр к моменту ms (кадры записи уже отсортированы по времени)
+struct RecordingCursor {
+    const std::vector<RecordedFrame>* frames;
+    size_t next;
+    Sticks sticks;
+};
+
+static void advanceRecording(RecordingCursor& cursor, uint64_t offsetUs, uint64_t nowUs) {
+    const std::vector<RecordedFrame>& frames = *cursor.frames;
+    while (cursor.next < frames.size() && offsetUs + (frames[cursor.next].arrivalUs - frames.front().arrivalUs) <= nowUs) {
+        ControlData data;
+        const RecordedFrame& frame = frames[cursor.next++];
+        if (ControlFrame::decode(frame.data, frame.length, data) == FRAME_OK) {
+            cursor.sticks.axis[AXIS_ROLL] = data.xAxis2 / 512.0f;
+            cursor.sticks.axis[AXIS_PITCH] = data.yAxis1 / 512.0f;
+            cursor.sticks.axis[AXIS_YAW] = data.xAxis1 / 512.0f;
+            cursor.sticks.throttle = data.yAxis2;
+        }
+        // Битые кадры тоже уходят в приемник: их отбросит проверка CRC
+        HostRadio::setRssi(frame.rssi);
+        HostRadio::deliver(TRANSMITTER_MAC, frame.data, frame.length);
+    }
+}
+
+static void settleMetrics(const Scenario& scenario, const std::vector<Sample>& samples, RunResult& result) {
+    for (uint8_t a = 0; a < AXIS_COUNT; a++) {
+        result.axes[a].worstSettleMs = 0;
+        result.axes[a].worstOvershoot = 0;
+    }
+    for (uint8_t i = 0; i < scenario.stepCount; i++) {
+        const StepEvent& step = scenario.steps[i];
+        const uint32_t endMs = step.startMs + step.durationMs;
+        const uint32_t tailMs = endMs - step.durationMs / 5;
+
+        // Установившееся значение - среднее последней пятой части ступеньки
+        double finalRate = 0;
+        uint32_t count = 0;
+        for (const Sample& s : samples) {
+            if (s.ms >= tailMs && s.ms < endMs) {
+                finalRate += s.rate[step.axis];
+                count++;
+            }
+        }
+        if (count == 0) {
+            continue;
+        }
+        finalRate /= count;
+        const double band = fmax(fabs(finalRate) * FLIGHTSIM_SETTLE_BAND, FLIGHTSIM_SETTLE_FLOOR_DPS);
+
+        double lastOutsideMs = -1;
+        double peak = 0;
+        for (const Sample& s : samples) {
+            if (s.ms < step.startMs || s.ms >= endMs) {
+                continue;
+            }
+            const double rate = s.rate[step.axis];
+            if (fabs(rate - finalRate) > band) {
+                lastOutsideMs = s.ms - step.startMs;
+            }
+            if (rate * finalRate > 0 && fabs(rate) > fabs(peak)) {
+                peak = rate;
+            }
+        }
+        AxisResult& axis = result.axes[step.axis];
+        const double settleMs = lastOutsideMs < 0 ? 0 : lastOutsideMs + 1000.0 / CONTROL_TASK_RATE_HZ;
+        if (lastOutsideMs >= (double)(step.durationMs - step.durationMs / 5)) {
+            axis.worstSettleMs = -1;        // Не установилась за ступеньку
+        } else if (axis.worstSettleMs >= 0 && settleMs > axis.worstSettleMs) {
+            axis.worstSettleMs = settleMs;
+        }
+        if (fabs(finalRate) > FLIGHTSIM_SETTLE_FLOOR_DPS) {
+            const double overshoot = (fabs(peak) - fabs(finalRate)) / fabs(finalRate);
+            if (overshoot > axis.worstOvershoot) {
+                axis.worstOvershoot = overshoot;
+            }
+        }
+    }
+}
+
+// scenario == nullptr - запись полета
+static RunResult runFlight(const Scenario* scenario, const std::vector<RecordedFrame>* recording, FILE* csv) {
+    RunResult result = {};
+    result.name = scenario != nullptr ? scenario->name : "recording";
+
+    ControlTask task(servoManager);
+    controlTask = &task;
+    task.begin();
+
+    AirframeParams params;
+    Airframe::makeDefaultParams(params);
+    Airframe airframe(params);
+
+    const uint64_t tickUs = 1000000UL / task.getRateHz();
+    const uint64_t physicsUs = 1000000UL / FLIGHTSIM_PHYSICS_HZ;
+    const double dt = physicsUs / 1e6;
+
+    // Каждый полет - с теплого старта: датчик заново калибруется на земле,
+    // оценка углов не тянется из прошлого прогона
+    servoManager.beginImu();
+    HostImu::setRates(0, 0, 0);
+    HostImu::setAccel(0, 0, -1);
+
+    // Нейтраль до старта: первые пакеты вооружают ESC, фильтры приходят в покой,
+    // нуль гироскопа калибруется (самолет неподвижен)
+    Sticks sticks = {};
+    sticks.throttle = FLIGHTSIM_TRIM_THROTTLE;
+    uint64_t nowUs = HostClock::nowUs();
+    uint64_t nextPacketUs = nowUs;
+    const uint64_t leadInEndUs = nowUs + FLIGHTSIM_LEAD_IN_MS * 1000ULL;
+    while (nowUs < leadInEndUs) {
+        if (nowUs >= nextPacketUs) {
+            sendSticks(sticks);
+            nextPacketUs += FLIGHTSIM_PACKET_PERIOD_US;
+        }
+        nowUs += tickUs;
+        HostClock::setUs(nowUs);
+        task.tick();
+        EventLog::getInstance().drain();
+    }
+
+    airframe.reset(FLIGHTSIM_START_ALTITUDE, FLIGHTSIM_START_SPEED);
+    const uint64_t startUs = nowUs;
+    uint64_t durationUs = scenario != nullptr ? scenario->durationMs * 1000ULL : 0;
+    RecordingCursor cursor = {recording, 0, sticks};
+    if (recording != nullptr) {
+        durationUs = recording->back().arrivalUs - recording->front().arrivalUs + FLIGHTSIM_PACKET_PERIOD_US;
+    }
+
+    std::vector<Sample> samples;
+    samples.reserve(durationUs / tickUs + 1);
+    result.minAltitude = airframe.getAltitude();
+    result.minSpeed = result.maxSpeed = airframe.getAirspeed();
+    AirframeControls controls = {};
+    nextPacketUs = startUs;
+    uint64_t nextTickUs = startUs;
+
+    const auto wallStart = std::chrono::steady_clock::now();
+    for (uint64_t t = startUs; t < startUs + durationUs; t += physicsUs) {
+        const uint32_t ms = (uint32_t)((t - startUs) / 1000);
+        HostClock::setUs(t);
+
+        // Пакеты пульта: сценарий - каждые 20 мс, запись - в записанное время
+        if (recording != nullptr) {
+            advanceRecording(cursor, startUs, t);
+            sticks = cursor.sticks;
+        } else if (t >= nextPacketUs) {
+            sticks.axis[AXIS_ROLL] = sticks.axis[AXIS_PITCH] = sticks.axis[AXIS_YAW] = 0;
+            scenario->sticksAt(*scenario, ms, sticks);
+            sendSticks(sticks);
+            nextPacketUs += FLIGHTSIM_PACKET_PERIOD_US;
+        }
+
+        if (t >= nextTickUs) {
+            feedImu(airframe);
+            task.tick();
+            EventLog::getInstance().drain();
+            readControls(controls);
+            nextTickUs += tickUs;
+
+            const AirframeState& state = airframe.getState();
+            const double speed = airframe.getAirspeed();
+            double reference[AXIS_COUNT];
+            referenceFor(airframe, sticks, reference);
+            double roll, pitch, yaw;
+            airframe.getEulerRad(roll, pitch, yaw);
+            Sample sample = {ms, {(float)(state.p * 180 / M_PI), (float)(state.q * 180 / M_PI),
+                                  (float)(state.r * 180 / M_PI)}};
+            if (flightMode == FLIGHT_MODE_ANGLE) {
+                sample.rate[AXIS_ROLL] = (float)(roll * 180 / M_PI);
+                sample.rate[AXIS_PITCH] = (float)(pitch * 180 / M_PI);
+            }
+            for (uint8_t a = 0; a < AXIS_COUNT; a++) {
+                const double error = sample.rate[a] - reference[a];
+                result.axes[a].squaredError += error * error;
+                result.axes[a].samples++;
+            }
+            samples.push_back(sample);
+
+            if (csv != nullptr) {
+                fprintf(csv, "%s,%lu,%.3f,%.3f,%.3f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.3f,%.3f,%.3f,%.1f,%.1f,%.2f,%.2f,%.2f\n",
+                        result.name, (unsigned long)ms, sticks.axis[AXIS_ROLL], sticks.axis[AXIS_PITCH],
+                        sticks.axis[AXIS_YAW], reference[0], reference[1], reference[2],
+                        sample.rate[0], sample.rate[1], sample.rate[2],
+                        controls.aileron, controls.elevator, controls.rudder,
+                        roll * 180 / M_PI, pitch * 180 / M_PI, airframe.getAltitude(), speed, controls.throttle);
+            }
+        }
+
+        airframe.step(controls, dt);
+
+        const double altitude = airframe.getAltitude();
+        const double speed = airframe.getAirspeed();
+        result.minAltitude = fmin(result.minAltitude, altitude);
+        result.minSpeed = fmin(result.minSpeed, speed);
+        result.maxSpeed = fmax(result.maxSpeed, speed);
+        if (altitude <= 0) {
+            result.crashed = true;
+            break;
+        }
+    }
+    result.wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallStart).count();
+    result.simSeconds = (HostClock::nowUs() - startUs) / 1e6;
+
+    if (scenario != nullptr) {
+        settleMetrics(*scenario, samples, result);
+    }
+    controlTask = nullptr;
+    return result;
+}
+
+// ============================================================================
+// Отчет
+// ============================================================================
+
+static void printRun(const RunResult& result, const char* label) {
+    char settle[AXIS_COUNT][16];
+    for (uint8_t a = 0; a < AXIS_COUNT; a++) {
+        if (result.axes[a].worstSettleMs < 0) {
+            snprintf(settle[a], sizeof(settle[a]), "n/s");
+        } else {
+            snprintf(settle[a], sizeof(settle[a]), "%.0f", result.axes[a].worstSettleMs);
+        }
+    }
+    const double rms[AXIS_COUNT] = {
+        sqrt(result.axes[0].squaredError / fmax(1, result.axes[0].samples)),
+        sqrt(result.axes[1].squaredError / fmax(1, result.axes[1].samples)),
+        sqrt(result.axes[2].squaredError / fmax(1, result.axes[2].samples)),
+    };
+    printf("%-14s %-9s %6.1f/%6.1f/%6.1f  %5s/%5s/%5s  %4.0f/%4.0f/%4.0f  %5.0f %5.1f-%4.1f %5.0fx%s\n",
+           label, result.name, rms[0], rms[1], rms[2], settle[0], settle[1], settle[2],
+           result.axes[0].worstOvershoot * 100, result.axes[1].worstOvershoot * 100,
+           result.axes[2].worstOvershoot * 100, result.minAltitude, result.minSpeed, result.maxSpeed,
+           result.wallMs > 0 ? result.simSeconds * 1000 / result.wallMs : 0.0,
+           result.crashed ? "  CRASH" : "");
+}
+
+static void printHeader() {
+    printf("%-14s %-9s %-22s  %-17s  %-14s  %-16s %s\n", "config", "scenario",
+           flightMode == FLIGHT_MODE_ANGLE ? "rms err r/p deg, y deg/s" : "rms err r/p/y, deg/s", "settle r/p/y, ms", "overshoot, %", "min alt, speed", "speed");
+}
+
+// "expo:1=30" -> имя, индекс, значение
+static bool parseField(const char* text, char* name, size_t nameSize, int& index, const char*& value) {
+    const char* equals = strchr(text, '=');
+    if (equals == nullptr) {
+        return false;
+    }
+    const char* colon = (const char*)memchr(text, ':', equals - text);
+    const char* nameEnd = colon != nullptr ? colon : equals;
+    const size_t length = (size_t)(nameEnd - text);
+    if (length == 0 || length >= nameSize) {
+        return false;
+    }
+    memcpy(name, text, length);
+    name[length] = '\0';
+    index = colon != nullptr ? atoi(colon + 1) : 0;
+    value = equals + 1;
+    return true;
+}
+
+static bool applyField(const char* name, int index, int value) {
+    // Между прогонами задача управления не работает: поколение подтверждается здесь,
+    // новую конфигурацию применит ControlTask::begin() следующего прогона
+    ConfigStore& store = ConfigStore::getInstance();
+    store.acknowledge(store.getGeneration());
+    return store.setField(name, index, value);
+}
+
+static bool loadRecording(const char* path, std::vector<RecordedFrame>& frames) {
+    FILE* file = fopen(path, "r");
+    if (file == nullptr) {
+        return false;
+    }
+    char line[256];
+    RecordedFrame frame;
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        if (FlightRecorder::parseLine(line, frame)) {
+            frames.push_back(frame);
+        }
+    }
+    fclose(file);
+    return !frames.empty();
+}
+
+static void usage() {
+    printf("usage: program [--scenario level|steps|doublets|sweep|all] [--recording <file>]\n"
+           "               [--mode manual|rate|angle] [--gyro-noise <dps>[:<bias dps>]]\n"
+           "               [--set <field>[:index]=<value>]... [--sweep <field>[:index]=<from>:<to>:<step>]\n"
+           "               [--csv <file>]\n");
+}
+
+int main(int argc, char** argv) {
+    const char* scenarioName = "all";
+    const char* recordingPath = nullptr;
+    const char* csvPath = nullptr;
+    const char* sweepSpec = nullptr;
+    std::vector<const char*> sets;
+    float gyroNoise = 0.0f;
+    float gyroBias = 0.0f;
+
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--scenario") == 0 && hasValue) {
+            scenarioName = argv[++i];
+        } else if (strcmp(argv[i], "--recording") == 0 && hasValue) {
+            recordingPath = argv[++i];
+        } else if (strcmp(argv[i], "--set") == 0 && hasValue) {
+            sets.push_back(argv[++i]);
+        } else if (strcmp(argv[i], "--sweep") == 0 && hasValue) {
+            sweepSpec = argv[++i];
+        } else if (strcmp(argv[i], "--csv") == 0 && hasValue) {
+            csvPath = argv[++i];
+        } else if (strcmp(argv[i], "--mode") == 0 && hasValue) {
+            const char* mode = argv[++i];
+            flightMode = FLIGHT_MODE_COUNT;
+            for (uint8_t m = 0; m < FLIGHT_MODE_COUNT; m++) {
+                if (strcasecmp(mode, Stabilizer::getModeName(m)) == 0) {
+                    flightMode = m;
+                }
+            }
+            if (flightMode == FLIGHT_MODE_COUNT) {
+                usage();
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--gyro-noise") == 0 && hasValue) {
+            if (sscanf(argv[++i], "%f:%f", &gyroNoise, &gyroBias) < 1 || gyroNoise < 0) {
+                usage();
+                return 2;
+            }
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    std::vector<const Scenario*> scenarios;
+    for (int s = 0; s < SCENARIO_COUNT; s++) {
+        if (strcmp(scenarioName, "all") == 0 || strcmp(scenarioName, SCENARIOS[s].name) == 0) {
+            scenarios.push_back(&SCENARIOS[s]);
+        }
+    }
+    std::vector<RecordedFrame> recording;
+    if (recordingPath != nullptr) {
+        if (!loadRecording(recordingPath, recording)) {
+            printf("❌ %s: no frames\n", recordingPath);
+            return 2;
+        }
+        if (strcmp(scenarioName, "all") == 0) {
+            scenarios.clear();      // Только запись, если сценарий не задан явно
+        }
+    } else if (scenarios.empty()) {
+        usage();
+        return 2;
+    }
+
+    // Загрузка (церемония ESC) на виртуальном времени
+    HostConsole::setQuiet(true);
+    HostImu::setGyroNoise(gyroNoise, gyroBias, FLIGHTSIM_IMU_SEED);
+    FlightConfig defaults;
+    ServoManager::makeDefaultConfig(defaults);
+    ConfigStore::getInstance().begin(defaults);
+    servoManager.begin();
+    ESPNowManager& espNowManager = ESPNowManager::getInstance();
+    espNowManager.begin();
+    espNowManager.registerCallback(onDataReceived);
+    espNowManager.addPeer();
+
+    for (const char* set : sets) {
+        char name[24];
+        int index = 0;
+        const char* value = nullptr;
+        if (!parseField(set, name, sizeof(name), index, value) || !applyField(name, index, atoi(value))) {
+            HostConsole::setQuiet(false);
+            printf("❌ --set %s: unknown field or invalid value\n", set);
+            return 2;
+        }
+    }
+
+    // Перебор: одно поле от..до с шагом, без перебора - один прогон текущих настроек
+    char sweepName[24] = "";
+    int sweepIndex = 0;
+    int sweepFrom = 0, sweepTo = 0, sweepStep = 1;
+    if (sweepSpec != nullptr) {
+        const char* range = nullptr;
+        if (!parseField(sweepSpec, sweepName, sizeof(sweepName), sweepIndex, range) ||
+            sscanf(range, "%d:%d:%d", &sweepFrom, &sweepTo, &sweepStep) != 3 || sweepStep <= 0) {
+            HostConsole::setQuiet(false);
+            usage();
+            return 2;
+        }
+    }
+
+    FILE* csv = nullptr;
+    if (csvPath != nullptr) {
+        csv = fopen(csvPath, "w");
+        if (csv == nullptr) {
+            HostConsole::setQuiet(false);
+            printf("❌ %s: cannot write\n", csvPath);
+            return 2;
+        }
+        fprintf(csv, "run,ms,stick_roll,stick_pitch,stick_yaw,ref_p,ref_q,ref_r,p,q,r,"
+                     "aileron,elevator,rudder,roll_deg,pitch_deg,altitude,airspeed,throttle\n");
+    }
+
+    HostConsole::setQuiet(false);
+    printHeader();
+    HostConsole::setQuiet(true);
+
+    double totalSim = 0;
+    double totalWall = 0;
+    bool crashed = false;
+    for (int value = sweepFrom; value <= sweepTo; value += sweepStep) {
+        char label[40] = "defaults";
+        if (sweepSpec != nullptr) {
+            if (!applyField(sweepName, sweepIndex, value)) {
+                printf("❌ %s:%d=%d rejected\n", sweepName, sweepIndex, value);
+                return 2;
+            }
+            snprintf(label, sizeof(label), "%s:%d=%d", sweepName, sweepIndex, value);
+        } else if (!sets.empty()) {
+            snprintf(label, sizeof(label), "custom");
+        }
+
+        for (const Scenario* scenario : scenarios) {
+            const RunResult result = runFlight(scenario, nullptr, csv);
+            printRun(result, label);
+            totalSim += result.simSeconds;
+            totalWall += result.wallMs;
+            crashed |= result.crashed;
+        }
+        if (!recording.empty()) {
+            const RunResult result = runFlight(nullptr, &recording, csv);
+            printRun(result, label);
+            totalSim += result.simSeconds;
+            totalWall += result.wallMs;
+            crashed |= result.crashed;
+        }
+    }
+
+    if (csv != nullptr) {
+        fclose(csv);
+    }
+    printf("\n%.0f s of flight in %.0f ms (%.0fx real time)%s\n", totalSim, totalWall,
+           totalWall > 0 ? totalSim * 1000 / totalWall : 0.0, crashed ? ", ❌ crashed" : "");
+    return crashed ? 1 : 0;
+}
@@ -0,0 +1,697 @@
+// Симулятор канала ESP-NOW на хосте ([env:native_linksim]).
+//
+// Тысячи сценариев подряд: пульт шлет кадры 50 раз в секунду, модель эфира
+// (HAL/Host/LinkSimulator.h) теряет, задерживает, дублирует, переставляет и
+// портит их, настоящие ESPNowManager -> ControlTask -> ServoManager принимают их
+// на виртуальном времени. После каждого тика реакция прошивки сверяется с тем,
+// что на самом деле произошло в эфире:
+//   - failsafe срабатывает в первом же тике после таймаута тишины и не раньше;
+//   - возврат из failsafe - не раньше гистерезиса и не позже одного-двух тиков после;
+//   - индикатор связи гаснет ровно по CONNECTION_TIMEOUT_MS;
+//   - дубли и запоздавшие кадры не применяются и не продлевают связь для failsafe;
+//   - LinkStats считает принятые, битые и потерянные кадры и интервалы так же, как модель.
+// Затем направленные сценарии с заданными стиками проверяют, что получает мотор
+// после потери связи (без старой команды из фильтров и т.п.).
+// Любое расхождение - код возврата 1.
+//
+//   program [--scenarios N] [--seconds S] [--seed N] [--profile <имя>] [--verbose]
+
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "HAL/Hal.h"
+#include "HAL/Host/HostHal.h"
+#include "HAL/Host/LinkSimulator.h"
+#include "Core/Types.h"
+#include "Core/ConfigStore.h"
+#include "Actuators/ServoManager.h"
+#include "Communication/ESPNowManager.h"
+#include "Communication/ControlFrame.h"
+#include "Control/ControlTask.h"
+#include "HAL/Dshot.h"
+#include "Diagnostics/EventLog.h"
+
+#define LINKSIM_SCENARIOS           1000
+#define LINKSIM_SECONDS             20
+#define LINKSIM_PACKET_PERIOD_US    20000   // Пульт шлет 50 пакетов/с
+#define LINKSIM_SENDER_JITTER_US    400     // Разброс момента отправки на пульте
+#define LINKSIM_OUTAGE_MAX_MS       3000    // Самое длинное окно без связи
+#define LINKSIM_VIOLATIONS_SHOWN    10
+
+ServoManager servoManager;
+static ControlTask* controlTask = nullptr;
+
+// Адрес пульта для кадров направленных сценариев (модель эфира шлет со своего)
+static const uint8_t TRANSMITTER_MAC[6] = {0x14, 0x33, 0x5C, 0x37, 0x82, 0x58};
+
+static void onDataReceived(const ControlData& data) {
+    controlTask->submit(data);
+}
+
+// Генератор сценариев (параметры профилей, окна потерь), отдельный от модели эфира
+static double randomUnit(uint64_t& state) {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return (double)((state * 0x2545F4914F6CDD1DULL) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static float randomRange(uint64_t& state, float low, float high) {
+    return low + (float)randomUnit(state) * (high - low);
+}
+
+// ============================================================================
+// Профили канала
+// ============================================================================
+
+enum LinkProfile {
+    PROFILE_CLEAN = 0,
+    PROFILE_BERNOULLI,
+    PROFILE_BURST,
+    PROFILE_JITTER,
+    PROFILE_DUP_REORDER,
+    PROFILE_CORRUPT,
+    PROFILE_MIXED,
+    PROFILE_COUNT
+};
+
+static const char* const PROFILE_NAMES[PROFILE_COUNT] = {
+    "clean", "bernoulli", "burst", "jitter", "dup-reorder", "corrupt", "mixed"
+};
+
+// Параметры профиля выбираются случайно в пределах его диапазона
+static void makeProfileModel(int profile, uint64_t& rng, LinkModel& model) {
+    LinkSimulator::makeDefaultModel(model);
+    model.latencyModel = LINK_LATENCY_UNIFORM;
+    model.latencyUs = 800;
+    model.spreadUs = (uint32_t)randomRange(rng, 200, 1500);
+
+    switch (profile) {
+        case PROFILE_BERNOULLI:
+            model.lossModel = LINK_LOSS_BERNOULLI;
+            model.lossProbability = randomRange(rng, 0.01f, 0.25f);
+            break;
+        case PROFILE_BURST:
+            model.lossModel = LINK_LOSS_GILBERT_ELLIOTT;
+            model.goodToBad = randomRange(rng, 0.005f, 0.05f);
+            model.badToGood = randomRange(rng, 0.05f, 0.4f);
+            model.lossInGood = randomRange(rng, 0.0f, 0.02f);
+            model.lossInBad = randomRange(rng, 0.5f, 1.0f);
+            break;
+        case PROFILE_JITTER:
+            // Разброс больше периода пакетов: перестановки возникают сами
+            model.latencyModel = randomUnit(rng) < 0.5 ? LINK_LATENCY_NORMAL : LINK_LATENCY_EXPONENTIAL;
+            model.latencyUs = (uint32_t)randomRange(rng, 1000, 5000);
+            model.spreadUs = (uint32_t)randomRange(rng, 500, 25000);
+            break;
+        case PROFILE_DUP_REORDER:
+            model.duplicateProbability = randomRange(rng, 0.01f, 0.1f);
+            model.reorderProbability = randomRange(rng, 0.01f, 0.1f);
+            model.reorderDelayUs = (uint32_t)randomRange(rng, 5000, 60000);
+            break;
+        case PROFILE_CORRUPT:
+            model.corruptProbability = randomRange(rng, 0.01f, 0.15f);
+            break;
+        case PROFILE_MIXED:
+            model.lossModel = LINK_LOSS_GILBERT_ELLIOTT;
+            model.goodToBad = randomRange(rng, 0.005f, 0.03f);
+            model.badToGood = randomRange(rng, 0.1f, 0.5f);
+            model.lossInGood = 0.01f;
+            model.lossInBad = 0.7f;
+            model.latencyModel = LINK_LATENCY_EXPONENTIAL;
+            model.spreadUs = (uint32_t)randomRange(rng, 500, 8000);
+            model.duplicateProbability = 0.02f;
+            model.reorderProbability = 0.02f;
+            model.corruptProbability = 0.02f;
+            break;
+        default:
+            break;
+    }
+}
+
+// ============================================================================
+// Итоги и нарушения
+// ============================================================================
+
+enum ViolationKind {
+    VIOLATION_EARLY_FAILSAFE = 0,
+    VIOLATION_LATE_FAILSAFE,
+    VIOLATION_MISSED_FAILSAFE,
+    VIOLATION_EARLY_RECOVERY,
+    VIOLATION_STUCK_FAILSAFE,
+    VIOLATION_CONNECTION,
+    VIOLATION_TICK_LATENCY,
+    VIOLATION_RECEIVED,
+    VIOLATION_CORRUPT,
+    VIOLATION_LOST,
+    VIOLATION_INTERVAL,
+    VIOLATION_STALE,
+    VIOLATION_KIND_COUNT
+};
+
+static const char* const VIOLATION_NAMES[VIOLATION_KIND_COUNT] = {
+    "failsafe before timeout", "failsafe later than one tick", "no failsafe after timeout",
+    "recovery before hysteresis", "failsafe held after recovery", "link indicator",
+    "packet waited longer than a tick", "received count", "CRC/bad frame count",
+    "lost count", "interval mean/jitter", "stale frames applied/dropped"
+};
+
+struct ProfileSummary {
+    uint32_t scenarios;
+    double simSeconds;
+    uint32_t sent;
+    uint32_t delivered;
+    uint32_t valid;             // Доставлены без искажений
+    uint32_t lostTruth;         // Номера, не принятые ни разу (между первым и последним принятым)
+    uint32_t lostReported;      // LinkStats
+    uint32_t corrupted;
+    uint32_t duplicated;
+    uint32_t reordered;
+    uint32_t failsafes;
+    uint32_t linkDowns;
+    uint32_t violations;
+    double airLatencySumUs;
+    uint32_t airLatencyMaxUs;
+    uint32_t detectionMinUs;    // Тишина на момент срабатывания failsafe
+    uint32_t detectionMaxUs;
+};
+
+static ProfileSummary summaries[PROFILE_COUNT];
+static uint32_t violationsShown = 0;
+
+struct ScenarioState {
+    uint32_t index;
+    int profile;
+    uint32_t reportedMask;      // Каждый вид нарушения - один раз на сценарий
+};
+
+static void violation(ScenarioState& scenario, ViolationKind kind, const char* format, ...)
+    __attribute__((format(printf, 3, 4)));
+
+static void violation(ScenarioState& scenario, ViolationKind kind, const char* format, ...) {
+    if (scenario.reportedMask & (1UL << kind)) {
+        return;
+    }
+    scenario.reportedMask |= 1UL << kind;
+    summaries[scenario.profile].violations++;
+    if (violationsShown++ >= LINKSIM_VIOLATIONS_SHOWN) {
+        return;
+    }
+    printf("❌ scenario %lu (%s): %s: ", (unsigned long)scenario.index, PROFILE_NAMES[scenario.profile],
+           VIOLATION_NAMES[kind]);
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+    printf("\n");
+}
+
+// ============================================================================
+// Сценарий
+// ============================================================================
+
+static void runScenario(uint32_t index, int profile, uint64_t seed, uint32_t seconds, bool verbose) {
+    ProfileSummary& summary = summaries[profile];
+    ScenarioState scenario = {index, profile, 0};
+    uint64_t rng = seed * 0x9E3779B97F4A7C15ULL + 7;
+
+    LinkModel model;
+    makeProfileModel(profile, rng, model);
+    LinkSimulator link(model, seed);
+
+    const uint64_t startUs = HostClock::nowUs();
+    const uint64_t durationUs = (uint64_t)seconds * 1000000ULL;
+    const uint64_t endUs = startUs + durationUs;
+
+    // Половина сценариев - пилот улетает за пределы дальности и возвращается
+    if (randomUnit(rng) < 0.5 && seconds > 4) {
+        const uint64_t outageUs = (uint64_t)(randomUnit(rng) * LINKSIM_OUTAGE_MAX_MS * 1000);
+        const uint64_t outageStartUs = startUs + 1000000 + (uint64_t)(randomUnit(rng) * (durationUs - 2000000 - outageUs));
+        link.addOutage(outageStartUs, outageUs);
+    }
+
+    // Свежая задача управления (и failsafe) на каждый сценарий
+    ControlTask task(servoManager);
+    controlTask = &task;
+    task.begin();
+    ESPNowManager& espNowManager = ESPNowManager::getInstance();
+    espNowManager.requestLinkStatsReset();
+    espNowManager.setConnectionStatus(false);
+
+    const FailsafeConfig& failsafeConfig = ConfigStore::getInstance().active().failsafe;
+    const uint64_t timeoutUs = (uint64_t)failsafeConfig.timeoutMs * 1000;
+    const uint64_t recoveryUs = (uint64_t)failsafeConfig.recoveryMs * 1000;
+    const uint64_t periodUs = 1000000UL / task.getRateHz();
+    const Failsafe& failsafe = task.getFailsafe();
+
+    // Что на самом деле произошло в эфире
+    const uint32_t packetCount = (uint32_t)(durationUs / LINKSIM_PACKET_PERIOD_US) + 1;
+    std::vector<bool> receivedIndex(packetCount, false);
+    uint32_t validDeliveries = 0;
+    uint32_t corruptDeliveries = 0;
+    bool haveValid = false;
+    uint64_t lastValidUs = 0;
+    uint32_t firstValidIndex = 0;
+    uint32_t highestValidIndex = 0;
+    bool stragglers = false;        // Кадр старше самого первого принятого
+    // Failsafe и update() видят только кадры новее последнего принятого (ControlTask::submit)
+    bool haveFresh = false;
+    uint64_t lastFreshUs = 0;
+    uint32_t freshIndex = 0;
+    uint32_t staleDeliveries = 0;
+    const uint64_t resyncUs = (uint64_t)CONTROL_SEQUENCE_RESYNC_MS * 1000;
+    uint32_t intervalCount = 0;
+    double intervalMean = 0;
+    double intervalM2 = 0;
+
+    bool wasActive = false;
+    bool cleanSinceSet = false;     // Первый верный кадр после последнего тика с тишиной
+    uint64_t cleanSinceUs = 0;
+    uint32_t activations = 0;
+    bool wasConnected = false;
+
+    const uint16_t firstSequence = (uint16_t)(randomUnit(rng) * 65536);   // Проверяет и переход через 0
+    uint32_t sendIndex = 0;
+    uint64_t nextSendUs = startUs + (uint64_t)(randomUnit(rng) * LINKSIM_PACKET_PERIOD_US);
+    uint64_t nextTickUs = startUs + periodUs;
+
+    while (nextTickUs <= endUs) {
+        // Пульт: все кадры, отправленные до этого тика
+        while (nextSendUs <= nextTickUs && sendIndex < packetCount) {
+            const int16_t sweep = (int16_t)((int)(sendIndex % 100) * 10 - 500);
+            ControlData data = {};
+            data.xAxis1 = sweep;
+            data.yAxis1 = (int16_t)(-sweep / 2);
+            data.xAxis2 = (int16_t)(sweep / 3);
+            data.yAxis2 = (int16_t)(sendIndex % 512);
+            data.sequence = (uint16_t)(firstSequence + sendIndex);
+            data.senderTimeMs = (uint16_t)(nextSendUs / 1000);
+
+            uint8_t frame[CONTROL_FRAME_SIZE];
+            const size_t len = ControlFrame::encode(data, frame);
+            link.send(frame, (int)len, nextSendUs);
+            sendIndex++;
+            nextSendUs += LINKSIM_PACKET_PERIOD_US - LINKSIM_SENDER_JITTER_US / 2 +
+                          (uint64_t)(randomUnit(rng) * LINKSIM_SENDER_JITTER_US);
+        }
+
+        // Эфир: кадры приходят в свое время, между тиками
+        LinkDelivery delivery;
+        while (link.nextArrivalUs() <= nextTickUs && link.deliverNext(&delivery)) {
+            if (delivery.corrupted) {
+                corruptDeliveries++;
+                continue;
+            }
+            validDeliveries++;
+            receivedIndex[delivery.sendIndex] = true;
+            const uint32_t airLatencyUs = (uint32_t)(delivery.arrivalUs - delivery.sentUs);
+            summary.airLatencySumUs += airLatencyUs;
+            if (airLatencyUs > summary.airLatencyMaxUs) {
+                summary.airLatencyMaxUs = airLatencyUs;
+            }
+            if (!haveValid) {
+                firstValidIndex = delivery.sendIndex;
+                highestValidIndex = delivery.sendIndex;
+            } else {
+                const double interval = (double)(delivery.arrivalUs - lastValidUs);
+                intervalCount++;
+                const double delta = interval - intervalMean;
+                intervalMean += delta / intervalCount;
+                intervalM2 += delta * (interval - intervalMean);
+                stragglers |= delivery.sendIndex < firstValidIndex;
+                if (delivery.sendIndex > highestValidIndex) {
+                    highestValidIndex = delivery.sendIndex;
+                }
+            }
+            haveValid = true;
+            lastValidUs = delivery.arrivalUs;
+
+            if (haveFresh && delivery.sendIndex <= freshIndex && delivery.arrivalUs - lastFreshUs <= resyncUs) {
+                staleDeliveries++;
+                continue;
+            }
+            haveFresh = true;
+            freshIndex = delivery.sendIndex;
+            lastFreshUs = delivery.arrivalUs;
+            if (!cleanSinceSet) {
+                cleanSinceSet = true;
+                cleanSinceUs = delivery.arrivalUs;
+            }
+        }
+
+        HostClock::setUs(nextTickUs);
+        task.tick();
+        espNowManager.updateConnection();
+        EventLog::getInstance().drain();
+
+        // Проверки после тика
+        const uint64_t nowUs = nextTickUs;
+        const uint64_t silenceUs = haveFresh ? nowUs - lastFreshUs : 0;
+
+        if (failsafe.getActivationCount() != activations) {
+            activations = failsafe.getActivationCount();
+            if (summary.failsafes++ == 0 || silenceUs < summary.detectionMinUs) {
+                summary.detectionMinUs = (uint32_t)silenceUs;
+            }
+            if (silenceUs > summary.detectionMaxUs) {
+                summary.detectionMaxUs = (uint32_t)silenceUs;
+            }
+            if (silenceUs <= timeoutUs) {
+                violation(scenario, VIOLATION_EARLY_FAILSAFE, "silence %lu us, timeout %lu us",
+                          (unsigned long)silenceUs, (unsigned long)timeoutUs);
+            } else if (silenceUs > timeoutUs + periodUs) {
+                violation(scenario, VIOLATION_LATE_FAILSAFE, "silence %lu us, timeout %lu us + tick %lu us",
+                          (unsigned long)silenceUs, (unsigned long)timeoutUs, (unsigned long)periodUs);
+            }
+        }
+        if (haveFresh && silenceUs > timeoutUs) {
+            if (!failsafe.isActive()) {
+                violation(scenario, VIOLATION_MISSED_FAILSAFE, "silence %lu us at t=%.3f s",
+                          (unsigned long)silenceUs, (nowUs - startUs) / 1e6);
+            }
+            cleanSinceSet = false;
+        }
+        if (wasActive && !failsafe.isActive() && (!cleanSinceSet || nowUs - cleanSinceUs < recoveryUs)) {
+            violation(scenario, VIOLATION_EARLY_RECOVERY, "clean for %lu us, hysteresis %lu us",
+                      cleanSinceSet ? (unsigned long)(nowUs - cleanSinceUs) : 0UL, (unsigned long)recoveryUs);
+        }
+        if (failsafe.isActive() && cleanSinceSet && nowUs - cleanSinceUs > recoveryUs + 2 * periodUs) {
+            violation(scenario, VIOLATION_STUCK_FAILSAFE, "clean for %lu us, hysteresis %lu us",
+                      (unsigned long)(nowUs - cleanSinceUs), (unsigned long)recoveryUs);
+        }
+        wasActive = failsafe.isActive();
+
+        // Связь: то же сравнение в миллисекундах, что и в ESPNowManager
+        if (haveValid) {
+            const uint32_t silenceMs = (uint32_t)(nowUs / 1000) - (uint32_t)(lastValidUs / 1000);
+            const bool expectedUp = silenceMs <= CONNECTION_TIMEOUT_MS;
+            if (espNowManager.isConnected() != expectedUp) {
+                violation(scenario, VIOLATION_CONNECTION, "link %s after %lu ms of silence",
+                          espNowManager.isConnected() ? "UP" : "DOWN", (unsigned long)silenceMs);
+            }
+            if (wasConnected && !espNowManager.isConnected()) {
+                summary.linkDowns++;
+            }
+            wasConnected = espNowManager.isConnected();
+        }
+
+        nextTickUs += periodUs;
+    }
+
+    // Кадры, оставшиеся в эфире к концу сценария, не доставляются
+    if (task.getMaxLatencyUs() > periodUs) {
+        violation(scenario, VIOLATION_TICK_LATENCY, "max %lu us, tick %lu us",
+                  (unsigned long)task.getMaxLatencyUs(), (unsigned long)periodUs);
+    }
+
+    const LinkStatsSnapshot stats = espNowManager.getLinkStats().getSnapshot();
+    if (stats.received != validDeliveries) {
+        violation(scenario, VIOLATION_RECEIVED, "LinkStats %lu, delivered %lu",
+                  (unsigned long)stats.received, (unsigned long)validDeliveries);
+    }
+    if (stats.crcErrors + stats.badFrames != corruptDeliveries) {
+        violation(scenario, VIOLATION_CORRUPT, "LinkStats CRC %lu + bad %lu, corrupted %lu",
+                  (unsigned long)stats.crcErrors, (unsigned long)stats.badFrames, (unsigned long)corruptDeliveries);
+    }
+
+    if (task.getStalePackets() != staleDeliveries) {
+        violation(scenario, VIOLATION_STALE, "ControlTask %lu, actually %lu",
+                  (unsigned long)task.getStalePackets(), (unsigned long)staleDeliveries);
+    }
+
+    uint32_t lostTruth = 0;
+    for (uint32_t i = firstValidIndex; haveValid && i <= highestValidIndex; i++) {
+        lostTruth += receivedIndex[i] ? 0 : 1;
+    }
+    // Дубль старого кадра LinkStats принимает за опоздавший потерянный:
+    // точное совпадение ожидается только без дублей и без кадров старше первого
+    if (model.duplicateProbability == 0 && !stragglers && stats.lost != lostTruth) {
+        violation(scenario, VIOLATION_LOST, "LinkStats %lu, actually %lu",
+                  (unsigned long)stats.lost, (unsigned long)lostTruth);
+    }
+
+    const double jitterTruth = intervalCount > 1 ? sqrt(intervalM2 / (intervalCount - 1)) : 0;
+    if (fabs(stats.meanIntervalUs - intervalMean) > 1.0 + intervalMean * 0.005 ||
+        fabs(stats.jitterUs - jitterTruth) > 1.0 + jitterTruth * 0.005) {
+        violation(scenario, VIOLATION_INTERVAL, "LinkStats %.1f/%.1f us, actually %.1f/%.1f us",
+                  stats.meanIntervalUs, stats.jitterUs, intervalMean, jitterTruth);
+    }
+
+    const LinkSimStats& sim = link.getStats();
+    summary.scenarios++;
+    summary.simSeconds += seconds;
+    summary.sent += sim.sent;
+    summary.delivered += sim.delivered;
+    summary.valid += validDeliveries;
+    summary.lostTruth += lostTruth;
+    summary.lostReported += stats.lost;
+    summary.corrupted += sim.corrupted;
+    summary.duplicated += sim.duplicated;
+    summary.reordered += sim.reordered;
+
+    if (verbose) {
+        printf("  #%-5lu %-11s sent %5lu, lost %4lu+%4lu, dup %3lu, reord %3lu, corrupt %3lu, "
+               "failsafe %lu, LinkStats lost %lu (truth %lu), jitter %.0f us\n",
+               (unsigned long)index, PROFILE_NAMES[profile], (unsigned long)sim.sent,
+               (unsigned long)sim.lost, (unsigned long)sim.blackedOut, (unsigned long)sim.duplicated,
+               (unsigned long)sim.reordered, (unsigned long)sim.corrupted, (unsigned long)activations,
+               (unsigned long)stats.lost, (unsigned long)lostTruth, stats.jitterUs);
+    }
+
+    // Пауза между сценариями: сброс всех таймаутов
+    HostClock::advanceUs((uint64_t)CONNECTION_TIMEOUT_MS * 1000 + 1000000);
+    controlTask = nullptr;
+}
+
+// ============================================================================
+// Направленные сценарии
+// ============================================================================
+//
+// Случайные сценарии сверяют моменты срабатывания и возврата failsafe, но не
+// команды на выходах. Здесь стики заданы по фазам, эфир чистый, кроме фаз без
+// связи, и после каждого тика проверяется, дает ли мотор тягу там, где не должен.
+
+struct DirectedPhase {
+    uint32_t durationMs;
+    int16_t throttle;           // yAxis2 пульта
+    bool linkUp;
+    bool motorForwardAllowed;   // false - тяга вперед в этой фазе - нарушение
+    void (ServoManager::*start)();  // Команда консоли в начале фазы, nullptr - нет
+};
+
+static uint32_t directedViolations = 0;
+
+static void directedViolation(const char* name, const char* format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+static void directedViolation(const char* name, const char* format, ...) {
+    directedViolations++;
+    printf("❌ directed '%s': ", name);
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+    printf("\n");
+}
+
+// Мотор дает тягу вперед: выше стопа (нейтрали реверсивного ESC)
+static bool motorForward(int* command) {
+    const OutputSpec& spec = ServoManager::OUTPUTS[ServoManager::CH_MOTOR];
+    if (HostDshot::isAttached(spec.pin)) {
+        *command = HostDshot::getValue(spec.pin);
+        return *command >= (AIRFRAME_ESC_REVERSIBLE ? DSHOT_3D_FORWARD_MIN : DSHOT_THROTTLE_MIN);
+    }
+    *command = HostPwm::getPulseUs(spec.pin);
+    return *command > outputRestPulse(spec);
+}
+
+static void runDirected(const char* name, const DirectedPhase* phases, uint8_t phaseCount) {
+    ControlTask task(servoManager);
+    controlTask = &task;
+    task.begin();
+    ESPNowManager& espNowManager = ESPNowManager::getInstance();
+    espNowManager.requestLinkStatsReset();
+    espNowManager.setConnectionStatus(false);
+
+    const uint64_t periodUs = 1000000UL / task.getRateHz();
+    uint64_t nowUs = HostClock::nowUs();
+    uint64_t nextSendUs = nowUs;
+    uint16_t sequence = 0;
+
+    for (uint8_t p = 0; p < phaseCount; p++) {
+        const DirectedPhase& phase = phases[p];
+        const uint64_t phaseEndUs = nowUs + (uint64_t)phase.durationMs * 1000;
+        bool reported = false;
+        if (phase.start != nullptr) {
+            (servoManager.*phase.start)();
+        }
+        while (nowUs < phaseEndUs) {
+            nowUs += periodUs;
+            while (nextSendUs <= nowUs) {
+                if (phase.linkUp) {
+                    ControlData data = {};
+                    data.yAxis2 = phase.throttle;
+                    data.sequence = sequence;
+                    data.senderTimeMs = (uint16_t)(nextSendUs / 1000);
+                    uint8_t frame[CONTROL_FRAME_SIZE];
+                    const size_t len = ControlFrame::encode(data, frame);
+                    HostClock::setUs(nextSendUs);
+                    HostRadio::deliver(TRANSMITTER_MAC, frame, (int)len);
+                }
+                sequence++;     // Пропавшие кадры тоже расходуют номер
+                nextSendUs += LINKSIM_PACKET_PERIOD_US;
+            }
+            HostClock::setUs(nowUs);
+            task.tick();
+            EventLog::getInstance().drain();
+
+            int command = 0;
+            if (!phase.motorForwardAllowed && !reported && motorForward(&command)) {
+                directedViolation(name, "phase %u: motor %d with throttle stick %d, failsafe %s",
+                                  (unsigned)p, command, phase.throttle, task.getFailsafe().isActive() ? "on" : "off");
+                reported = true;
+            }
+        }
+    }
+
+    HostClock::advanceUs((uint64_t)CONNECTION_TIMEOUT_MS * 1000 + 1000000);
+    controlTask = nullptr;
+}
+
+static void runDirectedScenarios() {
+    // Газ, потеря связи дольше удержания, возврат со стиком газа внизу:
+    // после возврата мотор не должен получить газ из истории фильтров
+    static const DirectedPhase RECOVERY_AT_IDLE[] = {
+        {1000, 400, true, true, nullptr},
+        {2000, 400, false, true, nullptr},
+        {1500, -512, true, false, nullptr},
+    };
+    runDirected("recovery at idle", RECOVERY_AT_IDLE, sizeof(RECOVERY_AT_IDLE) / sizeof(RECOVERY_AT_IDLE[0]));
+
+    // Тест мотора с консоли, стик газа внизу, связь пропала на разгоне:
+    // после таймаута failsafe тест отменен и мотор стоит
+    static const DirectedPhase TEST_AT_LINK_LOSS[] = {
+        {1000, -512, true, true, nullptr},
+        {2000, -512, true, true, &ServoManager::testMotorDirect},
+        {FAILSAFE_TIMEOUT_MS + 20, -512, false, true, nullptr},
+        {3000, -512, false, false, nullptr},
+    };
+    runDirected("test at link loss", TEST_AT_LINK_LOSS, sizeof(TEST_AT_LINK_LOSS) / sizeof(TEST_AT_LINK_LOSS[0]));
+
+    if (directedViolations == 0) {
+        printf("✅ directed scenarios: motor output after link loss as commanded\n");
+    }
+}
+
+// ============================================================================
+
+static void printSummary(double wallMs) {
+    printf("\nprofile      scen  sim s    sent    lost(true/LinkStats)  dup  reord  corrupt  failsafe  "
+           "detect min/max ms  air mean/max ms  viol\n");
+    ProfileSummary total = {};
+    for (int p = 0; p < PROFILE_COUNT; p++) {
+        const ProfileSummary& s = summaries[p];
+        if (s.scenarios == 0) {
+            continue;
+        }
+        printf("%-11s %5lu %6.0f %7lu %8lu / %-8lu %7lu %6lu %8lu %9lu     %6.1f/%5.1f     %6.1f/%6.1f  %5lu\n",
+               PROFILE_NAMES[p], (unsigned long)s.scenarios, s.simSeconds, (unsigned long)s.sent,
+               (unsigned long)s.lostTruth, (unsigned long)s.lostReported, (unsigned long)s.duplicated,
+               (unsigned long)s.reordered, (unsigned long)s.corrupted, (unsigned long)s.failsafes,
+               s.detectionMinUs / 1000.0, s.detectionMaxUs / 1000.0,
+               s.valid > 0 ? s.airLatencySumUs / s.valid / 1000.0 : 0.0, s.airLatencyMaxUs / 1000.0,
+               (unsigned long)s.violations);
+        total.scenarios += s.scenarios;
+        total.simSeconds += s.simSeconds;
+        total.failsafes += s.failsafes;
+        total.violations += s.violations;
+    }
+
+    printf("\n%lu scenarios, %.0f s simulated in %.0f ms (%.0fx real time), %lu failsafe activations\n",
+           (unsigned long)total.scenarios, total.simSeconds, wallMs,
+           wallMs > 0 ? total.simSeconds * 1000.0 / wallMs : 0.0, (unsigned long)total.failsafes);
+    if (total.violations > 0) {
+        printf("❌ %lu violation(s)\n", (unsigned long)total.violations);
+    } else {
+        printf("✅ failsafe, link indicator and LinkStats match the simulated link\n");
+    }
+}
+
+static void usage() {
+    printf("usage: program [--scenarios N] [--seconds S] [--seed N] [--profile <name>] [--verbose]\n"
+           "profiles:");
+    for (int p = 0; p < PROFILE_COUNT; p++) {
+        printf(" %s", PROFILE_NAMES[p]);
+    }
+    printf("\n");
+}
+
+int main(int argc, char** argv) {
+    uint32_t scenarios = LINKSIM_SCENARIOS;
+    uint32_t seconds = LINKSIM_SECONDS;
+    uint64_t seed = 1;
+    int onlyProfile = -1;
+    bool verbose = false;
+
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--scenarios") == 0 && hasValue) {
+            scenarios = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seconds") == 0 && hasValue) {
+            seconds = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--profile") == 0 && hasValue) {
+            const char* name = argv[++i];
+            for (int p = 0; p < PROFILE_COUNT; p++) {
+                if (strcmp(name, PROFILE_NAMES[p]) == 0) {
+                    onlyProfile = p;
+                }
+            }
+            if (onlyProfile < 0) {
+                usage();
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (seconds < 1) {
+        usage();
+        return 2;
+    }
+
+    // Загрузка (с церемонией ESC) - один раз, на виртуальном времени
+    HostConsole::setQuiet(true);
+    FlightConfig defaults;
+    ServoManager::makeDefaultConfig(defaults);
+    ConfigStore::getInstance().begin(defaults);
+    servoManager.begin();
+    ESPNowManager& espNowManager = ESPNowManager::getInstance();
+    espNowManager.begin();
+    espNowManager.registerCallback(onDataReceived);
+    espNowManager.addPeer();
+
+    const auto wallStart = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < scenarios; i++) {
+        const int profile = onlyProfile >= 0 ? onlyProfile : (int)(i % PROFILE_COUNT);
+        runScenario(i, profile, seed + i, seconds, verbose);
+    }
+    const double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallStart).count();
+
+    printSummary(wallMs);
+    runDirectedScenarios();
+    HostConsole::setQuiet(false);
+    uint32_t violations = directedViolations;
+    for (int p = 0; p < PROFILE_COUNT; p++) {
+        violations += summaries[p].violations;
+    }
+    return violations > 0 ? 1 : 0;
+}
@@ -0,0 +1,138 @@
+// Хост-сборка ([env:native]): реальные ServoManager/ESPNowManager/ControlTask
+// поверх фейкового HAL. Прогоняет сценарий "пульт двигает стики, затем связь
+// пропадает" на виртуальном времени и печатает импульсы на выходах.
+
+#include <cstdio>
+#include <cstring>
+#include "HAL/Hal.h"
+#include "HAL/Host/HostHal.h"
+#include "Core/Types.h"
+#include "Actuators/ServoManager.h"
+#include "Communication/ESPNowManager.h"
+#include "Communication/ControlFrame.h"
+#include "Control/ControlTask.h"
+#include "Diagnostics/LatencyMonitor.h"
+#include "Diagnostics/EventLog.h"
+
+ServoManager servoManager;
+ControlTask controlTask(servoManager);
+
+static const uint8_t TRANSMITTER_MAC[6] = {0x14, 0x33, 0x5C, 0x37, 0x82, 0x58};
+static const uint32_t PACKET_PERIOD_US = 20000;   // Пульт шлет 50 пакетов/с
+
+void onDataReceived(const ControlData& data) {
+    controlTask.submit(data);
+}
+
+static void sendPacket(int16_t x1, int16_t y1, int16_t x2, int16_t y2) {
+    static uint16_t sequence = 0;
+
+    ControlData data = {};
+    data.xAxis1 = x1;
+    data.yAxis1 = y1;
+    data.xAxis2 = x2;
+    data.yAxis2 = y2;
+    data.sequence = sequence++;
+    data.senderTimeMs = (uint16_t)Clock::millis();
+
+    uint8_t frame[CONTROL_FRAME_SIZE];
+    size_t len = ControlFrame::encode(data, frame);
+    HostRadio::deliver(TRANSMITTER_MAC, frame, (int)len);
+}
+
+// Все выходы профиля аппарата по порядку каналов (ServoManager::OUTPUTS).
+// ESC по DShot - значение кадра, декодированное из символов RMT ("d")
+static void printOutputs(const char* label) {
+    printf("%-10s t=%6lums ", label, (unsigned long)Clock::millis());
+    for (uint8_t i = 0; i < ServoManager::OUTPUT_COUNT; i++) {
+        const uint8_t pin = ServoManager::OUTPUTS[i].pin;
+        if (HostDshot::isAttached(pin)) {
+            printf(" %s d%4d", ServoManager::OUTPUTS[i].name, HostDshot::getValue(pin));
+        } else {
+            printf(" %s %4d", ServoManager::OUTPUTS[i].name, HostPwm::getPulseUs(pin));
+        }
+    }
+    printf("  link=%s\n", ESPNowManager::getInstance().isConnected() ? "UP" : "DOWN");
+}
+
+int main(int argc, char** argv) {
+    ESPNowManager& espNowManager = ESPNowManager::getInstance();
+
+    // --warm: сброс по просадке питания в полете. Предыдущий запуск успел
+    // вооружить ESC и записать это в "NVS" - загрузка идет быстрым путем
+    const bool warm = argc > 1 && strcmp(argv[1], "--warm") == 0;
+
+    // Инициализация с длинными delay() проходит мгновенно на виртуальном времени
+    HostConsole::setQuiet(true);
+    FlightConfig defaults;
+    ServoManager::makeDefaultConfig(defaults);
+    ConfigStore& configStore = ConfigStore::getInstance();
+    if (warm) {
+        configStore.begin(defaults);
+        configStore.acknowledge(configStore.getGeneration());
+        configStore.noteEscState(true, true);
+        configStore.service();
+        HostSystem::setResetReason(RESET_BROWNOUT);
+    }
+    configStore.begin(defaults);
+    
+    if (warm) {
+        servoManager.beginFast();
+    } else {
+        servoManager.begin();
+    }
+    controlTask.begin();
+    espNowManager.begin();
+    espNowManager.registerCallback(onDataReceived);
+    espNowManager.addPeer();
+    const uint32_t readyUs = Clock::micros();
+    HostConsole::setQuiet(false);
+
+    printOutputs("READY");
+
+    const uint32_t tickUs = 1000000UL / controlTask.getRateHz();
+    uint64_t nextPacketUs = HostClock::nowUs();
+    uint64_t linkLostAtUs = HostClock::nowUs() + 4000000ULL;
+    uint64_t endUs = linkLostAtUs + 3000000ULL;
+    int step = 0;
+
+    while (HostClock::nowUs() < endUs) {
+        if (HostClock::nowUs() >= nextPacketUs && HostClock::nowUs() < linkLostAtUs) {
+            // Треугольная развертка всех осей
+            int phase = step % 100;
+            int16_t value = (int16_t)(phase < 50 ? -512 + phase * 20 : 512 - (phase - 50) * 20);
+            sendPacket(value, value, value, (int16_t)(value / 2 + 256));
+            nextPacketUs += PACKET_PERIOD_US;
+            step++;
+        }
+
+        controlTask.tick();
+        espNowManager.updateConnection();
+        EventLog::getInstance().drain();
+
+        if ((HostClock::nowUs() / tickUs) % 100 == 0) {
+            printOutputs("TICK");
+        }
+
+        HostClock::advanceUs(tickUs);
+    }
+
+    EventLog::getInstance().drain();
+    printOutputs("END");
+    LatencyMonitor::getInstance().printReport();
+    espNowManager.getLinkStats().printReport();
+    printf("ticks=%lu packets=%d overwritten=%lu\n",
+           (unsigned long)controlTask.getTickCount(), step,
+           (unsigned long)controlTask.getOverwrittenPackets());
+    printf("pwm commits=%lu channel writes=%lu\n",
+           (unsigned long)PwmBank::getCommitCount(), (unsigned long)PwmBank::getChannelWrites());
+    const uint8_t motorPin = ServoManager::OUTPUTS[ServoManager::CH_MOTOR].pin;
+    if (HostDshot::isAttached(motorPin)) {
+        printf("dshot frames=%lu bad=%lu\n",
+               (unsigned long)HostDshot::getFrameCount(motorPin), (unsigned long)HostDshot::getBadFrames());
+    }
+    printf("boot=%s outputs=%lu us ready=%lu us first command=%lu us\n", warm ? "fast" : "cold",
+           (unsigned long)servoManager.getOutputsLiveUs(), (unsigned long)readyUs,
+           (unsigned long)servoManager.getFirstCommandUs());
+    return 0;
+}
@@ -0,0 +1,331 @@
+// Воспроизведение записи полета на хосте ([env:native_replay]).
+//
+// Кадры записи (Diagnostics/FlightRecorder.h, команда 'r') подаются в настоящий
+// ESPNowManager -> ControlTask -> ServoManager на виртуальном времени, каждая
+// запись в PWM попадает в трассу выходов. Трасса сравнивается с эталонной:
+// любое отличие - код возврата 1, так что набор записей проверяет рефакторинг.
+//
+//   program <запись> [--trace <файл>] [--golden <файл>] [--realtime] [--tail-ms N] [--verbose]
+//   program --generate <файл> [секунды]      синтетическая запись для начала набора
+//
+// Трасса - текст, одна строка на запись в канал:
+//   <мкс от начала воспроизведения> <пин> <импульс, мкс>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "HAL/Hal.h"
+#include "HAL/Host/HostHal.h"
+#include "Core/Types.h"
+#include "Core/ConfigStore.h"
+#include "Actuators/ServoManager.h"
+#include "Communication/ESPNowManager.h"
+#include "Communication/ControlFrame.h"
+#include "Control/ControlTask.h"
+#include "Diagnostics/EventLog.h"
+#include "Diagnostics/FlightRecorder.h"
+
+#define REPLAY_TAIL_MS          2000    // После последнего кадра: failsafe и потеря связи
+#define REPLAY_TRACE_HEADER     "# pwmtrace 1"
+
+ServoManager servoManager;
+ControlTask controlTask(servoManager);
+
+static const uint8_t TRANSMITTER_MAC[6] = {0x14, 0x33, 0x5C, 0x37, 0x82, 0x58};
+
+struct TraceSample {
+    uint32_t timeUs;
+    uint8_t pin;
+    int16_t pulseUs;
+};
+
+static std::vector<TraceSample> trace;
+static uint64_t replayStartUs = 0;
+
+static void onDataReceived(const ControlData& data) {
+    controlTask.submit(data);
+}
+
+static void onPwmWrite(uint8_t pin, int pulseUs) {
+    trace.push_back({(uint32_t)(HostClock::nowUs() - replayStartUs), pin, (int16_t)pulseUs});
+}
+
+// ============================================================================
+// Файлы
+// ============================================================================
+
+static bool loadRecording(const char* path, std::vector<RecordedFrame>& frames) {
+    FILE* file = fopen(path, "r");
+    if (file == nullptr) {
+        return false;
+    }
+    char line[256];
+    RecordedFrame frame;
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        if (FlightRecorder::parseLine(line, frame)) {
+            frames.push_back(frame);
+        }
+    }
+    fclose(file);
+    return true;
+}
+
+static bool loadTrace(const char* path, std::vector<TraceSample>& samples) {
+    FILE* file = fopen(path, "r");
+    if (file == nullptr) {
+        return false;
+    }
+    char line[64];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        unsigned long timeUs = 0;
+        unsigned pin = 0;
+        int pulse = 0;
+        if (line[0] != '#' && sscanf(line, "%lu %u %d", &timeUs, &pin, &pulse) == 3) {
+            samples.push_back({(uint32_t)timeUs, (uint8_t)pin, (int16_t)pulse});
+        }
+    }
+    fclose(file);
+    return true;
+}
+
+static bool saveTrace(const char* path, const std::vector<TraceSample>& samples) {
+    FILE* file = fopen(path, "w");
+    if (file == nullptr) {
+        return false;
+    }
+    fprintf(file, "%s\n", REPLAY_TRACE_HEADER);
+    for (const TraceSample& sample : samples) {
+        fprintf(file, "%lu %u %d\n", (unsigned long)sample.timeUs, sample.pin, sample.pulseUs);
+    }
+    fclose(file);
+    return true;
+}
+
+// ============================================================================
+// Сравнение с эталоном
+// ============================================================================
+
+// Возвращает число отличающихся записей и печатает первое расхождение
+static size_t diffTraces(const std::vector<TraceSample>& golden, const std::vector<TraceSample>& actual) {
+    size_t differences = 0;
+    int maxPulseDelta = 0;
+    const size_t common = golden.size() < actual.size() ? golden.size() : actual.size();
+
+    for (size_t i = 0; i < common; i++) {
+        const TraceSample& expected = golden[i];
+        const TraceSample& got = actual[i];
+        if (expected.timeUs == got.timeUs && expected.pin == got.pin && expected.pulseUs == got.pulseUs) {
+            continue;
+        }
+        if (differences == 0) {
+            printf("first difference at sample %zu:\n  golden t=%lu us pin %u -> %d us\n  actual t=%lu us pin %u -> %d us\n",
+                   i, (unsigned long)expected.timeUs, expected.pin, expected.pulseUs,
+                   (unsigned long)got.timeUs, got.pin, got.pulseUs);
+        }
+        if (expected.pin == got.pin) {
+            const int delta = abs(expected.pulseUs - got.pulseUs);
+            if (delta > maxPulseDelta) {
+                maxPulseDelta = delta;
+            }
+        }
+        differences++;
+    }
+
+    const size_t extra = golden.size() > common ? golden.size() - common : actual.size() - common;
+    if (extra > 0) {
+        printf("sample count differs: golden %zu, actual %zu\n", golden.size(), actual.size());
+    }
+    if (differences > 0 || extra > 0) {
+        printf("MISMATCH: %zu of %zu samples differ, max pulse delta %d us\n",
+               differences + extra, golden.size(), maxPulseDelta);
+    }
+    return differences + extra;
+}
+
+// ============================================================================
+// Синтетическая запись
+// ============================================================================
+
+// Развертка стиков 50 Гц с джиттером приема, редкими потерями, битыми CRC
+// и одним долгим пропуском (failsafe)
+static bool generateRecording(const char* path, uint32_t seconds) {
+    FILE* file = fopen(path, "w");
+    if (file == nullptr) {
+        return false;
+    }
+    fprintf(file, "# flightrec 1: synthetic, %lu s\n", (unsigned long)seconds);
+
+    uint32_t seed = 20240601;
+    const uint32_t packetCount = seconds * 50;
+    const uint32_t gapStart = packetCount / 2;
+    char line[FLIGHT_RECORD_LINE_MAX];
+
+    for (uint32_t i = 0; i < packetCount; i++) {
+        seed = seed * 1103515245 + 12345;
+        if ((seed >> 16) % 100 == 0 || (i >= gapStart && i < gapStart + 75)) {
+            continue;   // Потерян в эфире
+        }
+
+        const uint32_t sentMs = i * 20;
+        const int phase = (int)(i % 200);
+        const int16_t sweep = (int16_t)(phase < 100 ? -500 + phase * 10 : 500 - (phase - 100) * 10);
+
+        ControlData data = {};
+        data.xAxis1 = sweep;
+        data.yAxis1 = (int16_t)(sweep / 2);
+        data.xAxis2 = (int16_t)(-sweep);
+        data.yAxis2 = (int16_t)(phase < 100 ? phase * 5 : (200 - phase) * 5);
+        data.button1 = (i / 500) % 2 == 1;
+        data.buttons = (i / 750) % 2;
+        data.sequence = (uint16_t)i;
+        data.senderTimeMs = (uint16_t)sentMs;
+
+        RecordedFrame frame = {};
+        frame.arrivalUs = 1000000 + sentMs * 1000 + (seed >> 8) % 3000;
+        frame.rssi = (int8_t)(-45 - (int)((seed >> 4) % 20));
+        frame.length = (uint8_t)ControlFrame::encode(data, frame.data);
+        if ((seed >> 12) % 250 == 0) {
+            frame.data[4] ^= 0x10;      // Битый кадр: CRC не сойдется
+        }
+
+        if (FlightRecorder::formatLine(frame, line, sizeof(line)) > 0) {
+            fprintf(file, "%s\n", line);
+        }
+    }
+    fclose(file);
+    printf("generated %s: %lu s, %lu packets sent\n", path, (unsigned long)seconds, (unsigned long)packetCount);
+    return true;
+}
+
+// ============================================================================
+// Воспроизведение
+// ============================================================================
+
+static void boot() {
+    ESPNowManager& espNowManager = ESPNowManager::getInstance();
+    FlightConfig defaults;
+    ServoManager::makeDefaultConfig(defaults);
+    ConfigStore::getInstance().begin(defaults);
+    servoManager.begin();
+    controlTask.begin();
+    espNowManager.begin();
+    espNowManager.registerCallback(onDataReceived);
+    espNowManager.addPeer();
+}
+
+static void replay(const std::vector<RecordedFrame>& frames, uint32_t tailMs, bool realtime) {
+    ESPNowManager& espNowManager = ESPNowManager::getInstance();
+    const uint32_t firstArrivalUs = frames.front().arrivalUs;
+    const uint64_t tickUs = 1000000UL / controlTask.getRateHz();
+
+    replayStartUs = HostClock::nowUs();
+    const uint64_t endUs = replayStartUs + (uint64_t)(frames.back().arrivalUs - firstArrivalUs) + tailMs * 1000ULL;
+    const auto wallStart = std::chrono::steady_clock::now();
+    uint64_t nextTickUs = replayStartUs;
+    size_t next = 0;
+
+    while (nextTickUs <= endUs) {
+        // Кадры приходят в свое время, между тиками - как на самолете
+        while (next < frames.size() && replayStartUs + (frames[next].arrivalUs - firstArrivalUs) <= nextTickUs) {
+            const RecordedFrame& frame = frames[next++];
+            HostClock::setUs(replayStartUs + (frame.arrivalUs - firstArrivalUs));
+            HostRadio::setRssi(frame.rssi);
+            HostRadio::deliver(TRANSMITTER_MAC, frame.data, frame.length);
+        }
+
+        HostClock::setUs(nextTickUs);
+        if (realtime) {
+            std::this_thread::sleep_until(wallStart + std::chrono::microseconds(nextTickUs - replayStartUs));
+        }
+        controlTask.tick();
+        espNowManager.updateConnection();
+        EventLog::getInstance().drain();
+        nextTickUs += tickUs;
+    }
+}
+
+static void usage() {
+    printf("usage: program <recording> [--trace <file>] [--golden <file>] [--realtime] [--tail-ms N] [--verbose]\n"
+           "       program --generate <file> [seconds]\n");
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage();
+        return 2;
+    }
+    if (strcmp(argv[1], "--generate") == 0) {
+        if (argc < 3) {
+            usage();
+            return 2;
+        }
+        return generateRecording(argv[2], argc > 3 ? (uint32_t)atoi(argv[3]) : 60) ? 0 : 2;
+    }
+
+    const char* recordingPath = argv[1];
+    const char* tracePath = nullptr;
+    const char* goldenPath = nullptr;
+    bool realtime = false;
+    bool verbose = false;
+    uint32_t tailMs = REPLAY_TAIL_MS;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+            goldenPath = argv[++i];
+        } else if (strcmp(argv[i], "--tail-ms") == 0 && i + 1 < argc) {
+            tailMs = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--realtime") == 0) {
+            realtime = true;
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    std::vector<RecordedFrame> frames;
+    if (!loadRecording(recordingPath, frames) || frames.empty()) {
+        printf("❌ %s: no frames\n", recordingPath);
+        return 2;
+    }
+    std::vector<TraceSample> golden;
+    if (goldenPath != nullptr && !loadTrace(goldenPath, golden)) {
+        printf("❌ %s: cannot read golden trace\n", goldenPath);
+        return 2;
+    }
+
+    // Загрузка (с церемонией ESC) не входит в трассу
+    HostConsole::setQuiet(true);
+    boot();
+    HostConsole::setQuiet(!verbose);
+    trace.reserve(frames.size() * MIXER_MAX_OUTPUTS);
+    HostPwm::setObserver(onPwmWrite);
+
+    const auto wallStart = std::chrono::steady_clock::now();
+    replay(frames, tailMs, realtime);
+    const double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallStart).count();
+    HostPwm::setObserver(nullptr);
+    HostConsole::setQuiet(false);
+
+    const double flightMs = (HostClock::nowUs() - replayStartUs) / 1000.0;
+    printf("replayed %zu frames, %.1f s of flight in %.2f ms (%.0fx real time), %zu PWM writes\n",
+           frames.size(), flightMs / 1000.0, wallMs, wallMs > 0 ? flightMs / wallMs : 0.0, trace.size());
+
+    if (tracePath != nullptr && !saveTrace(tracePath, trace)) {
+        printf("❌ %s: cannot write trace\n", tracePath);
+        return 2;
+    }
+    if (goldenPath != nullptr) {
+        if (diffTraces(golden, trace) > 0) {
+            return 1;
+        }
+        printf("✅ matches golden trace (%zu samples)\n", golden.size());
+    }
+    return 0;
+}
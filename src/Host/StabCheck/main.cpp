@@ -0,0 +1,179 @@
+// Проверки стабилизатора на хосте ([env:native_stabcheck]).
+//
+// FlightSim показывает качество полета (СКО, установление), но не ловит
+// поломку свойств регулятора, при которых самолет еще летает. Здесь каждое
+// свойство, на которое опирается стабилизация, проверяется отдельно:
+//   - интеграл FixedPid упирается в предел выхода и не копится при насыщении;
+//   - скачок задания не дает броска D (D - по измерению);
+//   - упреждение пропорционально заданию;
+//   - после IMU_LOST_READS ошибок чтения подряд Stabilizer переходит в MANUAL
+//     и возвращается в заданный режим, когда датчик снова отвечает.
+// Датчик - HostImu, время - виртуальное. Любое расхождение - код возврата 1.
+//
+//   program
+
+#include <cstdio>
+#include <cstdlib>
+#include "HAL/Hal.h"
+#include "HAL/Host/HostHal.h"
+#include "Core/FlightConfig.h"
+#include "Actuators/ServoManager.h"
+#include "Control/Pid.h"
+#include "Control/Stabilizer.h"
+
+#if !STABILIZER_ENABLED
+#error "StabCheck needs the stabilizer (AIRFRAME_PROFILE = AIRFRAME_PLANE)"
+#endif
+
+#define STABCHECK_PERIOD_US   (1000000UL / STABILIZER_RATE_HZ)
+#define STABCHECK_LIMIT       CURVE_SCALE
+
+typedef FixedPid<PID_GAIN_SHIFT, PID_DTERM_LPF_SHIFT> CheckPid;
+
+static uint32_t failures = 0;
+
+static void check(bool ok, const char* name, long got, long expected) {
+    if (ok) {
+        printf("✅ %s\n", name);
+    } else {
+        failures++;
+        printf("❌ %s: got %ld, expected %ld\n", name, got, expected);
+    }
+}
+
+static CheckPid makePid(int32_t kp, int32_t ki, int32_t kd, int32_t kff) {
+    CheckPid pid;
+    pid.setGains({kp, ki, kd, kff});
+    pid.setOutputLimit(STABCHECK_LIMIT);
+    pid.reset();
+    return pid;
+}
+
+// ============================================================================
+// FixedPid
+// ============================================================================
+
+static void checkIntegratorLimit() {
+    // Только I: постоянная ошибка 2 с - интеграл доходит до предела выхода и стоит
+    CheckPid pid = makePid(0, 1 << PID_GAIN_SHIFT, 0, 0);
+    for (uint32_t i = 0; i < 2 * STABILIZER_RATE_HZ; i++) {
+        pid.update(1000, 0, STABCHECK_PERIOD_US);
+    }
+    check(pid.getIntegral() == STABCHECK_LIMIT, "integrator stops at the output limit",
+          pid.getIntegral(), STABCHECK_LIMIT);
+    check(pid.getLastOutput() == STABCHECK_LIMIT, "output clamped to the limit",
+          pid.getLastOutput(), STABCHECK_LIMIT);
+
+    // P уже в насыщении: интеграл в ту же сторону не копится
+    CheckPid saturated = makePid(4 << PID_GAIN_SHIFT, 1 << PID_GAIN_SHIFT, 0, 0);
+    for (uint32_t i = 0; i < 2 * STABILIZER_RATE_HZ; i++) {
+        saturated.update(1000, 0, STABCHECK_PERIOD_US);
+    }
+    check(saturated.getIntegral() == 0, "no integral windup while P saturates", saturated.getIntegral(), 0);
+
+    // Ошибка сменила знак - выход сразу уходит от предела, без разряда интеграла
+    // (±1 отсчет - первый шаг интеграла после смены знака)
+    const int32_t output = saturated.update(-100, 0, STABCHECK_PERIOD_US);
+    check(abs(output + 400) <= 1, "output follows error reversal at once", output, -400);
+}
+
+static void checkNoDerivativeKick() {
+    // Только D, измерение постоянно: скачок задания не меняет выход
+    CheckPid pid = makePid(0, 0, PID_PITCH_KD, 0);
+    for (uint32_t i = 0; i < 10; i++) {
+        pid.update(0, 200, STABCHECK_PERIOD_US);
+    }
+    int32_t peak = 0;
+    for (uint32_t i = 0; i < 10; i++) {
+        const int32_t output = pid.update(i == 0 ? 0 : 1600, 200, STABCHECK_PERIOD_US);
+        peak = abs(output) > abs(peak) ? output : peak;
+    }
+    check(peak == 0, "setpoint step gives no D kick", peak, 0);
+
+    // Скачок измерения D видит - и тормозит его (знак против изменения)
+    const int32_t output = pid.update(1600, 400, STABCHECK_PERIOD_US);
+    check(output < 0, "measurement step drives D against the motion", output, -1);
+}
+
+static void checkFeedForward() {
+    // Только FF = 0.5: ошибка нулевая, выход - половина задания с тем же знаком
+    CheckPid pid = makePid(0, 0, 0, 1 << (PID_GAIN_SHIFT - 1));
+    static const int32_t SETPOINTS[] = {200, 400, 800, -400};
+    for (int32_t setpoint : SETPOINTS) {
+        const int32_t output = pid.update(setpoint, setpoint, STABCHECK_PERIOD_US);
+        char name[64];
+        snprintf(name, sizeof(name), "feed-forward scales with setpoint %ld", (long)setpoint);
+        check(output == setpoint / 2, name, output, setpoint / 2);
+    }
+}
+
+// ============================================================================
+// Stabilizer
+// ============================================================================
+
+// Тик как в ControlTask: чтение датчика, затем команды
+static uint8_t stabilizerTick(Stabilizer& stabilizer, int16_t inputs[MIXER_INPUT_COUNT], uint8_t mode) {
+    HostClock::advanceUs(STABCHECK_PERIOD_US);
+    stabilizer.sample();
+    stabilizer.apply(inputs, mode);
+    return stabilizer.getMode();
+}
+
+static void checkImuLossFallback() {
+    FlightConfig config;
+    ServoManager::makeDefaultConfig(config);
+
+    // Горизонтальный полет без вращения; стик крена - половина хода
+    HostImu::setPresent(true);
+    HostImu::setFailing(false);
+    HostImu::setRates(0.0f, 0.0f, 0.0f);
+    HostImu::setAccel(0.0f, 0.0f, -1.0f);
+
+    Stabilizer stabilizer;
+    stabilizer.applyConfig(config);
+    stabilizer.begin();
+
+    int16_t inputs[MIXER_INPUT_COUNT] = {};
+    for (uint32_t i = 0; i <= IMU_CALIBRATION_SAMPLES; i++) {
+        stabilizerTick(stabilizer, inputs, FLIGHT_MODE_RATE);
+    }
+    check(stabilizer.getMode() == FLIGHT_MODE_RATE, "RATE after gyro calibration",
+          stabilizer.getMode(), FLIGHT_MODE_RATE);
+
+    // IMU_LOST_READS - 1 ошибок подряд: режим еще держится
+    HostImu::setFailing(true);
+    uint8_t mode = FLIGHT_MODE_RATE;
+    for (uint32_t i = 0; i + 1 < IMU_LOST_READS; i++) {
+        mode = stabilizerTick(stabilizer, inputs, FLIGHT_MODE_RATE);
+    }
+    check(mode == FLIGHT_MODE_RATE, "RATE kept below IMU_LOST_READS errors", mode, FLIGHT_MODE_RATE);
+
+    // Еще одна - MANUAL, стики проходят в микшер без изменений
+    int16_t manual[MIXER_INPUT_COUNT] = {};
+    manual[MIX_IN_ROLL] = CURVE_SCALE / 2;
+    mode = stabilizerTick(stabilizer, manual, FLIGHT_MODE_RATE);
+    check(mode == FLIGHT_MODE_MANUAL, "MANUAL after IMU_LOST_READS errors", mode, FLIGHT_MODE_MANUAL);
+    check(manual[MIX_IN_ROLL] == CURVE_SCALE / 2, "MANUAL passes sticks through",
+          manual[MIX_IN_ROLL], CURVE_SCALE / 2);
+
+    // Датчик снова отвечает - заданный режим возвращается
+    HostImu::setFailing(false);
+    mode = stabilizerTick(stabilizer, inputs, FLIGHT_MODE_RATE);
+    check(mode == FLIGHT_MODE_RATE, "RATE again once the IMU answers", mode, FLIGHT_MODE_RATE);
+}
+
+int main() {
+    HostClock::setUs(1000000);
+
+    checkIntegratorLimit();
+    checkNoDerivativeKick();
+    checkFeedForward();
+    checkImuLossFallback();
+
+    if (failures > 0) {
+        printf("❌ %lu check(s) failed\n", (unsigned long)failures);
+        return 1;
+    }
+    printf("✅ stabilizer checks passed\n");
+    return 0;
+}
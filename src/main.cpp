@@ -1,18 +1,204 @@
-#include <WiFi.h>
+#include "HAL/Hal.h"
 #include "Core/Types.h"
 #include "Actuators/ServoManager.h"
 #include "Communication/ESPNowManager.h"
+#include "Control/ControlTask.h"
+#include "Diagnostics/LatencyMonitor.h"
+#include "Diagnostics/EventLog.h"
+#include "Core/ConfigStore.h"
+#include "Core/TaskLayout.h"
+#include "Diagnostics/JitterTest.h"
+#include "Diagnostics/FlightRecorder.h"
+#include <cstdio>
+#include <cstring>
 
 ServoManager servoManager;
+ControlTask controlTask(servoManager);
 ESPNowManager& espNowManager = ESPNowManager::getInstance();
 
+// Выполняется в контексте WiFi - только передаем пакет задаче управления
 void onDataReceived(const ControlData& data) {
-    servoManager.update(data);
+    controlTask.submit(data);
+}
+
+// Строка после команды '=' (символы уже в буфере UART или приходят следом)
+static size_t readConsoleLine(char* buffer, size_t size) {
+    size_t length = 0;
+    uint32_t start = Clock::millis();
+    while (length + 1 < size && Clock::millis() - start < 200) {
+        if (!console.available()) {
+            Clock::delay(1);
+            continue;
+        }
+        char c = console.read();
+        if (c == '\n' || c == '\r') {
+            break;
+        }
+        buffer[length++] = c;
+    }
+    buffer[length] = '\0';
+    return length;
+}
+
+// "=out_neutral 0 1520", "=rate_low 50", "=defaults"
+static void handleConfigCommand() {
+    char line[48];
+    readConsoleLine(line, sizeof(line));
+    
+    ConfigStore& config = ConfigStore::getInstance();
+    if (strcmp(line, "defaults") == 0) {
+        console.println(config.resetToDefaults() ? "✅ Config: defaults restored" : "❌ Config: busy, retry");
+        return;
+    }
+    
+    char name[16];
+    int first = 0;
+    int second = 0;
+    const int fields = sscanf(line, "%15s %d %d", name, &first, &second);
+    bool ok = false;
+    if (fields == 3) {
+        ok = config.setField(name, first, second);
+    } else if (fields == 2) {
+        ok = config.setField(name, 0, first);
+    }
+    console.printf(ok ? "✅ Config: %s applied, saving to NVS\n" : "❌ Config: cannot set '%s' (name, index or range)\n", line);
+}
+
+// Время загрузки: от старта приложения (esp_timer) до готовности и до первой команды
+static bool fastBoot = false;
+static uint32_t bootReadyUs = 0;
+
+static void printBootReport() {
+    console.printf("⚡ Boot: %s (reset: %s), outputs %lu ms, ready %lu ms, first command ",
+                   fastBoot ? "FAST" : "cold", System::getResetReasonName(System::getResetReason()),
+                   (unsigned long)(servoManager.getOutputsLiveUs() / 1000), (unsigned long)(bootReadyUs / 1000));
+    if (servoManager.hasFirstCommand()) {
+        console.printf("%lu ms\n", (unsigned long)(servoManager.getFirstCommandUs() / 1000));
+    } else {
+        console.println("-");
+    }
+}
+
+// Только чтение статистики - без захвата сервоприводов, цикл управления не останавливается
+static void printStatus() {
+    console.println("📊 System status:");
+    console.print("  ESC armed: ");
+    console.println(servoManager.isMotorArmed() ? "YES" : "NO");
+    console.print("  ESP-NOW: ");
+    console.println(espNowManager.isConnected() ? "CONNECTED" : "DISCONNECTED");
+    console.printf("  Control loop: %u Hz, ticks: %lu, skipped: %lu\n",
+                  controlTask.getRateHz(),
+                  (unsigned long)controlTask.getTickCount(),
+                  (unsigned long)controlTask.getSkippedTicks());
+    console.printf("  Tick jitter: p50 %lu us, p99 %lu us, max %lu us\n",
+                  (unsigned long)controlTask.getJitterHistogram().percentile(50),
+                  (unsigned long)controlTask.getJitterHistogram().percentile(99),
+                  (unsigned long)controlTask.getMaxJitterUs());
+    console.printf("  Tick exec: p50 %lu us, p99 %lu us, max %lu us, overruns: %lu\n",
+                  (unsigned long)controlTask.getExecHistogram().percentile(50),
+                  (unsigned long)controlTask.getExecHistogram().percentile(99),
+                  (unsigned long)controlTask.getMaxExecUs(),
+                  (unsigned long)controlTask.getOverruns());
+    #if STABILIZER_ENABLED
+    {
+        const Stabilizer& stabilizer = servoManager.getStabilizer();
+        console.printf("  Stabilizer: %s, IMU %s, read errors: %lu, roll %.1f, pitch %.1f deg\n",
+                      Stabilizer::getModeName(stabilizer.getMode()),
+                      !stabilizer.isAvailable() ? "MISSING" : (stabilizer.isHealthy() ? "ok" : "LOST"),
+                      (unsigned long)stabilizer.getReadErrors(),
+                      stabilizer.getRollDeg(), stabilizer.getPitchDeg());
+    }
+    #endif
+    console.printf("  Packet latency: last %lu us, max %lu us, overwritten: %lu, stale: %lu\n",
+                  (unsigned long)controlTask.getLastLatencyUs(),
+                  (unsigned long)controlTask.getMaxLatencyUs(),
+                  (unsigned long)controlTask.getOverwrittenPackets(),
+                  (unsigned long)controlTask.getStalePackets());
+    console.printf("  Failsafe: %s, activations: %lu, max detection: %lu us\n",
+                  controlTask.getFailsafe().isActive() ? "ACTIVE" : "off",
+                  (unsigned long)controlTask.getFailsafe().getActivationCount(),
+                  (unsigned long)controlTask.getFailsafe().getMaxDetectionUs());
+    printBootReport();
+    printTaskLayout();
+    LatencyMonitor::getInstance().printReport();
+    espNowManager.getLinkStats().printReport();
+    controlTask.requestStatsReset();
+    LatencyMonitor::getInstance().requestReset();
+    espNowManager.requestLinkStatsReset();
+}
+
+static void printHelp() {
+    console.println("📝 Available commands:");
+    console.println("  t - Full servo tests (with motor)");
+    console.println("  c - Calibrate ESC");
+    console.println("  m - Simple motor test");
+    console.println("  d - Direct motor test (50%, 3s)");
+    console.println("  0 - Stop motor (0%)");
+    console.println("  1 - Motor 10%");
+    console.println("  2 - Motor 25%");
+    console.println("  3 - Motor 50%");
+    console.println("  b - Arm ESC");
+    #if MOTOR_DSHOT
+        console.println("  e - ESC beep (DShot command)");
+    #endif
+    console.println("  s - System status");
+    console.println("  j - Control tick jitter test under WiFi/log load (15 s)");
+    console.println("  r - Dump recorded ESP-NOW frames (for host replay) and restart recording");
+    console.println("  p - Print configuration");
+    console.println("  =name [index] value - Change configuration (=defaults to reset)");
+    console.println("  x - Emergency motor stop (also aborts a running test)");
+    #if STABILIZER_ENABLED
+        console.println("  g - Recalibrate gyro (aircraft still, MANUAL until done)");
+        console.println("  Flight mode from transmitter buttons bits 1-2: 0 MANUAL, 1 RATE, 2 ANGLE");
+    #endif
+    console.println("  h - This help");
 }
 
 void checkSerialCommands() {
-    if (Serial.available()) {
-        char cmd = Serial.read();
+    if (console.available()) {
+        char cmd = console.read();
+        if (cmd == '\n' || cmd == '\r') {
+            return;
+        }
+        
+        // Настройки и вывод не трогают сервоприводы - цикл управления не останавливаем
+        if (!servoManager.isSequenceRunning()) {
+            if (cmd == 's') {
+                printStatus();
+                return;
+            }
+            if (cmd == 'h') {
+                printHelp();
+                return;
+            }
+            if (cmd == '=') {
+                handleConfigCommand();
+                return;
+            }
+            if (cmd == 'p') {
+                ConfigStore::getInstance().print();
+                return;
+            }
+            if (cmd == 'r') {
+                FlightRecorder::getInstance().dump();
+                return;
+            }
+            if (cmd == 'j') {
+                JitterTest::getInstance().start(controlTask);
+                return;
+            }
+        }
+        
+        // Команды работают с сервоприводами напрямую - останавливаем цикл управления
+        // (только на время запуска: калибровка и тесты идут в тике управления)
+        controlTask.lockActuators();
+        
+        if (servoManager.isSequenceRunning() && cmd != 'x') {
+            // Ответ на запрос калибровки/теста, любая другая клавиша - отмена
+            servoManager.handleKey(cmd);
+            controlTask.unlockActuators();
+            return;
+        }
         
         switch(cmd) {
             case 't': // Полный тест
@@ -28,27 +214,27 @@ void checkSerialCommands() {
                 break;
                 
             case 'd': // Direct motor test - 50% power
-                Serial.println("🔧 DIRECT MOTOR TEST - 50% POWER FOR 3 SECONDS");
+                console.println("🔧 DIRECT MOTOR TEST - 50% POWER FOR 3 SECONDS");
                 servoManager.testMotorDirect();
                 break;
                 
             case '1': // Тест 10% мощности
-                Serial.println("🔧 Setting motor to 10% (1100μs)");
+                console.println("🔧 Setting motor to 10%");
                 servoManager.directMotorTest(10);
                 break;
                 
             case '2': // Тест 25% мощности
-                Serial.println("🔧 Setting motor to 25% (1250μs)");
+                console.println("🔧 Setting motor to 25%");
                 servoManager.directMotorTest(25);
                 break;
                 
             case '3': // Тест 50% мощности
-                Serial.println("🔧 Setting motor to 50% (1500μs)");
+                console.println("🔧 Setting motor to 50%");
                 servoManager.directMotorTest(50);
                 break;
                 
             case '0': // Стоп
-                Serial.println("🔧 STOPPING motor (1000μs)");
+                console.println("🔧 STOPPING motor");
                 servoManager.directMotorTest(0);
                 break;
                 
@@ -56,55 +242,82 @@ void checkSerialCommands() {
                 servoManager.blheliArmingSequence();
                 break;
                 
-            case 's': // Статус
-                Serial.println("📊 System status:");
-                Serial.print("  ESC armed: ");
-                Serial.println(servoManager.isMotorArmed() ? "YES" : "NO");
-                Serial.print("  ESP-NOW: ");
-                Serial.println(espNowManager.isConnected() ? "CONNECTED" : "DISCONNECTED");
+            #if MOTOR_DSHOT
+            case 'e': // Звуковые команды ESC
+                servoManager.escBeepSequence();
                 break;
+            #endif
                 
-            case 'x': // Экстренная остановка мотора
-                servoManager.emergencyStop();
-                Serial.println("🛑 EMERGENCY MOTOR STOP");
+            #if STABILIZER_ENABLED
+            case 'g': // Калибровка нуля гироскопа
+                servoManager.beginImu();
+                console.println("🧭 Gyro calibration: keep the aircraft still for ~1 s");
                 break;
+            #endif
                 
-            case 'h': // Помощь
-                Serial.println("📝 Available commands:");
-                Serial.println("  t - Full servo tests (with motor)");
-                Serial.println("  c - Calibrate ESC");
-                Serial.println("  m - Simple motor test");
-                Serial.println("  d - Direct motor test (50%, 3s)");
-                Serial.println("  0 - Stop motor (0%)");
-                Serial.println("  1 - Motor 10%");
-                Serial.println("  2 - Motor 25%");
-                Serial.println("  3 - Motor 50%");
-                Serial.println("  s - System status");
-                Serial.println("  x - Emergency motor stop");
-                Serial.println("  h - This help");
+            case 'x': // Экстренная остановка мотора
+                servoManager.emergencyStop();
+                console.println("🛑 EMERGENCY MOTOR STOP");
                 break;
         }
+        
+        controlTask.unlockActuators();
+    }
+}
+
+// Консоль, статистика связи и запись настроек - низкоприоритетная задача
+// на протокольном ядре, не рядом с управлением
+static void consoleTask(void* arg) {
+    (void)arg;
+    for (;;) {
+        espNowManager.updateConnection();
+        ConfigStore::getInstance().service();   // Запись измененных настроек в NVS
+        checkSerialCommands();
+        JitterTest::getInstance().service();
+        Clock::delay(50);
     }
 }
 
 void setup() {
-    Serial.begin(115200);
-    delay(1000);
+    console.begin(115200);
+    
+    // Теплый сброс (просадка питания, сторожевой таймер) - вероятно, в полете:
+    // не ждем монитор порта и не повторяем церемонию вооружения ESC
+    fastBoot = FAST_BOOT_ENABLED && System::isWarmReset();
+    if (!fastBoot) {
+        Clock::delay(1000);
+    }
+    EventLog::getInstance().begin();   // Вывод журнала событий в фоновой задаче
+    
+    if (!fastBoot) {
+        console.println("🎯 FLIGHT CONTROL SYSTEM");
+        console.println("📡 ESP-NOW RC Controller");
+        console.println("📝 Send 'h' for available commands");
+    }
     
-    Serial.println("🎯 FLIGHT CONTROL SYSTEM");
-    Serial.println("📡 ESP-NOW RC Controller");
-    Serial.println("📝 Send 'h' for available commands");
+    // Настройки: одно чтение блока из NVS, при ошибке - значения по умолчанию.
+    // Там же состояние ESC, которое восстанавливает быстрая загрузка
+    FlightConfig defaults;
+    ServoManager::makeDefaultConfig(defaults);
+    ConfigStore::getInstance().begin(defaults);
     
-    servoManager.begin();
+    if (fastBoot) {
+        servoManager.beginFast();
+    } else {
+        servoManager.begin();
+    }
+    controlTask.begin();
     espNowManager.begin();
     espNowManager.registerCallback(onDataReceived);
     espNowManager.addPeer();
+    bootReadyUs = Clock::micros();
     
-    Serial.println("✅ READY - Waiting for transmitter...");
+    printBootReport();
+    console.println("✅ READY - Waiting for transmitter...");
+    startTask(TASK_CONSOLE, consoleTask, nullptr);
 }
 
 void loop() {
-    espNowManager.updateConnection();
-    checkSerialCommands();
-    delay(50);
-}
\ No newline at end of file
+    // Вся работа распределена по задачам (Core/TaskLayout.h)
+    vTaskDelete(nullptr);
+}